@@ -0,0 +1,136 @@
+#include <furi.h>
+#include "../minunit.h"
+#include <toolbox/compress.h>
+#include <gui/icon.h>
+#include <assets_icons.h>
+
+static size_t compress_test_icon_size(const Icon* icon) {
+    return ((icon_get_width(icon) + 7) / 8) * icon_get_height(icon);
+}
+
+static size_t compress_test_icon_data_size(const Icon* icon) {
+    const uint8_t* data = icon_get_data(icon);
+    // Compressed icon: 4 byte header with the size of the compressed data
+    return 4 + (data[2] | (data[3] << 8));
+}
+
+static uint8_t* compress_test_decode_copy(CompressIcon* compress_icon, const Icon* icon) {
+    uint8_t* decoded;
+    compress_icon_decode(compress_icon, icon_get_data(icon), &decoded);
+    uint8_t* copy = malloc(compress_test_icon_size(icon));
+    memcpy(copy, decoded, compress_test_icon_size(icon));
+    return copy;
+}
+
+MU_TEST(compress_icon_cache_hit_test) {
+    const Icon* icon = &I_DFU_128x50;
+    mu_assert(icon_get_data(icon)[0], "Test icon is not compressed");
+
+    CompressIcon* compress_icon = compress_icon_alloc();
+    CompressIconCacheStats stats;
+
+    uint8_t* expected = compress_test_decode_copy(compress_icon, icon);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(1, stats.misses);
+    mu_assert_int_eq(1, stats.count);
+
+    uint8_t* decoded;
+    compress_icon_decode(compress_icon, icon_get_data(icon), &decoded);
+    mu_assert_mem_eq(expected, decoded, compress_test_icon_size(icon));
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert_int_eq(1, stats.misses);
+
+    compress_icon_reset_cache(compress_icon);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.count);
+    mu_assert_int_eq(0, stats.size);
+
+    free(expected);
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST(compress_icon_cache_disabled_test) {
+    const Icon* icon = &I_DFU_128x50;
+    CompressIcon* compress_icon = compress_icon_alloc_ex(0);
+    CompressIconCacheStats stats;
+
+    uint8_t* decoded;
+    compress_icon_decode(compress_icon, icon_get_data(icon), &decoded);
+    compress_icon_decode(compress_icon, icon_get_data(icon), &decoded);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(2, stats.misses);
+    mu_assert_int_eq(0, stats.count);
+
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST(compress_icon_cache_replaced_test) {
+    const Icon* icon_a = &I_DFU_128x50;
+    const Icon* icon_b = &I_ActiveConnection_50x64;
+    mu_assert(icon_get_data(icon_b)[0], "Test icon is not compressed");
+
+    CompressIcon* compress_icon = compress_icon_alloc();
+    uint8_t* expected = compress_test_decode_copy(compress_icon, icon_b);
+
+    // Icon loaded to RAM and replaced with another one at the same address
+    size_t size_a = compress_test_icon_data_size(icon_a);
+    size_t size_b = compress_test_icon_data_size(icon_b);
+    mu_assert(size_a != size_b, "Test icons must differ in compressed size");
+    uint8_t* icon_data = malloc(MAX(size_a, size_b));
+
+    uint8_t* decoded;
+    memcpy(icon_data, icon_get_data(icon_a), size_a);
+    compress_icon_decode(compress_icon, icon_data, &decoded);
+    memcpy(icon_data, icon_get_data(icon_b), size_b);
+    compress_icon_decode(compress_icon, icon_data, &decoded);
+    mu_assert_mem_eq(expected, decoded, compress_test_icon_size(icon_b));
+
+    CompressIconCacheStats stats;
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(3, stats.misses);
+
+    // Same address and size, different content
+    icon_data[size_b - 1] ^= 0xFF;
+    compress_icon_decode(compress_icon, icon_data, &decoded);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.hits);
+    mu_assert_int_eq(4, stats.misses);
+
+    free(icon_data);
+    free(expected);
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST(compress_icon_uncached_test) {
+    const Icon* icon = &I_DFU_128x50;
+    CompressIcon* compress_icon = compress_icon_alloc();
+    CompressIconCacheStats stats;
+
+    uint8_t* expected = compress_test_decode_copy(compress_icon, icon);
+    compress_icon_reset_cache(compress_icon);
+
+    uint8_t* decoded;
+    compress_icon_decode_uncached(compress_icon, icon_get_data(icon), &decoded);
+    mu_assert_mem_eq(expected, decoded, compress_test_icon_size(icon));
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.count);
+
+    free(expected);
+    compress_icon_free(compress_icon);
+}
+
+MU_TEST_SUITE(test_compress) {
+    MU_RUN_TEST(compress_icon_cache_hit_test);
+    MU_RUN_TEST(compress_icon_cache_disabled_test);
+    MU_RUN_TEST(compress_icon_cache_replaced_test);
+    MU_RUN_TEST(compress_icon_uncached_test);
+}
+
+int run_minunit_test_compress() {
+    MU_RUN_SUITE(test_compress);
+    return MU_EXIT_CODE;
+}
@@ -456,6 +456,72 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_read_hex_sequence(FlipperFormat* file, uint8_t from, uint8_t to) {
+    uint8_t uint8_value;
+    for(uint16_t index = from; index < to; index++) {
+        if(!flipper_format_read_hex(file, test_hex_key, &uint8_value, 1)) return false;
+        if(uint8_value != index) return false;
+    }
+    return true;
+}
+
+static bool test_index_mode(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_index_mode(file, true);
+
+    FuriString* string_value;
+    string_value = furi_string_alloc();
+    uint32_t uint32_value;
+    uint8_t hex_value[COUNT_OF(test_hex_data)];
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+        if(!test_read_hex_sequence(file, 0, 100)) break;
+        if(flipper_format_key_exist(file, "Missing key")) break;
+
+        // Make the first line longer, following offsets must be shifted
+        if(!flipper_format_update_hex(file, test_hex_key, test_hex_data, COUNT_OF(test_hex_data)))
+            break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_hex(file, test_hex_key, hex_value, COUNT_OF(hex_value))) break;
+        if(memcmp(hex_value, test_hex_data, COUNT_OF(test_hex_data)) != 0) break;
+        if(!test_read_hex_sequence(file, 1, 100)) break;
+
+        // Delete it, second line becomes the first one
+        if(!flipper_format_delete_key(file, test_hex_key)) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!test_read_hex_sequence(file, 1, 100)) break;
+
+        // Appended keys are indexed too
+        if(!flipper_format_seek_to_end(file)) break;
+        if(!flipper_format_write_string_cstr(file, test_string_key, test_string_data)) break;
+        if(!flipper_format_rewind(file)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_data) != 0) break;
+
+        // Check the result without the index
+        if(!flipper_format_file_close(file)) break;
+        flipper_format_set_index_mode(file, false);
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+        if(!test_read_hex_sequence(file, 1, 100)) break;
+        if(!flipper_format_read_string(file, test_string_key, string_value)) break;
+        if(furi_string_cmp_str(string_value, test_string_data) != 0) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -522,6 +588,11 @@ MU_TEST(flipper_format_multikey_test) {
     mu_assert(test_read_multikey(TEST_DIR "ff_multiline.test"), "Multikey read test error");
 }
 
+MU_TEST(flipper_format_index_test) {
+    mu_assert(test_write_multikey(TEST_DIR "ff_index.test"), "Index write test error");
+    mu_assert(test_index_mode(TEST_DIR "ff_index.test"), "Index mode test error");
+}
+
 MU_TEST(flipper_format_oddities_test) {
     mu_assert(
         storage_write_string(test_file_oddities, test_data_odd), "Write test error [Oddities]");
@@ -541,6 +612,7 @@ MU_TEST_SUITE(flipper_format) {
     MU_RUN_TEST(flipper_format_update_2_test);
     MU_RUN_TEST(flipper_format_update_2_result_test);
     MU_RUN_TEST(flipper_format_multikey_test);
+    MU_RUN_TEST(flipper_format_index_test);
     MU_RUN_TEST(flipper_format_oddities_test);
     tests_teardown();
 }
@@ -1,8 +1,15 @@
 #include "../minunit.h"
+#include <furi.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
+static int32_t test_furi_memmgr_leaking_thread(void* context) {
+    // leave the block to the test, so that it is accounted to this thread
+    *(void**)context = malloc(100);
+    return 0;
+}
+
 void test_furi_memmgr() {
     void* ptr;
 
@@ -35,4 +42,40 @@ void test_furi_memmgr() {
         mu_assert_int_eq(0, ((uint8_t*)ptr)[i]);
     }
     free(ptr);
+
+    // small blocks are served from size classes
+    const size_t small_count = 8;
+    void* small[small_count];
+    MemmgrHeapSlabClassInfo before, after;
+    memmgr_heap_get_slab_class_info(0, &before);
+    for(size_t i = 0; i < small_count; i++) {
+        small[i] = malloc(before.block_size);
+        mu_check(small[i] != NULL);
+        for(size_t j = 0; j < before.block_size; j++) {
+            mu_assert_int_eq(0, ((uint8_t*)small[i])[j]);
+        }
+        memset(small[i], i + 1, before.block_size);
+    }
+    memmgr_heap_get_slab_class_info(0, &after);
+    mu_check(after.alloc_count - before.alloc_count >= small_count);
+
+    // test that neighbour blocks do not overlap
+    for(size_t i = 0; i < small_count; i++) {
+        for(size_t j = 0; j < before.block_size; j++) {
+            mu_assert_int_eq(i + 1, ((uint8_t*)small[i])[j]);
+        }
+        free(small[i]);
+    }
+
+    // blocks are accounted to the thread that allocated them
+    void* leaked = NULL;
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrLeak", 1024, test_furi_memmgr_leaking_thread, &leaked);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    mu_check(leaked != NULL);
+    mu_check(furi_thread_get_heap_size(thread) >= 100);
+    furi_thread_free(thread);
+    free(leaked);
 }
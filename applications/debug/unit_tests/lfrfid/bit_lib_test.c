@@ -1,7 +1,10 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include "../minunit.h"
 #include <lfrfid/tools/bit_lib.h>
 
+#define TAG "BitLibTest"
+
 MU_TEST(test_bit_lib_increment_index) {
     uint32_t index = 0;
 
@@ -447,6 +450,70 @@ MU_TEST(test_bit_lib_crc16) {
     mu_assert_int_eq(0x31C3, bit_lib_crc16(data, data_size, 0x1021, 0x0000, false, false, 0x0000));
 }
 
+MU_TEST(test_bit_lib_window) {
+#define TEST_BIT_LIB_WINDOW_DATA_SIZE 12
+    // get_bits reads one byte past the requested bits
+    uint8_t data[TEST_BIT_LIB_WINDOW_DATA_SIZE + 1] = {0};
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(TEST_BIT_LIB_WINDOW_DATA_SIZE * 8)];
+    uint8_t copy[TEST_BIT_LIB_WINDOW_DATA_SIZE] = {0};
+    BitLibWindow window;
+
+    bit_lib_window_init(&window, window_data, TEST_BIT_LIB_WINDOW_DATA_SIZE * 8);
+    bit_lib_window_copy(&window, copy);
+    mu_assert_mem_eq(data, copy, TEST_BIT_LIB_WINDOW_DATA_SIZE);
+
+    uint32_t seed = 0x12345678;
+    for(size_t i = 0; i < TEST_BIT_LIB_WINDOW_DATA_SIZE * 8 * 3 + 5; i++) {
+        seed = seed * 1103515245 + 12345;
+        const bool bit = seed & 0x10000;
+        bit_lib_push_bit(data, TEST_BIT_LIB_WINDOW_DATA_SIZE, bit);
+        bit_lib_window_push(&window, bit);
+
+        bit_lib_window_copy(&window, copy);
+        mu_assert_mem_eq(data, copy, TEST_BIT_LIB_WINDOW_DATA_SIZE);
+        for(size_t position = 0; position <= TEST_BIT_LIB_WINDOW_DATA_SIZE * 8 - 32;
+            position += 7) {
+            mu_assert_int_eq(
+                bit_lib_get_bits_32(data, position, 32),
+                bit_lib_window_get_bits_32(&window, position, 32));
+        }
+    }
+
+    bit_lib_window_reset(&window);
+    bit_lib_window_copy(&window, copy);
+    memset(data, 0, TEST_BIT_LIB_WINDOW_DATA_SIZE);
+    mu_assert_mem_eq(data, copy, TEST_BIT_LIB_WINDOW_DATA_SIZE);
+}
+
+MU_TEST(test_bit_lib_window_benchmark) {
+#define TEST_BIT_LIB_WINDOW_BENCH_DATA_SIZE 12
+#define TEST_BIT_LIB_WINDOW_BENCH_BITS 4096
+    uint8_t data[TEST_BIT_LIB_WINDOW_BENCH_DATA_SIZE] = {0};
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(TEST_BIT_LIB_WINDOW_BENCH_DATA_SIZE * 8)];
+    BitLibWindow window;
+    bit_lib_window_init(&window, window_data, TEST_BIT_LIB_WINDOW_BENCH_DATA_SIZE * 8);
+
+    uint32_t time_start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < TEST_BIT_LIB_WINDOW_BENCH_BITS; i++) {
+        bit_lib_push_bit(data, TEST_BIT_LIB_WINDOW_BENCH_DATA_SIZE, i & 1);
+    }
+    uint32_t time_push = DWT->CYCCNT - time_start;
+
+    time_start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < TEST_BIT_LIB_WINDOW_BENCH_BITS; i++) {
+        bit_lib_window_push(&window, i & 1);
+    }
+    uint32_t time_window = DWT->CYCCNT - time_start;
+
+    FURI_LOG_I(
+        TAG,
+        "%u bits: push_bit %lu cycles, window %lu cycles",
+        TEST_BIT_LIB_WINDOW_BENCH_BITS,
+        time_push,
+        time_window);
+    mu_assert(time_window < time_push, "window push is not faster than push_bit\r\n");
+}
+
 MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_increment_index);
     MU_RUN_TEST(test_bit_lib_is_set);
@@ -465,6 +532,8 @@ MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_get_bit_count);
     MU_RUN_TEST(test_bit_lib_reverse_16_fast);
     MU_RUN_TEST(test_bit_lib_crc16);
+    MU_RUN_TEST(test_bit_lib_window);
+    MU_RUN_TEST(test_bit_lib_window_benchmark);
 }
 
 int run_minunit_test_bit_lib() {
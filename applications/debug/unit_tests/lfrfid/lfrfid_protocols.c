@@ -209,6 +209,12 @@ const int8_t indala26_test_timings[INDALA26_EMULATION_TIMINGS_COUNT] = {
     -1, 1,  -1, 1,  -1, 1,  -1, 1,
 };
 
+#define PYRAMID_TEST_DATA \
+    { 0x1A, 0x2A, 0x05, 0x39 }
+#define PYRAMID_TEST_DATA_SIZE 4
+// Ten frames of 128 bits, up to six FSK pulses per bit
+#define PYRAMID_TEST_EMULATION_TIMINGS_MAX (128 * 6 * 2 * 10)
+
 MU_TEST(test_lfrfid_protocol_em_read_simple) {
     ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
     mu_assert_int_eq(EM_TEST_DATA_SIZE, protocol_dict_get_data_size(dict, LFRFIDProtocolEM4100));
@@ -445,6 +451,52 @@ MU_TEST(test_lfrfid_protocol_inadala26_emulate_simple) {
     protocol_dict_free(dict);
 }
 
+MU_TEST(test_lfrfid_protocol_pyramid_roundtrip) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    mu_assert_int_eq(
+        PYRAMID_TEST_DATA_SIZE, protocol_dict_get_data_size(dict, LFRFIDProtocolPyramid));
+
+    const uint8_t data[PYRAMID_TEST_DATA_SIZE] = PYRAMID_TEST_DATA;
+
+    protocol_dict_set_data(dict, LFRFIDProtocolPyramid, data, PYRAMID_TEST_DATA_SIZE);
+    mu_check(protocol_dict_encoder_start(dict, LFRFIDProtocolPyramid));
+
+    // Feed the emulated signal back into the decoders, as the reader would see it
+    protocol_dict_decoders_start(dict);
+
+    ProtocolId protocol = PROTOCOL_NO;
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0; i < PYRAMID_TEST_EMULATION_TIMINGS_MAX; i++) {
+        LevelDuration level_duration = protocol_dict_encoder_yield(dict, LFRFIDProtocolPyramid);
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration) * LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            uint32_t length, period;
+            pulse_glue_pop(pulse_glue, &length, &period);
+
+            protocol = protocol_dict_decoders_feed(dict, true, period);
+            if(protocol != PROTOCOL_NO) break;
+
+            protocol = protocol_dict_decoders_feed(dict, false, length - period);
+            if(protocol != PROTOCOL_NO) break;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+
+    mu_assert_int_eq(LFRFIDProtocolPyramid, protocol);
+    uint8_t received_data[PYRAMID_TEST_DATA_SIZE] = {0};
+    protocol_dict_get_data(dict, protocol, received_data, PYRAMID_TEST_DATA_SIZE);
+
+    mu_assert_mem_eq(data, received_data, PYRAMID_TEST_DATA_SIZE);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -456,6 +508,8 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_ioprox_xsf_emulate_simple);
 
     MU_RUN_TEST(test_lfrfid_protocol_inadala26_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_protocol_pyramid_roundtrip);
 }
 
 int run_minunit_test_lfrfid_protocols() {
@@ -4,6 +4,8 @@
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
+#include <lib/nfc/protocols/crypto1.h>
+#include <lib/nfc/protocols/nfc_util.h>
 #include <lib/nfc/helpers/mf_classic_dict.h>
 #include <lib/digital_signal/digital_signal.h>
 #include <lib/pulse_reader/pulse_reader.h>
@@ -21,6 +23,7 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+#define NFC_TEST_DICT_INDEX_PATH EXT_PATH("unit_tests/mf_classic_dict.idx")
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -55,6 +58,8 @@ static void nfc_test_alloc() {
 static void nfc_test_free() {
     furi_check(nfc_test);
 
+    // Index sidecar is created next to the test dictionary
+    storage_simply_remove(nfc_test->storage, NFC_TEST_DICT_INDEX_PATH);
     furi_record_close(RECORD_STORAGE);
     nfca_signal_free(nfc_test->signal);
     free(nfc_test);
@@ -419,6 +424,63 @@ MU_TEST(mf_classic_dict_test) {
     furi_string_free(temp_str);
 }
 
+MU_TEST(mf_classic_dict_index_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_file_exists(storage, NFC_TEST_DICT_PATH)) {
+        mu_assert(
+            storage_simply_remove(storage, NFC_TEST_DICT_PATH),
+            "remove == true assert failed\r\n");
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    const char* keys[] = {"FFFFFFFFFFFF", "000000000000", "A0A1A2A3A4A5", "000000000000"};
+    uint32_t index = 0;
+    FuriString* temp_str = furi_string_alloc();
+
+    MfClassicDict* instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    for(size_t i = 0; i < COUNT_OF(keys); i++) {
+        furi_string_set(temp_str, keys[i]);
+        mu_assert(mf_classic_dict_add_key_str(instance, temp_str), "add_key_str failed\r\n");
+    }
+    mf_classic_dict_free(instance);
+
+    // Reload from sidecar
+    instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+    mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+    mu_assert(mf_classic_dict_get_total_keys(instance) == 4, "total_keys == 4 assert failed\r\n");
+
+    furi_string_set(temp_str, "A0A1A2A3A4A5");
+    mu_assert(mf_classic_dict_find_index_str(instance, temp_str, &index), "key not found\r\n");
+    mu_assert(index == 2, "index == 2 assert failed\r\n");
+    furi_string_set(temp_str, "000000000000");
+    mu_assert(mf_classic_dict_find_index_str(instance, temp_str, &index), "key not found\r\n");
+    mu_assert(index == 1, "first duplicate index == 1 assert failed\r\n");
+    furi_string_set(temp_str, "2196FAD8115B");
+    mu_assert(
+        !mf_classic_dict_is_key_present_str(instance, temp_str), "missing key reported\r\n");
+
+    mu_assert(mf_classic_dict_get_key_at_index_str(instance, temp_str, 3), "get_key failed\r\n");
+    mu_assert(furi_string_cmp_str(temp_str, "000000000000") == 0, "invalid key at 3\r\n");
+
+    // Indices after the deleted key shift down
+    mu_assert(mf_classic_dict_delete_index(instance, 0), "delete_index failed\r\n");
+    furi_string_set(temp_str, "A0A1A2A3A4A5");
+    mu_assert(mf_classic_dict_find_index_str(instance, temp_str, &index), "key not found\r\n");
+    mu_assert(index == 1, "index == 1 assert failed\r\n");
+    furi_string_set(temp_str, "FFFFFFFFFFFF");
+    mu_assert(
+        !mf_classic_dict_is_key_present_str(instance, temp_str), "deleted key reported\r\n");
+
+    for(size_t i = 0; i < COUNT_OF(keys) - 1; i++) {
+        mu_assert(mf_classic_dict_delete_index(instance, 0), "delete_index failed\r\n");
+    }
+    mu_assert(mf_classic_dict_get_total_keys(instance) == 0, "total_keys == 0 assert failed\r\n");
+
+    mf_classic_dict_free(instance);
+    furi_string_free(temp_str);
+}
+
 MU_TEST(mf_classic_dict_load_test) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     mu_assert(storage != NULL, "storage != NULL assert failed\r\n");
@@ -702,6 +764,167 @@ MU_TEST(mf_classic_4k_7b_file_test) {
     mf_classic_generator_test(7, MfClassicType4k);
 }
 
+#define NFC_TEST_CRYPTO1_ROUNDS (2000)
+#define NFC_TEST_CRYPTO1_BENCH_WORDS (1024)
+
+static uint32_t nfc_test_crypto1_random(uint32_t* seed) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+// Bit serial reference implementation, as crypto1 was before the table driven engine
+static uint32_t nfc_test_crypto1_ref_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t nfc_test_crypto1_ref_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = nfc_test_crypto1_ref_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= 0x29CE5C & crypto1->odd;
+    feed ^= 0x870804 & crypto1->even;
+    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+    FURI_SWAP(crypto1->odd, crypto1->even);
+    return out;
+}
+
+static uint8_t nfc_test_crypto1_ref_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= nfc_test_crypto1_ref_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+static uint32_t nfc_test_crypto1_ref_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)nfc_test_crypto1_ref_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted)
+               << (24 ^ i);
+    }
+    return out;
+}
+
+static uint64_t nfc_test_crypto1_random_key(uint32_t* seed) {
+    uint64_t key = nfc_test_crypto1_random(seed);
+    return (key << 16 | (nfc_test_crypto1_random(seed) & 0xffff)) & 0xFFFFFFFFFFFF;
+}
+
+MU_TEST(crypto1_filter_test) {
+    for(uint32_t in = 0; in < (1 << 20); in++) {
+        if(crypto1_filter(in) != nfc_test_crypto1_ref_filter(in)) {
+            FURI_LOG_E(TAG, "Filter mismatch for %05lX", in);
+            mu_fail("crypto1_filter mismatch\r\n");
+        }
+    }
+}
+
+MU_TEST(crypto1_engine_test) {
+    uint32_t seed = 0x12345678;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_ROUNDS; i++) {
+        Crypto1 dut = {};
+        Crypto1 ref = {};
+        crypto1_init(&dut, nfc_test_crypto1_random_key(&seed));
+        ref = dut;
+
+        int is_encrypted = i & 1;
+        uint32_t word = nfc_test_crypto1_random(&seed);
+        mu_assert(
+            crypto1_word(&dut, word, is_encrypted) ==
+                nfc_test_crypto1_ref_word(&ref, word, is_encrypted),
+            "crypto1_word keystream mismatch\r\n");
+        mu_assert(
+            (dut.odd == ref.odd) && (dut.even == ref.even), "crypto1_word state mismatch\r\n");
+
+        uint8_t byte = word >> 8;
+        mu_assert(
+            crypto1_byte(&dut, byte, is_encrypted) ==
+                nfc_test_crypto1_ref_byte(&ref, byte, is_encrypted),
+            "crypto1_byte keystream mismatch\r\n");
+        mu_assert(
+            crypto1_bit(&dut, byte & 1, is_encrypted) ==
+                nfc_test_crypto1_ref_bit(&ref, byte & 1, is_encrypted),
+            "crypto1_bit keystream mismatch\r\n");
+        mu_assert(
+            (dut.odd == ref.odd) && (dut.even == ref.even), "crypto1_byte state mismatch\r\n");
+    }
+}
+
+MU_TEST(crypto1_batch_test) {
+    uint32_t seed = 0xCAFEBABE;
+    uint64_t keys[CRYPTO1_BATCH_SIZE];
+
+    for(size_t round = 0; round < 64; round++) {
+        for(size_t i = 0; i < CRYPTO1_BATCH_SIZE; i++) {
+            keys[i] = nfc_test_crypto1_random_key(&seed);
+        }
+        uint32_t cuid = nfc_test_crypto1_random(&seed);
+        uint32_t nt = nfc_test_crypto1_random(&seed);
+        uint32_t nr = nfc_test_crypto1_random(&seed);
+        size_t target = round % CRYPTO1_BATCH_SIZE;
+
+        // Reader side of the authentication with the target key
+        Crypto1 crypto = {};
+        crypto1_init(&crypto, keys[target]);
+        crypto1_word(&crypto, nt ^ cuid, 0);
+        uint32_t nr_enc = crypto1_word(&crypto, nr, 0) ^ nr;
+        uint32_t ar_enc = crypto1_word(&crypto, 0, 0) ^ prng_successor(nt, 32);
+
+        mu_assert(
+            crypto1_batch_check_auth(keys, CRYPTO1_BATCH_SIZE, cuid, nt, nr_enc, ar_enc) ==
+                (1UL << target),
+            "crypto1_batch_check_auth mask mismatch\r\n");
+        mu_assert(
+            crypto1_batch_check_auth(keys, target, cuid, nt, nr_enc, ar_enc) == 0,
+            "crypto1_batch_check_auth unused lanes matched\r\n");
+    }
+}
+
+MU_TEST(crypto1_benchmark_test) {
+    Crypto1 crypto = {};
+    uint64_t keys[CRYPTO1_BATCH_SIZE] = {};
+    volatile uint32_t sink = 0;
+
+    crypto1_init(&crypto, 0xA0A1A2A3A4A5);
+    uint32_t time_start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        sink += nfc_test_crypto1_ref_word(&crypto, i, 0);
+    }
+    uint32_t time_ref = DWT->CYCCNT - time_start;
+
+    time_start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        sink += crypto1_word(&crypto, i, 0);
+    }
+    uint32_t time_word = DWT->CYCCNT - time_start;
+
+    // Every check clocks 3 words for each of the keys
+    time_start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS / 3; i++) {
+        sink += crypto1_batch_check_auth(keys, CRYPTO1_BATCH_SIZE, i, i, i, i);
+    }
+    uint32_t time_batch = (DWT->CYCCNT - time_start) / CRYPTO1_BATCH_SIZE;
+    UNUSED(sink);
+
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 cycles per %d words: reference %lu, crypto1_word %lu, batch per key %lu",
+        NFC_TEST_CRYPTO1_BENCH_WORDS,
+        time_ref,
+        time_word,
+        time_batch);
+    mu_assert(time_word < time_ref, "crypto1_word slower than reference\r\n");
+    mu_assert(time_batch < time_word, "batch slower than crypto1_word\r\n");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -714,7 +937,12 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_4k_7b_file_test);
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_dict_index_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(crypto1_filter_test);
+    MU_RUN_TEST(crypto1_engine_test);
+    MU_RUN_TEST(crypto1_batch_test);
+    MU_RUN_TEST(crypto1_benchmark_test);
 
     nfc_test_free();
 }
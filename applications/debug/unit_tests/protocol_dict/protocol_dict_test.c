@@ -212,8 +212,153 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+/*********************** SHARED DEMOD ***********************/
+
+typedef enum {
+    TestDemodDictProtocol0,
+    TestDemodDictProtocolA,
+    TestDemodDictProtocolB,
+
+    TestDemodDictProtocolMax,
+} TestDemodDictProtocols;
+
+static size_t test_demod_feed_count = 0;
+
+static void* test_demod_alloc() {
+    return malloc(sizeof(uint32_t));
+}
+
+static void test_demod_free(uint32_t* demod) {
+    free(demod);
+}
+
+static void test_demod_reset(uint32_t* demod) {
+    *demod = 0;
+}
+
+static void test_demod_feed(
+    uint32_t* demod,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count) {
+    UNUSED(demod);
+    test_demod_feed_count++;
+    *value = level;
+    *count = duration / 100;
+}
+
+static const ProtocolDemod test_demod = {
+    .alloc = (ProtocolDemodAlloc)test_demod_alloc,
+    .free = (ProtocolDemodFree)test_demod_free,
+    .reset = (ProtocolDemodReset)test_demod_reset,
+    .feed = (ProtocolDemodFeed)test_demod_feed,
+};
+
+static void* protocol_demod_alloc() {
+    return malloc(sizeof(uint32_t));
+}
+
+static void protocol_demod_free(uint32_t* ones) {
+    free(ones);
+}
+
+static uint8_t* protocol_demod_get_data(uint32_t* ones) {
+    return (uint8_t*)ones;
+}
+
+static void protocol_demod_decoder_start(uint32_t* ones) {
+    *ones = 0;
+}
+
+static bool protocol_a_decoder_feed_bits(uint32_t* ones, bool value, uint32_t count) {
+    if(value) *ones += count;
+    return *ones >= 4;
+}
+
+static bool protocol_b_decoder_feed_bits(uint32_t* ones, bool value, uint32_t count) {
+    if(value) *ones += count;
+    return *ones >= 6;
+}
+
+static const ProtocolBase protocol_a = {
+    .name = "Protocol A",
+    .manufacturer = "Manufacturer A",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_demod_alloc,
+    .free = (ProtocolFree)protocol_demod_free,
+    .get_data = (ProtocolGetData)protocol_demod_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_demod_decoder_start,
+        },
+    .demod = &test_demod,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_a_decoder_feed_bits,
+};
+
+static const ProtocolBase protocol_b = {
+    .name = "Protocol B",
+    .manufacturer = "Manufacturer B",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_demod_alloc,
+    .free = (ProtocolFree)protocol_demod_free,
+    .get_data = (ProtocolGetData)protocol_demod_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_demod_decoder_start,
+        },
+    .demod = &test_demod,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_b_decoder_feed_bits,
+};
+
+static const ProtocolBase* test_demod_protocols_base[] = {
+    [TestDemodDictProtocol0] = &protocol_0,
+    [TestDemodDictProtocolA] = &protocol_a,
+    [TestDemodDictProtocolB] = &protocol_b,
+};
+
+MU_TEST(test_protocol_dict_shared_demod) {
+    ProtocolDict* dict = protocol_dict_alloc(test_demod_protocols_base, TestDemodDictProtocolMax);
+    protocol_dict_decoders_start(dict);
+    test_demod_feed_count = 0;
+
+    // demod runs once per pulse for both protocols
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, true, 200));
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, false, 300));
+    mu_assert_int_eq(2, test_demod_feed_count);
+
+    // no bits, no feed_bits call
+    mu_assert_int_eq(PROTOCOL_NO, protocol_dict_decoders_feed(dict, true, 50));
+    mu_assert_int_eq(3, test_demod_feed_count);
+
+    mu_assert_int_eq(TestDemodDictProtocolA, protocol_dict_decoders_feed(dict, true, 200));
+    mu_assert_int_eq(4, test_demod_feed_count);
+
+    uint32_t ones = 0;
+    protocol_dict_get_data(dict, TestDemodDictProtocolA, (uint8_t*)&ones, sizeof(ones));
+    mu_assert_int_eq(4, ones);
+    protocol_dict_get_data(dict, TestDemodDictProtocolB, (uint8_t*)&ones, sizeof(ones));
+    mu_assert_int_eq(4, ones);
+
+    mu_assert_int_eq(
+        TestDemodDictProtocolB,
+        protocol_dict_decoders_feed_by_id(dict, TestDemodDictProtocolB, true, 200));
+    mu_assert_int_eq(5, test_demod_feed_count);
+
+    // protocols without a demod still get pulses
+    mu_assert_int_eq(TestDemodDictProtocol0, protocol_dict_decoders_feed(dict, true, 666));
+    mu_assert_int_eq(6, test_demod_feed_count);
+
+    protocol_dict_decoders_start(dict);
+    protocol_dict_get_data(dict, TestDemodDictProtocolB, (uint8_t*)&ones, sizeof(ones));
+    mu_assert_int_eq(0, ones);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_shared_demod);
 }
 
 int run_minunit_test_protocol_dict() {
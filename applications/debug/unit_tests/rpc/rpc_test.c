@@ -4,10 +4,12 @@
 #include "pb_decode.h"
 #include <rpc/rpc.h>
 #include "rpc/rpc_i.h"
+#include "rpc/rpc_gui_frame.h"
 #include "storage.pb.h"
 #include "storage/filesystem_api_defines.h"
 #include "storage/storage.h"
 #include <furi.h>
+#include <furi_hal_random.h>
 #include "../minunit.h"
 #include <stdint.h>
 #include <pb.h>
@@ -1834,6 +1836,59 @@ MU_TEST_SUITE(test_rpc_session) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define TEST_GUI_FRAME_SIZE (1024U)
+
+static void test_gui_frame_roundtrip(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    uint8_t expected_type,
+    size_t max_size) {
+    uint8_t* encoded = malloc(RPC_GUI_FRAME_MAX_SIZE(TEST_GUI_FRAME_SIZE));
+    uint8_t* decoded = malloc(TEST_GUI_FRAME_SIZE);
+    if(reference) memcpy(decoded, reference, TEST_GUI_FRAME_SIZE);
+
+    size_t size = rpc_gui_frame_encode(frame, reference, TEST_GUI_FRAME_SIZE, encoded);
+    mu_assert_int_eq(expected_type, encoded[0]);
+    mu_assert(size <= max_size, "encoded frame is too big");
+    mu_check(rpc_gui_frame_decode(encoded, size, decoded, TEST_GUI_FRAME_SIZE));
+    mu_assert_mem_eq(frame, decoded, TEST_GUI_FRAME_SIZE);
+
+    // Truncated frame must be rejected
+    mu_check(!rpc_gui_frame_decode(encoded, size - 1, decoded, TEST_GUI_FRAME_SIZE));
+
+    free(decoded);
+    free(encoded);
+}
+
+MU_TEST(test_gui_frame_codec) {
+    uint8_t* previous = malloc(TEST_GUI_FRAME_SIZE);
+    uint8_t* frame = malloc(TEST_GUI_FRAME_SIZE);
+
+    // Mostly empty screen with some text
+    for(size_t i = 0; i < TEST_GUI_FRAME_SIZE; i++) {
+        previous[i] = (i % 128 < 48 && i / 128 == 2) ? (uint8_t)(i * 37) : 0x00;
+    }
+    test_gui_frame_roundtrip(previous, NULL, RpcGuiFrameTypeKey, 256);
+
+    // Small change against the previous frame
+    memcpy(frame, previous, TEST_GUI_FRAME_SIZE);
+    frame[700] = 0x5A;
+    frame[701] = 0xA5;
+    test_gui_frame_roundtrip(frame, previous, RpcGuiFrameTypeDelta, 32);
+
+    // Noise does not compress and falls back to raw
+    furi_hal_random_fill_buf(frame, TEST_GUI_FRAME_SIZE);
+    test_gui_frame_roundtrip(
+        frame, previous, RpcGuiFrameTypeRaw, RPC_GUI_FRAME_MAX_SIZE(TEST_GUI_FRAME_SIZE));
+
+    free(frame);
+    free(previous);
+}
+
+MU_TEST_SUITE(test_rpc_gui) {
+    MU_RUN_TEST(test_gui_frame_codec);
+}
+
 int run_minunit_test_rpc() {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     if(storage_sd_status(storage) != FSE_OK) {
@@ -1845,6 +1900,7 @@ int run_minunit_test_rpc() {
     MU_RUN_SUITE(test_rpc_system);
     MU_RUN_SUITE(test_rpc_app);
     MU_RUN_SUITE(test_rpc_session);
+    MU_RUN_SUITE(test_rpc_gui);
 
     return MU_EXIT_CODE;
 }
@@ -115,10 +115,36 @@ MU_TEST(storage_file_open_close) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(storage_file_direct_access) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const uint8_t pattern[] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+    uint8_t buffer[sizeof(pattern)];
+
+    const uint32_t direct_before = storage->stats[StorageCommandFileRead].direct;
+    const uint32_t queued_before = storage->stats[StorageCommandFileRead].queued;
+
+    mu_check(storage_file_open(file, STORAGE_LOCKED_FILE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_assert_int_eq(sizeof(pattern), storage_file_write(file, pattern, sizeof(pattern)));
+    mu_check(storage_file_seek(file, 0, true));
+    mu_assert_int_eq(sizeof(pattern), storage_file_read(file, buffer, sizeof(buffer)));
+    mu_assert_mem_eq(pattern, buffer, sizeof(pattern));
+    mu_check(storage_file_eof(file));
+    storage_file_close(file);
+    storage_file_free(file);
+
+    // Open files on the SD card are served without the storage thread
+    mu_assert_int_eq(direct_before + 1, storage->stats[StorageCommandFileRead].direct);
+    mu_assert_int_eq(queued_before, storage->stats[StorageCommandFileRead].queued);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(storage_file) {
     storage_file_open_lock_setup();
     MU_RUN_TEST(storage_file_open_close);
     MU_RUN_TEST(storage_file_open_lock);
+    MU_RUN_TEST(storage_file_direct_access);
     storage_file_open_lock_teardown();
 }
 
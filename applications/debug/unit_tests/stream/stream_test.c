@@ -518,12 +518,74 @@ MU_TEST(stream_buffered_large_file_test) {
     furi_string_free(output_data);
 }
 
+MU_TEST(stream_buffered_cache_test) {
+    const BufferedFileStreamConfig config = {
+        .block_size = 64,
+        .block_count = 4,
+        .read_ahead = true,
+    };
+    const size_t data_size = 1000;
+    uint8_t data[data_size];
+    uint8_t buf[100];
+
+    for(size_t i = 0; i < data_size; i++) {
+        data[i] = i * 7;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open_ex(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS, &config));
+    mu_assert_int_eq(data_size, stream_write(stream, data, data_size));
+    mu_assert_int_eq(data_size, stream_size(stream));
+
+    // sequential read with small backward seeks across block boundaries
+    mu_check(stream_rewind(stream));
+    size_t position = 0;
+    while(position + 30 <= data_size) {
+        mu_assert_int_eq(30, stream_read(stream, buf, 30));
+        mu_assert_mem_eq(data + position, buf, 30);
+        mu_check(stream_seek(stream, -7, StreamOffsetFromCurrent));
+        position += 23;
+        mu_assert_int_eq(position, stream_tell(stream));
+    }
+
+    // jump back to cached and evicted blocks
+    mu_check(stream_seek(stream, 900, StreamOffsetFromStart));
+    mu_assert_int_eq(50, stream_read(stream, buf, 50));
+    mu_assert_mem_eq(data + 900, buf, 50);
+    mu_check(stream_rewind(stream));
+    mu_assert_int_eq(100, stream_read(stream, buf, 100));
+    mu_assert_mem_eq(data, buf, 100);
+
+    // overwrite a region that is cached, cached copies must not be returned
+    memset(data + 60, 0xAA, 10);
+    mu_check(stream_seek(stream, 60, StreamOffsetFromStart));
+    mu_assert_int_eq(10, stream_write(stream, data + 60, 10));
+    mu_check(stream_seek(stream, 50, StreamOffsetFromStart));
+    mu_assert_int_eq(30, stream_read(stream, buf, 30));
+    mu_assert_mem_eq(data + 50, buf, 30);
+
+    // read the whole file
+    mu_check(stream_rewind(stream));
+    for(position = 0; position < data_size; position += 100) {
+        mu_assert_int_eq(100, stream_read(stream, buf, 100));
+        mu_assert_mem_eq(data + position, buf, 100);
+    }
+    mu_assert_int_eq(0, stream_read(stream, buf, 1));
+    mu_check(stream_eof(stream));
+
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_buffered_cache_test);
 }
 
 int run_minunit_test_stream() {
@@ -5,8 +5,10 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_packed.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/buffered_file_stream.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
@@ -17,7 +19,10 @@
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_PACKED_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw_packed.sub")
+#define TEST_UNPACKED_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw_unpacked.sub")
 #define TEST_TIMEOUT 10000
+#define TEST_BATCH_SIZE 64
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -108,6 +113,7 @@ static bool subghz_decoder_test(const char* path, const char* name_decoder) {
 static bool subghz_decode_random_test(const char* path) {
     subghz_test_decoder_count = 0;
     subghz_receiver_reset(receiver_handler);
+    subghz_receiver_reset_feed_count(receiver_handler);
     uint32_t test_start = furi_get_tick();
 
     file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
@@ -146,6 +152,54 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static bool subghz_decode_random_batch_test(const char* path) {
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+    subghz_receiver_reset_feed_count(receiver_handler);
+    uint32_t test_start = furi_get_tick();
+
+    LevelDuration batch[TEST_BATCH_SIZE];
+    size_t batch_count = 0;
+
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        LevelDuration level_duration;
+        while(furi_get_tick() - test_start < TEST_TIMEOUT * 10) {
+            level_duration =
+                subghz_file_encoder_worker_get_level_duration(file_worker_encoder_handler);
+            if(!level_duration_is_reset(level_duration)) {
+                batch[batch_count++] = level_duration;
+                if(batch_count == TEST_BATCH_SIZE) {
+                    // Yield, to load data inside the worker
+                    furi_thread_yield();
+                    subghz_receiver_decode_batch(receiver_handler, batch, batch_count);
+                    batch_count = 0;
+                }
+            } else {
+                break;
+            }
+        }
+        subghz_receiver_decode_batch(receiver_handler, batch, batch_count);
+        furi_delay_ms(10);
+        if(subghz_file_encoder_worker_is_running(file_worker_encoder_handler)) {
+            subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+        }
+        subghz_file_encoder_worker_free(file_worker_encoder_handler);
+    }
+    FURI_LOG_D(TAG, "Decoder count parse %d", subghz_test_decoder_count);
+    if(furi_get_tick() - test_start > TEST_TIMEOUT * 10) {
+        printf("Random batch test ERROR TimeOut\r\n");
+        return false;
+    } else if(subghz_test_decoder_count == TEST_RANDOM_COUNT_PARSE) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -818,6 +872,61 @@ MU_TEST(subghz_encoder_mastercode_test) {
 
 MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
+    // Idle decoders must be skipped for pulses outside of their start window
+    mu_assert(
+        subghz_receiver_get_feed_count(receiver_handler, SUBGHZ_PROTOCOL_PRINCETON_NAME) <
+            subghz_receiver_get_pulse_count(receiver_handler),
+        "Receiver dispatch error\r\n");
+}
+
+MU_TEST(subghz_random_batch_test) {
+    mu_assert(
+        subghz_decode_random_batch_test(TEST_RANDOM_DIR_NAME), "Random batch test error\r\n");
+}
+
+static bool subghz_raw_packed_convert(const char* source, const char* destination, bool pack) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* input = buffered_file_stream_alloc(storage);
+    Stream* output = buffered_file_stream_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!buffered_file_stream_open(input, source, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(!buffered_file_stream_open(output, destination, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(pack) {
+            if(!subghz_raw_packed_pack(input, output)) break;
+        } else {
+            if(!subghz_raw_packed_unpack(input, output)) break;
+        }
+        result = buffered_file_stream_sync(output);
+    } while(false);
+
+    buffered_file_stream_close(output);
+    buffered_file_stream_close(input);
+    stream_free(output);
+    stream_free(input);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(subghz_raw_packed_test) {
+    mu_assert(
+        subghz_raw_packed_convert(TEST_RANDOM_DIR_NAME, TEST_PACKED_DIR_NAME, true),
+        "Pack error\r\n");
+    mu_assert(subghz_decode_random_test(TEST_PACKED_DIR_NAME), "Packed random test error\r\n");
+
+    mu_assert(
+        subghz_raw_packed_convert(TEST_PACKED_DIR_NAME, TEST_UNPACKED_DIR_NAME, false),
+        "Unpack error\r\n");
+    mu_assert(
+        subghz_decode_random_test(TEST_UNPACKED_DIR_NAME), "Unpacked random test error\r\n");
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_PACKED_DIR_NAME);
+    storage_simply_remove(storage, TEST_UNPACKED_DIR_NAME);
+    furi_record_close(RECORD_STORAGE);
 }
 
 MU_TEST_SUITE(subghz) {
@@ -896,6 +1005,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_mastercode_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_random_batch_test);
+    MU_RUN_TEST(subghz_raw_packed_test);
     subghz_test_deinit();
 }
 
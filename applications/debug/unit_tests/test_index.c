@@ -18,6 +18,7 @@ int run_minunit_test_manifest();
 int run_minunit_test_flipper_format();
 int run_minunit_test_flipper_format_string();
 int run_minunit_test_stream();
+int run_minunit_test_compress();
 int run_minunit_test_storage();
 int run_minunit_test_subghz();
 int run_minunit_test_dirwalk();
@@ -44,6 +45,7 @@ const UnitTest unit_tests[] = {
     {.name = "furi_string", .entry = run_minunit_test_furi_string},
     {.name = "storage", .entry = run_minunit_test_storage},
     {.name = "stream", .entry = run_minunit_test_stream},
+    {.name = "compress", .entry = run_minunit_test_compress},
     {.name = "dirwalk", .entry = run_minunit_test_dirwalk},
     {.name = "manifest", .entry = run_minunit_test_manifest},
     {.name = "flipper_format", .entry = run_minunit_test_flipper_format},
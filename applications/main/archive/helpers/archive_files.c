@@ -116,6 +116,9 @@ void archive_delete_file(void* context, const char* format, ...) {
 
     if(res) {
         archive_file_array_rm_selected(browser);
+        if(browser->worker_running) {
+            file_browser_worker_index_remove(browser->worker, furi_string_get_cstr(filename));
+        }
     }
 
     furi_string_free(filename);
@@ -185,6 +188,14 @@ FS_Error archive_rename_copy_file_or_dir(
     if(error == FSE_OK) {
         FURI_LOG_I(
             TAG, "%s from %s to %s is DONE", copy ? "Copy" : "Rename/Move", src_path, dst_path);
+
+        ArchiveBrowserView* browser = context;
+        if(browser->worker_running) {
+            if(!copy) {
+                file_browser_worker_index_remove(browser->worker, src_path);
+            }
+            file_browser_worker_index_add(browser->worker, dst_path);
+        }
     } else {
         FURI_LOG_E(
             TAG,
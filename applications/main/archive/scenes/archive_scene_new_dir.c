@@ -69,6 +69,10 @@ bool archive_scene_new_dir_on_event(void* context, SceneManagerEvent event) {
             } else {
                 ArchiveFile_t* current = archive_get_current_file(archive->browser);
                 if(current != NULL) furi_string_set(current->path, path_dst);
+                if(archive->browser->worker_running) {
+                    file_browser_worker_index_add(
+                        archive->browser->worker, furi_string_get_cstr(path_dst));
+                }
             }
 
             furi_string_free(path_dst);
@@ -12,9 +12,6 @@
 #define TAG "BadUsb"
 #define WORKER_TAG TAG "Worker"
 
-#define BADUSB_ASCII_TO_KEY(script, x) \
-    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
-
 typedef enum {
     WorkerEvtStartStop = (1 << 0),
     WorkerEvtPauseResume = (1 << 1),
@@ -240,9 +237,13 @@ static bool ducky_script_preload(BadUsbScript* bad_usb, File* script_file) {
     uint32_t line_len = 0;
 
     furi_string_reset(bad_usb->line);
+    bad_usb->script_size = 0;
+    bad_usb->script_hash = DUCKY_HASH_INIT;
 
     do {
         ret = storage_file_read(script_file, bad_usb->file_buf, FILE_BUFFER_LEN);
+        bad_usb->script_size += ret;
+        bad_usb->script_hash = ducky_hash(bad_usb->script_hash, bad_usb->file_buf, ret);
         for(uint16_t i = 0; i < ret; i++) {
             if(bad_usb->file_buf[i] == '\n' && line_len > 0) {
                 bad_usb->st.line_nb++;
@@ -439,7 +440,9 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->repeat_cnt = 0;
                 bad_usb->key_hold_nb = 0;
                 bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                if(!ducky_bytecode_open(bad_usb, script_file)) {
+                    storage_file_seek(script_file, 0, true);
+                }
                 worker_state = BadUsbStateRunning;
             } else if(flags & WorkerEvtDisconnect) {
                 worker_state = BadUsbStateNotConnected; // USB disconnected
@@ -461,7 +464,9 @@ static int32_t bad_usb_worker(void* context) {
                 bad_usb->stringdelay = 0;
                 bad_usb->repeat_cnt = 0;
                 bad_usb->file_end = false;
-                storage_file_seek(script_file, 0, true);
+                if(!ducky_bytecode_open(bad_usb, script_file)) {
+                    storage_file_seek(script_file, 0, true);
+                }
                 // extra time for PC to recognize Flipper as keyboard
                 flags = furi_thread_flags_wait(
                     WorkerEvtEnd | WorkerEvtDisconnect | WorkerEvtStartStop,
@@ -510,7 +515,11 @@ static int32_t bad_usb_worker(void* context) {
                     continue;
                 }
                 bad_usb->st.state = BadUsbStateRunning;
-                delay_val = ducky_script_execute_next(bad_usb, script_file);
+                if(bad_usb->bytecode) {
+                    delay_val = ducky_bytecode_execute_next(bad_usb);
+                } else {
+                    delay_val = ducky_script_execute_next(bad_usb, script_file);
+                }
                 if(delay_val == SCRIPT_STATE_ERROR) { // Script error
                     delay_val = 0;
                     worker_state = BadUsbStateScriptError;
@@ -608,7 +617,8 @@ static int32_t bad_usb_worker(void* context) {
             } else if(
                 (flags == (unsigned)FuriFlagErrorTimeout) ||
                 (flags == (unsigned)FuriFlagErrorResource)) {
-                bool string_end = ducky_string_next(bad_usb);
+                bool string_end = bad_usb->bytecode ? ducky_bytecode_string_next(bad_usb) :
+                                                      ducky_string_next(bad_usb);
                 if(string_end) {
                     bad_usb->stringdelay = 0;
                     worker_state = BadUsbStateRunning;
@@ -630,6 +640,7 @@ static int32_t bad_usb_worker(void* context) {
 
     furi_hal_hid_set_state_callback(NULL, NULL);
 
+    ducky_bytecode_close(bad_usb);
     storage_file_close(script_file);
     storage_file_free(script_file);
     furi_string_free(bad_usb->line);
@@ -657,6 +668,7 @@ BadUsbScript* bad_usb_script_open(FuriString* file_path) {
 
     bad_usb->st.state = BadUsbStateInit;
     bad_usb->st.error[0] = '\0';
+    bad_usb->bytecode = NULL;
 
     bad_usb->thread = furi_thread_alloc_ex("BadUsbWorker", 2048, bad_usb_worker, bad_usb);
     furi_thread_start(bad_usb->thread);
@@ -0,0 +1,570 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_usb_hid.h>
+#include <storage/storage.h>
+#include "ducky_script.h"
+#include "ducky_script_i.h"
+
+#define TAG "BadUsb"
+#define WORKER_TAG TAG "Worker"
+
+/*
+ * Bytecode file: header followed by instructions in script order.
+ * Instruction: op, source line and argument, then optional payload:
+ * - String: argument is the number of HID keycodes in the payload, resolved for the layout;
+ * - AltChar, AltString, Error: argument is the size of a null-terminated string payload;
+ * - other operations: argument is the value (delay, repeat count, keycode).
+ * Errors are compiled as Error instructions, so lines before them run like in the text script.
+ */
+
+#define DUCKY_BYTECODE_MAGIC 0x43425544UL // "DUBC"
+#define DUCKY_BYTECODE_VERSION 1
+
+#define DUCKY_COMPILE_BUFFER_LEN 256
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t script_size;
+    uint32_t script_hash;
+    uint32_t layout_hash;
+    uint32_t code_size;
+} __attribute__((packed)) DuckyBytecodeHeader;
+
+typedef struct {
+    uint8_t op;
+    uint8_t reserved[3];
+    uint32_t line;
+    uint32_t arg;
+} __attribute__((packed)) DuckyBytecodeInsn;
+
+typedef struct {
+    BadUsbScript* bad_usb;
+    File* file;
+    uint32_t code_size;
+    uint32_t line_cur;
+    bool stop;
+    bool write_error;
+} DuckyCompiler;
+
+uint32_t ducky_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t ducky_bytecode_payload_size(const DuckyBytecodeInsn* insn) {
+    switch(insn->op) {
+    case DuckyOpString:
+        return insn->arg * sizeof(uint16_t);
+    case DuckyOpAltChar:
+    case DuckyOpAltString:
+    case DuckyOpError:
+        return insn->arg;
+    default:
+        return 0;
+    }
+}
+
+static bool ducky_bytecode_write(DuckyCompiler* compiler, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    while(size > 0) {
+        uint16_t chunk = MIN(size, DUCKY_COMPILE_BUFFER_LEN);
+        if(storage_file_write(compiler->file, bytes, chunk) != chunk) {
+            compiler->write_error = true;
+            return false;
+        }
+        bytes += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+static void ducky_bytecode_emit(
+    DuckyCompiler* compiler,
+    DuckyOpcode op,
+    uint32_t arg,
+    const void* payload,
+    size_t payload_size) {
+    DuckyBytecodeInsn insn = {
+        .op = op,
+        .line = compiler->line_cur,
+        .arg = arg,
+    };
+    if(ducky_bytecode_write(compiler, &insn, sizeof(insn)) &&
+       ducky_bytecode_write(compiler, payload, payload_size)) {
+        compiler->code_size += sizeof(insn) + payload_size;
+    }
+}
+
+static void ducky_bytecode_emit_str(DuckyCompiler* compiler, DuckyOpcode op, const char* str) {
+    size_t size = strlen(str) + 1;
+    ducky_bytecode_emit(compiler, op, size, str, size);
+}
+
+static void ducky_bytecode_emit_error(DuckyCompiler* compiler, const char* text, ...) {
+    char error[sizeof(compiler->bad_usb->st.error)];
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(error, sizeof(error), text, args);
+    va_end(args);
+
+    ducky_bytecode_emit_str(compiler, DuckyOpError, error);
+    // Script execution stops at the error, nothing after it is reachable
+    compiler->stop = true;
+}
+
+static void ducky_bytecode_emit_string(DuckyCompiler* compiler, const char* str, bool newline) {
+    BadUsbScript* bad_usb = compiler->bad_usb;
+    size_t len = strlen(str);
+    uint16_t* keycodes = malloc((len + 1) * sizeof(uint16_t));
+    uint32_t count = 0;
+
+    for(size_t i = 0; i < len; i++) {
+        uint16_t keycode = BADUSB_ASCII_TO_KEY(bad_usb, str[i]);
+        if(keycode != HID_KEYBOARD_NONE) {
+            keycodes[count++] = keycode;
+        }
+    }
+    if(newline) {
+        keycodes[count++] = HID_KEYBOARD_RETURN;
+    }
+
+    ducky_bytecode_emit(compiler, DuckyOpString, count, keycodes, count * sizeof(uint16_t));
+    free(keycodes);
+}
+
+static void ducky_bytecode_compile_line(DuckyCompiler* compiler, const char* line) {
+    BadUsbScript* bad_usb = compiler->bad_usb;
+
+    if(line[0] == '\0') {
+        ducky_bytecode_emit(compiler, DuckyOpBlank, 0, NULL, 0);
+        return;
+    }
+
+    int32_t param = -1;
+    DuckyOpcode op = ducky_get_command_op(line, &param);
+    // Same parameter offset as the command callbacks
+    const char* arg = &line[ducky_get_command_len(line) + 1];
+    uint32_t value = 0;
+    uint16_t key = HID_KEYBOARD_NONE;
+
+    switch(op) {
+    case DuckyOpNop:
+    case DuckyOpWaitForButton:
+        ducky_bytecode_emit(compiler, op, 0, NULL, 0);
+        break;
+    case DuckyOpDelay:
+    case DuckyOpRepeat:
+        if(!ducky_get_number(arg, &value) || (value == 0)) {
+            ducky_bytecode_emit_error(compiler, "Invalid number %s", arg);
+        } else {
+            ducky_bytecode_emit(compiler, op, value, NULL, 0);
+        }
+        break;
+    case DuckyOpDefDelay:
+    case DuckyOpStringDelay:
+        if(!ducky_get_number(arg, &value)) {
+            ducky_bytecode_emit_error(compiler, "Invalid number %s", arg);
+        } else {
+            ducky_bytecode_emit(compiler, op, value, NULL, 0);
+        }
+        break;
+    case DuckyOpString:
+        ducky_bytecode_emit_string(compiler, arg, param == 1);
+        break;
+    case DuckyOpSysrq:
+        key = ducky_get_keycode(bad_usb, arg, true);
+        ducky_bytecode_emit(compiler, op, key, NULL, 0);
+        break;
+    case DuckyOpAltChar:
+    case DuckyOpAltString:
+        // Alt codes are typed digit by digit, invalid ones fail at runtime like in the text
+        ducky_bytecode_emit_str(compiler, op, arg);
+        break;
+    case DuckyOpHold:
+    case DuckyOpRelease:
+        key = ducky_get_keycode(bad_usb, arg, true);
+        if(key == HID_KEYBOARD_NONE) {
+            ducky_bytecode_emit_error(compiler, "No keycode defined for %s", arg);
+        } else {
+            ducky_bytecode_emit(compiler, op, key, NULL, 0);
+        }
+        break;
+    default:
+        // Special keys + modifiers
+        key = ducky_get_keycode(bad_usb, line, false);
+        if(key == HID_KEYBOARD_NONE) {
+            ducky_bytecode_emit_error(compiler, "No keycode defined for %s", line);
+            break;
+        }
+        if((key & 0xFF00) != 0) {
+            // It's a modifier key
+            uint32_t offset = ducky_get_command_len(line) + 1;
+            if(offset != 1 && strlen(line) > offset) {
+                // It's also a key combination
+                key |= ducky_get_keycode(bad_usb, line + offset, true);
+            }
+        }
+        ducky_bytecode_emit(compiler, DuckyOpKey, key, NULL, 0);
+        break;
+    }
+}
+
+static bool ducky_bytecode_compile(
+    BadUsbScript* bad_usb,
+    File* script_file,
+    File* file,
+    const char* path,
+    uint32_t layout_hash) {
+    if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        return false;
+    }
+
+    DuckyCompiler compiler = {
+        .bad_usb = bad_usb,
+        .file = file,
+    };
+    DuckyBytecodeHeader header = {
+        .magic = 0, // Written after successful compilation
+        .version = DUCKY_BYTECODE_VERSION,
+        // Compilation stops at a parse error, so the key covers the whole file from preload
+        .script_size = bad_usb->script_size,
+        .script_hash = bad_usb->script_hash,
+        .layout_hash = layout_hash,
+    };
+    ducky_bytecode_write(&compiler, &header, sizeof(header));
+
+    uint8_t* buf = malloc(DUCKY_COMPILE_BUFFER_LEN + 1);
+    FuriString* line = furi_string_alloc();
+    storage_file_seek(script_file, 0, true);
+
+    // Lines are split the same way as in ducky_script_execute_next()
+    bool file_end = false;
+    while(!file_end && !compiler.stop && !compiler.write_error) {
+        uint16_t len = storage_file_read(script_file, buf, DUCKY_COMPILE_BUFFER_LEN);
+        file_end = (len == 0) || storage_file_eof(script_file);
+        if(file_end) {
+            buf[len++] = '\n';
+        }
+
+        for(uint16_t i = 0; (i < len) && !compiler.stop; i++) {
+            if(buf[i] == '\n' && furi_string_size(line) > 0) {
+                compiler.line_cur++;
+                furi_string_trim(line);
+                ducky_bytecode_compile_line(&compiler, furi_string_get_cstr(line));
+                furi_string_reset(line);
+            } else {
+                furi_string_push_back(line, buf[i]);
+            }
+        }
+    }
+
+    furi_string_free(line);
+    free(buf);
+    storage_file_seek(script_file, 0, true);
+
+    bool success = !compiler.write_error;
+    if(success) {
+        header.magic = DUCKY_BYTECODE_MAGIC;
+        header.code_size = compiler.code_size;
+        success = storage_file_seek(file, 0, true) &&
+                  (storage_file_write(file, &header, sizeof(header)) == sizeof(header));
+    }
+    storage_file_close(file);
+
+    FURI_LOG_I(
+        WORKER_TAG,
+        "Bytecode %s: %lu lines, %lu bytes",
+        success ? "compiled" : "write error",
+        compiler.line_cur,
+        compiler.code_size);
+    return success;
+}
+
+static bool ducky_bytecode_check(
+    BadUsbScript* bad_usb,
+    File* file,
+    const char* path,
+    uint32_t layout_hash) {
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        return false;
+    }
+
+    DuckyBytecodeHeader header;
+    bool valid =
+        (storage_file_read(file, &header, sizeof(header)) == sizeof(header)) &&
+        (header.magic == DUCKY_BYTECODE_MAGIC) && (header.version == DUCKY_BYTECODE_VERSION) &&
+        (header.script_size == bad_usb->script_size) &&
+        (header.script_hash == bad_usb->script_hash) && (header.layout_hash == layout_hash) &&
+        (storage_file_size(file) == sizeof(header) + header.code_size);
+
+    if(valid) {
+        bad_usb->bytecode_end = sizeof(header) + header.code_size;
+    } else {
+        storage_file_close(file);
+    }
+    return valid;
+}
+
+bool ducky_bytecode_open(BadUsbScript* bad_usb, File* script_file) {
+    uint32_t layout_hash = ducky_hash(DUCKY_HASH_INIT, bad_usb->layout, sizeof(bad_usb->layout));
+
+    if(bad_usb->bytecode && (bad_usb->bytecode_layout_hash != layout_hash)) {
+        // Keyboard layout was changed, keycodes have to be resolved again
+        ducky_bytecode_close(bad_usb);
+    }
+
+    if(bad_usb->bytecode == NULL) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        File* file = storage_file_alloc(storage);
+        FuriString* path = furi_string_alloc_printf(
+            "%s%s", furi_string_get_cstr(bad_usb->file_path), DUCKY_BYTECODE_EXT);
+        const char* path_cstr = furi_string_get_cstr(path);
+
+        bool ready = ducky_bytecode_check(bad_usb, file, path_cstr, layout_hash);
+        if(!ready) {
+            if(ducky_bytecode_compile(bad_usb, script_file, file, path_cstr, layout_hash)) {
+                ready = ducky_bytecode_check(bad_usb, file, path_cstr, layout_hash);
+            } else {
+                storage_simply_remove(storage, path_cstr);
+            }
+        }
+        furi_string_free(path);
+
+        if(ready) {
+            bad_usb->bytecode = file;
+            bad_usb->bytecode_layout_hash = layout_hash;
+        } else {
+            FURI_LOG_W(WORKER_TAG, "Bytecode unavailable, running script text");
+            storage_file_free(file);
+            furi_record_close(RECORD_STORAGE);
+            return false;
+        }
+    }
+
+    bad_usb->bytecode_pos = sizeof(DuckyBytecodeHeader);
+    bad_usb->bytecode_prev = 0;
+    bad_usb->bytecode_string_pos = 0;
+    bad_usb->bytecode_string_end = 0;
+    bad_usb->bytecode_buf_offset = 0;
+    bad_usb->bytecode_buf_len = 0;
+    return true;
+}
+
+void ducky_bytecode_close(BadUsbScript* bad_usb) {
+    if(bad_usb->bytecode == NULL) return;
+
+    storage_file_free(bad_usb->bytecode);
+    furi_record_close(RECORD_STORAGE);
+    bad_usb->bytecode = NULL;
+}
+
+static bool ducky_bytecode_read(BadUsbScript* bad_usb, uint32_t offset, void* data, size_t size) {
+    uint8_t* out = data;
+
+    while(size > 0) {
+        if((offset < bad_usb->bytecode_buf_offset) ||
+           (offset >= bad_usb->bytecode_buf_offset + bad_usb->bytecode_buf_len)) {
+            if(!storage_file_seek(bad_usb->bytecode, offset, true)) return false;
+            bad_usb->bytecode_buf_offset = offset;
+            bad_usb->bytecode_buf_len = storage_file_read(
+                bad_usb->bytecode, bad_usb->bytecode_buf, DUCKY_BYTECODE_BUFFER_LEN);
+            if(bad_usb->bytecode_buf_len == 0) return false;
+        }
+
+        uint32_t pos = offset - bad_usb->bytecode_buf_offset;
+        size_t chunk = MIN(size, (size_t)(bad_usb->bytecode_buf_len - pos));
+        memcpy(out, &bad_usb->bytecode_buf[pos], chunk);
+        out += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+static bool ducky_bytecode_read_str(BadUsbScript* bad_usb, uint32_t offset, uint32_t size) {
+    furi_string_reset(bad_usb->line);
+
+    char chunk[32];
+    while(size > 0) {
+        uint32_t len = MIN(size, sizeof(chunk));
+        if(!ducky_bytecode_read(bad_usb, offset, chunk, len)) return false;
+        for(uint32_t i = 0; (i < len) && (chunk[i] != '\0'); i++) {
+            furi_string_push_back(bad_usb->line, chunk[i]);
+        }
+        offset += len;
+        size -= len;
+    }
+    return true;
+}
+
+static int32_t ducky_bytecode_read_error(BadUsbScript* bad_usb) {
+    return ducky_error(bad_usb, "Bytecode read error");
+}
+
+static int32_t ducky_bytecode_string(BadUsbScript* bad_usb) {
+    if(bad_usb->stringdelay != 0) {
+        // stringdelay is set - print in worker thread to keep handling external events
+        return SCRIPT_STATE_STRING_START;
+    }
+
+    uint16_t keycodes[16];
+    while(bad_usb->bytecode_string_pos < bad_usb->bytecode_string_end) {
+        uint32_t size = MIN(
+            sizeof(keycodes), bad_usb->bytecode_string_end - bad_usb->bytecode_string_pos);
+        if(!ducky_bytecode_read(bad_usb, bad_usb->bytecode_string_pos, keycodes, size)) {
+            return ducky_bytecode_read_error(bad_usb);
+        }
+        for(uint32_t i = 0; i < size / sizeof(uint16_t); i++) {
+            furi_hal_hid_kb_press(keycodes[i]);
+            furi_hal_hid_kb_release(keycodes[i]);
+        }
+        bad_usb->bytecode_string_pos += size;
+    }
+    return 0;
+}
+
+bool ducky_bytecode_string_next(BadUsbScript* bad_usb) {
+    if(bad_usb->bytecode_string_pos >= bad_usb->bytecode_string_end) {
+        return true;
+    }
+
+    uint16_t keycode = HID_KEYBOARD_NONE;
+    if(!ducky_bytecode_read(bad_usb, bad_usb->bytecode_string_pos, &keycode, sizeof(keycode))) {
+        return true;
+    }
+    furi_hal_hid_kb_press(keycode);
+    furi_hal_hid_kb_release(keycode);
+
+    bad_usb->bytecode_string_pos += sizeof(keycode);
+
+    return false;
+}
+
+static int32_t ducky_bytecode_execute(BadUsbScript* bad_usb, uint32_t offset, uint32_t* line) {
+    DuckyBytecodeInsn insn;
+    if(!ducky_bytecode_read(bad_usb, offset, &insn, sizeof(insn))) {
+        return ducky_bytecode_read_error(bad_usb);
+    }
+    *line = insn.line;
+    uint32_t payload = offset + sizeof(insn);
+
+    switch(insn.op) {
+    case DuckyOpBlank:
+        return SCRIPT_STATE_NEXT_LINE;
+    case DuckyOpNop:
+        return 0;
+    case DuckyOpKey:
+        furi_hal_hid_kb_press(insn.arg);
+        furi_hal_hid_kb_release(insn.arg);
+        return 0;
+    case DuckyOpDelay:
+        return (int32_t)insn.arg;
+    case DuckyOpDefDelay:
+        bad_usb->defdelay = insn.arg;
+        return 0;
+    case DuckyOpStringDelay:
+        bad_usb->stringdelay = insn.arg;
+        return 0;
+    case DuckyOpString:
+        bad_usb->bytecode_string_pos = payload;
+        bad_usb->bytecode_string_end = payload + ducky_bytecode_payload_size(&insn);
+        return ducky_bytecode_string(bad_usb);
+    case DuckyOpRepeat:
+        bad_usb->repeat_cnt = insn.arg;
+        return 0;
+    case DuckyOpSysrq:
+        furi_hal_hid_kb_press(KEY_MOD_LEFT_ALT | HID_KEYBOARD_PRINT_SCREEN);
+        furi_hal_hid_kb_press(insn.arg);
+        furi_hal_hid_kb_release_all();
+        return 0;
+    case DuckyOpAltChar:
+    case DuckyOpAltString:
+        if(!ducky_bytecode_read_str(bad_usb, payload, insn.arg)) {
+            return ducky_bytecode_read_error(bad_usb);
+        }
+        ducky_numlock_on();
+        if(insn.op == DuckyOpAltChar) {
+            if(!ducky_altchar(furi_string_get_cstr(bad_usb->line))) {
+                return ducky_error(
+                    bad_usb, "Invalid altchar %s", furi_string_get_cstr(bad_usb->line));
+            }
+        } else {
+            if(!ducky_altstring(furi_string_get_cstr(bad_usb->line))) {
+                return ducky_error(
+                    bad_usb, "Invalid altstring %s", furi_string_get_cstr(bad_usb->line));
+            }
+        }
+        return 0;
+    case DuckyOpHold:
+        bad_usb->key_hold_nb++;
+        if(bad_usb->key_hold_nb > (HID_KB_MAX_KEYS - 1)) {
+            return ducky_error(bad_usb, "Too many keys are hold");
+        }
+        furi_hal_hid_kb_press(insn.arg);
+        return 0;
+    case DuckyOpRelease:
+        if(bad_usb->key_hold_nb == 0) {
+            return ducky_error(bad_usb, "No keys are hold");
+        }
+        bad_usb->key_hold_nb--;
+        furi_hal_hid_kb_release(insn.arg);
+        return 0;
+    case DuckyOpWaitForButton:
+        return SCRIPT_STATE_WAIT_FOR_BTN;
+    case DuckyOpError:
+        if(!ducky_bytecode_read_str(bad_usb, payload, insn.arg)) {
+            return ducky_bytecode_read_error(bad_usb);
+        }
+        return ducky_error(bad_usb, "%s", furi_string_get_cstr(bad_usb->line));
+    default:
+        return ducky_error(bad_usb, "Invalid bytecode");
+    }
+}
+
+int32_t ducky_bytecode_execute_next(BadUsbScript* bad_usb) {
+    uint32_t offset = 0;
+
+    if(bad_usb->repeat_cnt > 0) {
+        bad_usb->repeat_cnt--;
+        offset = bad_usb->bytecode_prev;
+        if(offset == 0) return 0; // Nothing to repeat
+    } else {
+        if(bad_usb->bytecode_pos >= bad_usb->bytecode_end) return SCRIPT_STATE_END;
+
+        DuckyBytecodeInsn insn;
+        offset = bad_usb->bytecode_pos;
+        if(!ducky_bytecode_read(bad_usb, offset, &insn, sizeof(insn))) {
+            bad_usb->st.error_line = bad_usb->st.line_cur;
+            ducky_bytecode_read_error(bad_usb);
+            return SCRIPT_STATE_ERROR;
+        }
+        bad_usb->bytecode_pos += sizeof(insn) + ducky_bytecode_payload_size(&insn);
+        bad_usb->st.line_cur = insn.line;
+        if(insn.op != DuckyOpRepeat) {
+            // REPEAT repeats the last instruction that is not REPEAT itself
+            bad_usb->bytecode_prev = offset;
+        }
+    }
+
+    uint32_t line = bad_usb->st.line_cur;
+    int32_t delay_val = ducky_bytecode_execute(bad_usb, offset, &line);
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) { // Script error
+        bad_usb->st.error_line = line;
+        FURI_LOG_E(WORKER_TAG, "Error at line %lu", line);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return (delay_val + bad_usb->defdelay);
+    }
+}
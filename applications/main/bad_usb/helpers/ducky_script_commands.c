@@ -9,6 +9,7 @@ typedef struct {
     char* name;
     DuckyCmdCallback callback;
     int32_t param;
+    DuckyOpcode op;
 } DuckyCmd;
 
 static int32_t ducky_fnc_delay(BadUsbScript* bad_usb, const char* line, int32_t param) {
@@ -152,29 +153,29 @@ static int32_t ducky_fnc_waitforbutton(BadUsbScript* bad_usb, const char* line,
 }
 
 static const DuckyCmd ducky_commands[] = {
-    {"REM", NULL, -1},
-    {"ID", NULL, -1},
-    {"DELAY", ducky_fnc_delay, -1},
-    {"STRING", ducky_fnc_string, 0},
-    {"STRINGLN", ducky_fnc_string, 1},
-    {"DEFAULT_DELAY", ducky_fnc_defdelay, -1},
-    {"DEFAULTDELAY", ducky_fnc_defdelay, -1},
-    {"STRINGDELAY", ducky_fnc_strdelay, -1},
-    {"STRING_DELAY", ducky_fnc_strdelay, -1},
-    {"REPEAT", ducky_fnc_repeat, -1},
-    {"SYSRQ", ducky_fnc_sysrq, -1},
-    {"ALTCHAR", ducky_fnc_altchar, -1},
-    {"ALTSTRING", ducky_fnc_altstring, -1},
-    {"ALTCODE", ducky_fnc_altstring, -1},
-    {"HOLD", ducky_fnc_hold, -1},
-    {"RELEASE", ducky_fnc_release, -1},
-    {"WAIT_FOR_BUTTON_PRESS", ducky_fnc_waitforbutton, -1},
+    {"REM", NULL, -1, DuckyOpNop},
+    {"ID", NULL, -1, DuckyOpNop},
+    {"DELAY", ducky_fnc_delay, -1, DuckyOpDelay},
+    {"STRING", ducky_fnc_string, 0, DuckyOpString},
+    {"STRINGLN", ducky_fnc_string, 1, DuckyOpString},
+    {"DEFAULT_DELAY", ducky_fnc_defdelay, -1, DuckyOpDefDelay},
+    {"DEFAULTDELAY", ducky_fnc_defdelay, -1, DuckyOpDefDelay},
+    {"STRINGDELAY", ducky_fnc_strdelay, -1, DuckyOpStringDelay},
+    {"STRING_DELAY", ducky_fnc_strdelay, -1, DuckyOpStringDelay},
+    {"REPEAT", ducky_fnc_repeat, -1, DuckyOpRepeat},
+    {"SYSRQ", ducky_fnc_sysrq, -1, DuckyOpSysrq},
+    {"ALTCHAR", ducky_fnc_altchar, -1, DuckyOpAltChar},
+    {"ALTSTRING", ducky_fnc_altstring, -1, DuckyOpAltString},
+    {"ALTCODE", ducky_fnc_altstring, -1, DuckyOpAltString},
+    {"HOLD", ducky_fnc_hold, -1, DuckyOpHold},
+    {"RELEASE", ducky_fnc_release, -1, DuckyOpRelease},
+    {"WAIT_FOR_BUTTON_PRESS", ducky_fnc_waitforbutton, -1, DuckyOpWaitForButton},
 };
 
 #define TAG "BadUsb"
 #define WORKER_TAG TAG "Worker"
 
-int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+static const DuckyCmd* ducky_find_cmd(const char* line) {
     size_t cmd_word_len = strcspn(line, " ");
     for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
         size_t cmd_compare_len = strlen(ducky_commands[i].name);
@@ -184,13 +185,31 @@ int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
         }
 
         if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
-            if(ducky_commands[i].callback == NULL) {
-                return 0;
-            } else {
-                return ((ducky_commands[i].callback)(bad_usb, line, ducky_commands[i].param));
-            }
+            return &ducky_commands[i];
         }
     }
 
-    return SCRIPT_STATE_CMD_UNKNOWN;
+    return NULL;
+}
+
+int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line) {
+    const DuckyCmd* cmd = ducky_find_cmd(line);
+    if(cmd == NULL) {
+        return SCRIPT_STATE_CMD_UNKNOWN;
+    }
+
+    if(cmd->callback == NULL) {
+        return 0;
+    }
+    return ((cmd->callback)(bad_usb, line, cmd->param));
+}
+
+DuckyOpcode ducky_get_command_op(const char* line, int32_t* param) {
+    const DuckyCmd* cmd = ducky_find_cmd(line);
+    if(cmd == NULL) {
+        return DuckyOpKey;
+    }
+
+    *param = cmd->param;
+    return cmd->op;
 }
@@ -6,6 +6,7 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <storage/storage.h>
 #include "ducky_script.h"
 
 #define SCRIPT_STATE_ERROR (-1)
@@ -17,6 +18,32 @@ extern "C" {
 
 #define FILE_BUFFER_LEN 16
 
+#define DUCKY_BYTECODE_EXT ".bc"
+#define DUCKY_BYTECODE_BUFFER_LEN 256
+
+#define DUCKY_HASH_INIT 2166136261UL
+
+#define BADUSB_ASCII_TO_KEY(script, x) \
+    (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
+
+typedef enum {
+    DuckyOpBlank,
+    DuckyOpNop,
+    DuckyOpKey,
+    DuckyOpDelay,
+    DuckyOpDefDelay,
+    DuckyOpStringDelay,
+    DuckyOpString,
+    DuckyOpRepeat,
+    DuckyOpSysrq,
+    DuckyOpAltChar,
+    DuckyOpAltString,
+    DuckyOpHold,
+    DuckyOpRelease,
+    DuckyOpWaitForButton,
+    DuckyOpError,
+} DuckyOpcode;
+
 struct BadUsbScript {
     FuriHalUsbHidConfig hid_cfg;
     FuriThread* thread;
@@ -39,6 +66,20 @@ struct BadUsbScript {
 
     FuriString* string_print;
     size_t string_print_pos;
+
+    uint32_t script_size;
+    uint32_t script_hash;
+
+    File* bytecode;
+    uint32_t bytecode_layout_hash;
+    uint32_t bytecode_end;
+    uint32_t bytecode_pos;
+    uint32_t bytecode_prev;
+    uint32_t bytecode_string_pos;
+    uint32_t bytecode_string_end;
+    uint32_t bytecode_buf_offset;
+    uint16_t bytecode_buf_len;
+    uint8_t bytecode_buf[DUCKY_BYTECODE_BUFFER_LEN];
 };
 
 uint16_t ducky_get_keycode(BadUsbScript* bad_usb, const char* param, bool accept_chars);
@@ -63,6 +104,30 @@ bool ducky_string(BadUsbScript* bad_usb, const char* param);
 
 int32_t ducky_execute_cmd(BadUsbScript* bad_usb, const char* line);
 
+/**
+ * Get bytecode operation for a script line
+ * @param line Trimmed script line
+ * @param param Command parameter
+ * @return Command operation, DuckyOpKey if the line is not a command
+ */
+DuckyOpcode ducky_get_command_op(const char* line, int32_t* param);
+
+uint32_t ducky_hash(uint32_t hash, const void* data, size_t size);
+
+/**
+ * Open bytecode cache for the script, compile it if the cache is missing or stale
+ * @param bad_usb BadUsbScript instance
+ * @param script_file Opened script file
+ * @return true if the script will be executed from bytecode
+ */
+bool ducky_bytecode_open(BadUsbScript* bad_usb, File* script_file);
+
+void ducky_bytecode_close(BadUsbScript* bad_usb);
+
+int32_t ducky_bytecode_execute_next(BadUsbScript* bad_usb);
+
+bool ducky_bytecode_string_next(BadUsbScript* bad_usb);
+
 int32_t ducky_error(BadUsbScript* bad_usb, const char* text, ...);
 
 #ifdef __cplusplus
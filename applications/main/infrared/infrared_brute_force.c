@@ -1,16 +1,54 @@
 #include "infrared_brute_force.h"
 
 #include <stdlib.h>
+#include <m-array.h>
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/crc32_calc.h>
 
 #include "infrared_signal.h"
 
+#define INFRARED_BRUTE_FORCE_CACHE_EXTENSION ".idx"
+#define INFRARED_BRUTE_FORCE_CACHE_MAGIC (0x49524249UL)
+#define INFRARED_BRUTE_FORCE_CACHE_VERSION (2UL)
+
+/*
+ * The signal cache is stored next to the database and maps each signal name to the positions
+ * of its signals in the database, so that neither the start-up nor the transmission has to scan
+ * the whole file. Layout: header, name table (name length byte, name, entry), offset tables.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_crc;
+    uint32_t name_count;
+} InfraredBruteForceCacheHeader;
+
+typedef struct {
+    uint32_t count;
+    uint32_t position; /* Position of the offset table in the cache file */
+} InfraredBruteForceCacheEntry;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t offsets_position; /* Zero if the offsets are not cached */
 } InfraredBruteForceRecord;
 
+ARRAY_DEF(InfraredBruteForceOffsetArray, uint32_t, M_POD_OPLIST);
+#define M_OPL_InfraredBruteForceOffsetArray_t() \
+    ARRAY_OPLIST(InfraredBruteForceOffsetArray, M_POD_OPLIST)
+
+DICT_DEF2(
+    InfraredBruteForceOffsetDict,
+    FuriString*,
+    FURI_STRING_OPLIST,
+    InfraredBruteForceOffsetArray_t,
+    M_OPL_InfraredBruteForceOffsetArray_t());
+
 DICT_DEF2(
     InfraredBruteForceRecordDict,
     FuriString*,
@@ -23,6 +61,11 @@ struct InfraredBruteForce {
     const char* db_filename;
     FuriString* current_record_name;
     InfraredSignal* current_signal;
+    InfraredSignal* next_signal;
+    bool is_next_loaded;
+    uint32_t* offsets;
+    uint32_t offset_count;
+    uint32_t offset_index;
     InfraredBruteForceRecordDict_t records;
     bool is_started;
 };
@@ -32,6 +75,8 @@ InfraredBruteForce* infrared_brute_force_alloc() {
     brute_force->ff = NULL;
     brute_force->db_filename = NULL;
     brute_force->current_signal = NULL;
+    brute_force->next_signal = NULL;
+    brute_force->offsets = NULL;
     brute_force->is_started = false;
     brute_force->current_record_name = furi_string_alloc();
     InfraredBruteForceRecordDict_init(brute_force->records);
@@ -50,39 +95,251 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(!brute_force->is_started);
-    furi_assert(brute_force->db_filename);
+static FuriString* infrared_brute_force_get_cache_path(const InfraredBruteForce* brute_force) {
+    return furi_string_alloc_printf(
+        "%s%s", brute_force->db_filename, INFRARED_BRUTE_FORCE_CACHE_EXTENSION);
+}
+
+static bool infrared_brute_force_get_db_info(
+    const InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceCacheHeader* header) {
+    File* file = storage_file_alloc(storage);
+    const bool success =
+        storage_file_open(file, brute_force->db_filename, FSAM_READ, FSOM_OPEN_EXISTING);
+
+    if(success) {
+        header->magic = INFRARED_BRUTE_FORCE_CACHE_MAGIC;
+        header->version = INFRARED_BRUTE_FORCE_CACHE_VERSION;
+        header->db_size = storage_file_size(file);
+        header->db_crc = crc32_calc_file(file, NULL, NULL);
+        header->name_count = 0;
+    }
+
+    storage_file_free(file);
+    return success;
+}
+
+static bool infrared_brute_force_cache_load(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceCacheHeader* expected) {
+    FuriString* cache_path = infrared_brute_force_get_cache_path(brute_force);
+    FuriString* signal_name = furi_string_alloc();
+    Stream* stream = file_stream_alloc(storage);
     bool success = false;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+    do {
+        if(!file_stream_open(
+               stream, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        InfraredBruteForceCacheHeader header;
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != expected->magic || header.version != expected->version ||
+           header.db_size != expected->db_size || header.db_crc != expected->db_crc)
+            break;
+
+        uint32_t i;
+        for(i = 0; i < header.name_count; ++i) {
+            uint8_t length;
+            char name[UINT8_MAX + 1];
+            InfraredBruteForceCacheEntry entry;
+
+            if(stream_read(stream, &length, sizeof(length)) != sizeof(length)) break;
+            if(stream_read(stream, (uint8_t*)name, length) != length) break;
+            if(stream_read(stream, (uint8_t*)&entry, sizeof(entry)) != sizeof(entry)) break;
+
+            name[length] = '\0';
+            furi_string_set(signal_name, name);
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
+            if(record) {
+                record->count = entry.count;
+                record->offsets_position = entry.position;
+            }
+        }
+
+        success = (i == header.name_count);
+    } while(false);
+
+    stream_free(stream);
+    furi_string_free(signal_name);
+    furi_string_free(cache_path);
+    return success;
+}
+
+static bool infrared_brute_force_cache_save(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceCacheHeader* header,
+    InfraredBruteForceOffsetDict_t offsets) {
+    FuriString* cache_path = infrared_brute_force_get_cache_path(brute_force);
+    Stream* stream = file_stream_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!file_stream_open(
+               stream, furi_string_get_cstr(cache_path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        header->name_count = InfraredBruteForceOffsetDict_size(offsets);
+        if(stream_write(stream, (const uint8_t*)header, sizeof(*header)) != sizeof(*header))
+            break;
+
+        // Offset tables follow the name table
+        uint32_t position = sizeof(*header);
+        InfraredBruteForceOffsetDict_it_t it;
+        for(InfraredBruteForceOffsetDict_it(it, offsets); !InfraredBruteForceOffsetDict_end_p(it);
+            InfraredBruteForceOffsetDict_next(it)) {
+            const InfraredBruteForceOffsetDict_itref_t* item =
+                InfraredBruteForceOffsetDict_cref(it);
+            position += sizeof(uint8_t) + furi_string_size(item->key) +
+                        sizeof(InfraredBruteForceCacheEntry);
+        }
+
+        bool is_written = true;
+        for(InfraredBruteForceOffsetDict_it(it, offsets);
+            is_written && !InfraredBruteForceOffsetDict_end_p(it);
+            InfraredBruteForceOffsetDict_next(it)) {
+            const InfraredBruteForceOffsetDict_itref_t* item =
+                InfraredBruteForceOffsetDict_cref(it);
+            const uint8_t length = furi_string_size(item->key);
+            const InfraredBruteForceCacheEntry entry = {
+                .count = InfraredBruteForceOffsetArray_size(item->value),
+                .position = position,
+            };
+            position += entry.count * sizeof(uint32_t);
+
+            is_written =
+                (stream_write(stream, &length, sizeof(length)) == sizeof(length)) &&
+                (stream_write(stream, (const uint8_t*)furi_string_get_cstr(item->key), length) ==
+                 length) &&
+                (stream_write(stream, (const uint8_t*)&entry, sizeof(entry)) == sizeof(entry));
+        }
+
+        for(InfraredBruteForceOffsetDict_it(it, offsets);
+            is_written && !InfraredBruteForceOffsetDict_end_p(it);
+            InfraredBruteForceOffsetDict_next(it)) {
+            const InfraredBruteForceOffsetDict_itref_t* item =
+                InfraredBruteForceOffsetDict_cref(it);
+            const size_t size = InfraredBruteForceOffsetArray_size(item->value) * sizeof(uint32_t);
+            is_written = stream_write(
+                             stream,
+                             (const uint8_t*)InfraredBruteForceOffsetArray_cget(item->value, 0),
+                             size) == size;
+        }
+
+        success = is_written;
+    } while(false);
+
+    stream_free(stream);
+    if(!success) {
+        storage_simply_remove(storage, furi_string_get_cstr(cache_path));
+    }
+
+    furi_string_free(cache_path);
+    return success;
+}
+
+static bool infrared_brute_force_cache_build(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceCacheHeader* header) {
+    InfraredBruteForceOffsetDict_t offsets;
+    InfraredBruteForceOffsetDict_init(offsets);
+
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    const bool success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
 
-    success = flipper_format_buffered_file_open_existing(ff, brute_force->db_filename);
     if(success) {
-        FuriString* signal_name;
-        signal_name = furi_string_alloc();
-        while(flipper_format_read_string(ff, "name", signal_name)) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        FuriString* signal_name = furi_string_alloc();
+
+        while(infrared_signal_read_name(ff, signal_name)) {
             InfraredBruteForceRecord* record =
                 InfraredBruteForceRecordDict_get(brute_force->records, signal_name);
             if(record) { //-V547
                 ++(record->count);
             }
+            // Names that do not fit into the cache are left to the plain search
+            if(furi_string_size(signal_name) <= UINT8_MAX) {
+                InfraredBruteForceOffsetArray_push_back(
+                    *InfraredBruteForceOffsetDict_safe_get(offsets, signal_name),
+                    stream_tell(stream));
+            }
         }
+
         furi_string_free(signal_name);
     }
 
     flipper_format_free(ff);
+
+    // Records are pointed at the cache only if it was written successfully
+    if(success && infrared_brute_force_cache_save(brute_force, storage, header, offsets)) {
+        infrared_brute_force_cache_load(brute_force, storage, header);
+    }
+
+    InfraredBruteForceOffsetDict_clear(offsets);
+    return success;
+}
+
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(!brute_force->is_started);
+    furi_assert(brute_force->db_filename);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredBruteForceCacheHeader header;
+    bool success = infrared_brute_force_get_db_info(brute_force, storage, &header);
+
+    if(success && !infrared_brute_force_cache_load(brute_force, storage, &header)) {
+        // Cache may have been read partially
+        InfraredBruteForceRecordDict_it_t it;
+        for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+            !InfraredBruteForceRecordDict_end_p(it);
+            InfraredBruteForceRecordDict_next(it)) {
+            InfraredBruteForceRecordDict_itref_t* record = InfraredBruteForceRecordDict_ref(it);
+            record->value.count = 0;
+            record->value.offsets_position = 0;
+        }
+        success = infrared_brute_force_cache_build(brute_force, storage, &header);
+    }
+
     furi_record_close(RECORD_STORAGE);
     return success;
 }
 
+static void infrared_brute_force_load_offsets(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    uint32_t position,
+    uint32_t count) {
+    FuriString* cache_path = infrared_brute_force_get_cache_path(brute_force);
+    Stream* stream = file_stream_alloc(storage);
+    const size_t size = count * sizeof(uint32_t);
+    uint32_t* offsets = malloc(size);
+
+    if(file_stream_open(stream, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+       stream_seek(stream, position, StreamOffsetFromStart) &&
+       stream_read(stream, (uint8_t*)offsets, size) == size) {
+        brute_force->offsets = offsets;
+        brute_force->offset_count = count;
+        brute_force->offset_index = 0;
+    } else {
+        free(offsets);
+    }
+
+    stream_free(stream);
+    furi_string_free(cache_path);
+}
+
 bool infrared_brute_force_start(
     InfraredBruteForce* brute_force,
     uint32_t index,
     uint32_t* record_count) {
     furi_assert(!brute_force->is_started);
     bool success = false;
+    uint32_t offsets_position = 0;
     *record_count = 0;
 
     InfraredBruteForceRecordDict_it_t it;
@@ -94,6 +351,7 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 furi_string_set(brute_force->current_record_name, record->key);
+                offsets_position = record->value.offsets_position;
             }
             break;
         }
@@ -103,7 +361,14 @@ bool infrared_brute_force_start(
         Storage* storage = furi_record_open(RECORD_STORAGE);
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
         brute_force->current_signal = infrared_signal_alloc();
+        brute_force->next_signal = infrared_signal_alloc();
+        brute_force->is_next_loaded = false;
         brute_force->is_started = true;
+        if(offsets_position) {
+            // Without the offsets the signals are searched for by name
+            infrared_brute_force_load_offsets(
+                brute_force, storage, offsets_position, *record_count);
+        }
         success =
             flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
         if(!success) infrared_brute_force_stop(brute_force);
@@ -119,30 +384,54 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
     furi_string_reset(brute_force->current_record_name);
     infrared_signal_free(brute_force->current_signal);
+    infrared_signal_free(brute_force->next_signal);
     flipper_format_free(brute_force->ff);
+    free(brute_force->offsets);
     brute_force->current_signal = NULL;
+    brute_force->next_signal = NULL;
+    brute_force->offsets = NULL;
     brute_force->ff = NULL;
     brute_force->is_started = false;
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool infrared_brute_force_load_next(InfraredBruteForce* brute_force) {
+    if(!brute_force->offsets) {
+        return infrared_signal_search_and_read(
+            brute_force->next_signal,
+            brute_force->ff,
+            furi_string_get_cstr(brute_force->current_record_name));
+    } else if(brute_force->offset_index < brute_force->offset_count) {
+        Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
+        const uint32_t offset = brute_force->offsets[brute_force->offset_index++];
+        return stream_seek(stream, offset, StreamOffsetFromStart) &&
+               infrared_signal_read_body(brute_force->next_signal, brute_force->ff);
+    } else {
+        return false;
+    }
+}
+
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     furi_assert(brute_force->is_started);
-    const bool success = infrared_signal_search_and_read(
-        brute_force->current_signal,
-        brute_force->ff,
-        furi_string_get_cstr(brute_force->current_record_name));
-    if(success) {
-        infrared_signal_transmit(brute_force->current_signal);
+
+    // Except for the first call, the signal was loaded during the previous transmission
+    if(!brute_force->is_next_loaded && !infrared_brute_force_load_next(brute_force)) {
+        return false;
     }
-    return success;
+
+    FURI_SWAP(brute_force->current_signal, brute_force->next_signal);
+    infrared_signal_transmit_start(brute_force->current_signal);
+    brute_force->is_next_loaded = infrared_brute_force_load_next(brute_force);
+    infrared_signal_transmit_wait();
+
+    return true;
 }
 
 void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .offsets_position = 0};
     FuriString* key;
     key = furi_string_alloc_set(name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
@@ -149,7 +149,7 @@ static inline bool infrared_signal_read_raw(InfraredSignal* signal, FlipperForma
     return success;
 }
 
-static bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
     FuriString* tmp = furi_string_alloc();
 
     bool success = false;
@@ -299,10 +299,10 @@ bool infrared_signal_search_and_read(InfraredSignal* signal, FlipperFormat* ff,
     return success;
 }
 
-void infrared_signal_transmit(const InfraredSignal* signal) {
+void infrared_signal_transmit_start(const InfraredSignal* signal) {
     if(signal->is_raw) {
         const InfraredRawSignal* raw_signal = &signal->payload.raw;
-        infrared_send_raw_ext(
+        infrared_send_raw_ext_start(
             raw_signal->timings,
             raw_signal->timings_size,
             true,
@@ -310,6 +310,15 @@ void infrared_signal_transmit(const InfraredSignal* signal) {
             raw_signal->duty_cycle);
     } else {
         const InfraredMessage* message = &signal->payload.message;
-        infrared_send(message, 1);
+        infrared_send_start(message, 1);
     }
 }
+
+void infrared_signal_transmit_wait() {
+    infrared_send_wait();
+}
+
+void infrared_signal_transmit(const InfraredSignal* signal) {
+    infrared_signal_transmit_start(signal);
+    infrared_signal_transmit_wait();
+}
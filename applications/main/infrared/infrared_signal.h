@@ -151,6 +151,18 @@ bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, FuriString*
  */
 bool infrared_signal_read_name(FlipperFormat* ff, FuriString* name);
 
+/**
+ * @brief Read a signal body (everything after the name) from a FlipperFormat file.
+ *
+ * The file must be positioned right after the name of the signal to be read, e.g. by seeking
+ * its raw stream to a previously remembered offset.
+ *
+ * @param[in,out] signal pointer to the instance to be read into.
+ * @param[in,out] ff pointer to the FlipperFormat file instance to read from.
+ * @returns true if a signal was successfully read, false otherwise.
+ */
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff);
+
 /**
  * @brief Read a signal with a particular name from a FlipperFormat file into an InfraredSignal instance.
  *
@@ -184,3 +196,19 @@ bool infrared_signal_save(const InfraredSignal* signal, FlipperFormat* ff, const
  * @param[in] signal pointer to the instance holding the signal to be transmitted.
  */
 void infrared_signal_transmit(const InfraredSignal* signal);
+
+/**
+ * @brief Start transmitting a signal contained in an InfraredSignal instance.
+ *
+ * Unlike infrared_signal_transmit(), this function returns immediately, so that
+ * the caller can do other work while the signal is being sent. The instance must
+ * not be modified or freed until infrared_signal_transmit_wait() returns.
+ *
+ * @param[in] signal pointer to the instance holding the signal to be transmitted.
+ */
+void infrared_signal_transmit_start(const InfraredSignal* signal);
+
+/**
+ * @brief Wait for the transmission started by infrared_signal_transmit_start() to finish.
+ */
+void infrared_signal_transmit_wait();
@@ -76,6 +76,10 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(Nfc* nfc, DictAttackSt
         mf_classic_dict_free(dict_attack_data->dict);
     }
     dict_attack_data->dict = dict;
+    // System dictionary is large, go through it once trying each key on all sectors
+    dict_attack_data->mode = (state == DictAttackStateFlipperDictInProgress) ?
+                                 NfcMfClassicDictAttackModeKey :
+                                 NfcMfClassicDictAttackModeSector;
     scene_manager_set_scene_state(nfc->scene_manager, NfcSceneMfClassicDictAttack, state);
     dict_attack_set_callback(nfc->dict_attack, nfc_dict_attack_dict_attack_result_callback, nfc);
     dict_attack_set_current_sector(nfc->dict_attack, 0);
@@ -139,8 +143,15 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
             dict_attack_inc_keys_found(nfc->dict_attack);
             consumed = true;
         } else if(event.event == NfcWorkerEventNewSector) {
+            NfcMfClassicDictAttackData* dict_attack_data =
+                &nfc->dev->dev_data.mf_classic_dict_attack_data;
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
-            dict_attack_inc_current_sector(nfc->dict_attack);
+            if(dict_attack_data->mode == NfcMfClassicDictAttackModeKey) {
+                dict_attack_set_attacked_sector(
+                    nfc->dict_attack, dict_attack_data->current_sector);
+            } else {
+                dict_attack_inc_current_sector(nfc->dict_attack);
+            }
             consumed = true;
         } else if(event.event == NfcWorkerEventNewDictKeyBatch) {
             nfc_scene_mf_classic_dict_attack_update_view(nfc);
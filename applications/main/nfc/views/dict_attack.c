@@ -214,6 +214,13 @@ void dict_attack_set_current_sector(DictAttack* dict_attack, uint8_t curr_sec) {
         true);
 }
 
+void dict_attack_set_attacked_sector(DictAttack* dict_attack, uint8_t sector) {
+    furi_assert(dict_attack);
+    // Dictionary progress is kept, it is not tied to a sector
+    with_view_model(
+        dict_attack->view, DictAttackViewModel * model, { model->sector_current = sector; }, true);
+}
+
 void dict_attack_inc_current_sector(DictAttack* dict_attack) {
     furi_assert(dict_attack);
     with_view_model(
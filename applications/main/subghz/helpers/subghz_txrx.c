@@ -54,8 +54,8 @@ SubGhzTxRx* subghz_txrx_alloc() {
 
     subghz_worker_set_overrun_callback(
         instance->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-    subghz_worker_set_pair_callback(
-        instance->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
+    subghz_worker_set_pair_batch_callback(
+        instance->worker, (SubGhzWorkerPairBatchCallback)subghz_receiver_decode_batch);
     subghz_worker_set_context(instance->worker, instance->receiver);
 
     //set default device External
@@ -568,6 +568,16 @@ void subghz_txrx_set_raw_file_encoder_worker_callback_end(
         context);
 }
 
+uint32_t subghz_txrx_get_raw_file_encoder_worker_underrun_count(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    // Transmitter is freed once TX is stopped
+    if(instance->txrx_state != SubGhzTxRxStateTx) return 0;
+
+    SubGhzProtocolEncoderRAW* encoder =
+        subghz_transmitter_get_protocol_instance(instance->transmitter);
+    return subghz_protocol_raw_file_encoder_worker_get_underrun_count(encoder);
+}
+
 bool subghz_txrx_radio_device_is_external_connected(SubGhzTxRx* instance, const char* name) {
     furi_assert(instance);
 
@@ -291,6 +291,14 @@ void subghz_txrx_set_raw_file_encoder_worker_callback_end(
     SubGhzProtocolEncoderRAWCallbackEnd callback,
     void* context);
 
+/**
+ * Get the number of times Raw file transfer did not keep up with the radio
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @return uint32_t underrun count, 0 if not transmitting
+ */
+uint32_t subghz_txrx_get_raw_file_encoder_worker_underrun_count(SubGhzTxRx* instance);
+
 /* Checking if an external radio device is connected
 * 
 * @param instance Pointer to a SubGhzTxRx
@@ -41,36 +41,41 @@ void subghz_scene_decode_raw_callback(SubGhzCustomEvent event, void* context) {
     view_dispatcher_send_custom_event(subghz->view_dispatcher, event);
 }
 
+static void subghz_scene_decode_raw_item_callback(
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time,
+    void* context) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    // Item may be already deleted from the history
+    if(idx < subghz_history_get_item(subghz->history)) {
+        subghz_history_get_text_item_menu(subghz->history, name, idx);
+        subghz_history_get_time_item_menu(subghz->history, time, idx);
+    } else {
+        furi_string_reset(name);
+        furi_string_reset(time);
+    }
+}
+
 static void subghz_scene_add_to_history_callback(
     SubGhzReceiver* receiver,
     SubGhzProtocolDecoderBase* decoder_base,
     void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
     uint16_t idx = subghz_history_get_item(subghz->history);
     SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
 
     if(subghz_history_add_to_history(subghz->history, decoder_base, &preset)) {
-        furi_string_reset(item_name);
-        furi_string_reset(item_time);
-
         subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-        subghz_history_get_text_item_menu(subghz->history, item_name, idx);
-        subghz_history_get_time_item_menu(subghz->history, item_time, idx);
         subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(item_name),
-            furi_string_get_cstr(item_time),
-            subghz_history_get_type_protocol(subghz->history, idx));
+            subghz->subghz_receiver, subghz_history_get_type_protocol(subghz->history, idx));
 
         subghz_scene_receiver_update_statusbar(subghz);
     }
     subghz_receiver_reset(receiver);
-    furi_string_free(item_name);
-    furi_string_free(item_time);
 }
 
 bool subghz_scene_decode_raw_start(SubGhz* subghz) {
@@ -150,12 +155,11 @@ bool subghz_scene_decode_raw_next(SubGhz* subghz) {
 void subghz_scene_decode_raw_on_enter(void* context) {
     SubGhz* subghz = context;
 
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-
     subghz_view_receiver_set_mode(subghz->subghz_receiver, SubGhzViewReceiverModeFile);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_decode_raw_callback, subghz);
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver, subghz_scene_decode_raw_item_callback, subghz);
 
     subghz_txrx_set_rx_callback(subghz->txrx, subghz_scene_add_to_history_callback, subghz);
 
@@ -174,22 +178,12 @@ void subghz_scene_decode_raw_on_enter(void* context) {
         //Load history to receiver
         subghz_view_receiver_exit(subghz->subghz_receiver);
         for(uint16_t i = 0; i < subghz_history_get_item(subghz->history); i++) {
-            furi_string_reset(item_name);
-            furi_string_reset(item_time);
-            subghz_history_get_text_item_menu(subghz->history, item_name, i);
-            subghz_history_get_time_item_menu(subghz->history, item_time, i);
             subghz_view_receiver_add_item_to_menu(
-                subghz->subghz_receiver,
-                furi_string_get_cstr(item_name),
-                furi_string_get_cstr(item_time),
-                subghz_history_get_type_protocol(subghz->history, i));
+                subghz->subghz_receiver, subghz_history_get_type_protocol(subghz->history, i));
         }
         subghz_view_receiver_set_idx_menu(subghz->subghz_receiver, subghz->idx_menu_chosen);
     }
 
-    furi_string_free(item_name);
-    furi_string_free(item_time);
-
     subghz_scene_receiver_update_statusbar(subghz);
 
     view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdReceiver);
@@ -256,6 +250,8 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
         default:
             break;
         }
+
+        subghz_history_flush(subghz->history);
     }
     return consumed;
 }
@@ -97,6 +97,23 @@ void subghz_scene_receiver_callback(SubGhzCustomEvent event, void* context) {
     view_dispatcher_send_custom_event(subghz->view_dispatcher, event);
 }
 
+static void subghz_scene_receiver_item_callback(
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time,
+    void* context) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    // Item may be already deleted from the history
+    if(idx < subghz_history_get_item(subghz->history)) {
+        subghz_history_get_text_item_menu(subghz->history, name, idx);
+        subghz_history_get_time_item_menu(subghz->history, time, idx);
+    } else {
+        furi_string_reset(name);
+        furi_string_reset(time);
+    }
+}
+
 static void subghz_scene_add_to_history_callback(
     SubGhzReceiver* receiver,
     SubGhzProtocolDecoderBase* decoder_base,
@@ -107,24 +124,14 @@ static void subghz_scene_add_to_history_callback(
     // The check can be moved to /lib/subghz/receiver.c, but may result in false positives
     if((decoder_base->protocol->flag & subghz->ignore_filter) == 0) {
         SubGhzHistory* history = subghz->history;
-        FuriString* item_name = furi_string_alloc();
-        FuriString* item_time = furi_string_alloc();
         uint16_t idx = subghz_history_get_item(history);
 
         SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
         if(subghz_history_add_to_history(history, decoder_base, &preset)) {
-            furi_string_reset(item_name);
-            furi_string_reset(item_time);
-
             subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-            subghz_history_get_text_item_menu(history, item_name, idx);
-            subghz_history_get_time_item_menu(history, item_time, idx);
             subghz_view_receiver_add_item_to_menu(
-                subghz->subghz_receiver,
-                furi_string_get_cstr(item_name),
-                furi_string_get_cstr(item_time),
-                subghz_history_get_type_protocol(history, idx));
+                subghz->subghz_receiver, subghz_history_get_type_protocol(history, idx));
 
             subghz_scene_receiver_update_statusbar(subghz);
             if(subghz_history_get_text_space_left(subghz->history, NULL)) {
@@ -132,8 +139,6 @@ static void subghz_scene_add_to_history_callback(
             }
         }
         subghz_receiver_reset(receiver);
-        furi_string_free(item_name);
-        furi_string_free(item_time);
         subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
     } else {
         FURI_LOG_I(TAG, "%s protocol ignored", decoder_base->protocol->name);
@@ -144,9 +149,6 @@ void subghz_scene_receiver_on_enter(void* context) {
     SubGhz* subghz = context;
     SubGhzHistory* history = subghz->history;
 
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-
     if(subghz_rx_key_state_get(subghz) == SubGhzRxKeyStateIDLE) {
 #if SUBGHZ_LAST_SETTING_SAVE_PRESET
         subghz_txrx_set_preset_internal(
@@ -170,21 +172,14 @@ void subghz_scene_receiver_on_enter(void* context) {
     // Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
     for(uint16_t i = 0; i < subghz_history_get_item(history); i++) {
-        furi_string_reset(item_name);
-        furi_string_reset(item_time);
-        subghz_history_get_text_item_menu(history, item_name, i);
-        subghz_history_get_time_item_menu(history, item_time, i);
         subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(item_name),
-            furi_string_get_cstr(item_time),
-            subghz_history_get_type_protocol(history, i));
+            subghz->subghz_receiver, subghz_history_get_type_protocol(history, i));
         subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
     }
-    furi_string_free(item_name);
-    furi_string_free(item_time);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_receiver_callback, subghz);
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver, subghz_scene_receiver_item_callback, subghz);
     subghz_txrx_set_rx_callback(subghz->txrx, subghz_scene_add_to_history_callback, subghz);
 
     if(!subghz_history_get_text_space_left(subghz->history, NULL)) {
@@ -304,6 +299,8 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         default:
             break;
         }
+
+        subghz_history_flush(subghz->history);
     }
     return consumed;
 }
@@ -17,6 +17,7 @@ enum SubGhzSettingIndex {
     SubGhzSettingIndexResetToDefault,
     SubGhzSettingIndexLock,
     SubGhzSettingIndexRAWThresholdRSSI,
+    SubGhzSettingIndexRAWFormat,
 };
 
 #define RAW_THRESHOLD_RSSI_COUNT 11
@@ -65,6 +66,11 @@ const uint32_t bin_raw_value[COMBO_BOX_COUNT] = {
     SubGhzProtocolFlag_Decodable | SubGhzProtocolFlag_BinRAW,
 };
 
+const char* const raw_format_text[COMBO_BOX_COUNT] = {
+    "Text",
+    "Packed",
+};
+
 const char* const combobox_text[COMBO_BOX_COUNT] = {
     "OFF",
     "ON",
@@ -257,6 +263,14 @@ static void subghz_scene_receiver_config_set_raw_threshold_rssi(VariableItem* it
     subghz->last_settings->rssi = raw_threshold_rssi_value[index];
 }
 
+static void subghz_scene_receiver_config_set_raw_format(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, raw_format_text[index]);
+    subghz->last_settings->raw_packed = index;
+}
+
 static inline bool subghz_scene_receiver_config_ignore_filter_get_index(
     SubGhzProtocolFlag filter,
     SubGhzProtocolFlag flag) {
@@ -509,6 +523,16 @@ void subghz_scene_receiver_config_on_enter(void* context) {
             RAW_THRESHOLD_RSSI_COUNT);
         variable_item_set_current_value_index(item, value_index);
         variable_item_set_current_value_text(item, raw_threshold_rssi_text[value_index]);
+
+        item = variable_item_list_add(
+            subghz->variable_item_list,
+            "RAW Format:",
+            COMBO_BOX_COUNT,
+            subghz_scene_receiver_config_set_raw_format,
+            subghz);
+        value_index = subghz->last_settings->raw_packed ? 1 : 0;
+        variable_item_set_current_value_index(item, value_index);
+        variable_item_set_current_value_text(item, raw_format_text[value_index]);
     }
     view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdVariableItemList);
 }
@@ -24,13 +24,14 @@ void subghz_scene_receiver_info_callback(GuiButtonType result, InputType type, v
 static bool subghz_scene_receiver_info_update_parser(void* context) {
     SubGhz* subghz = context;
 
-    if(subghz_txrx_load_decoder_by_name_protocol(
+    FlipperFormat* raw_data =
+        subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen);
+    if(raw_data &&
+       subghz_txrx_load_decoder_by_name_protocol(
            subghz->txrx,
            subghz_history_get_protocol_name(subghz->history, subghz->idx_menu_chosen))) {
         // we are trying to deserialize without checking for errors, since it is assumed that we just received this chignal
-        subghz_protocol_decoder_base_deserialize(
-            subghz_txrx_get_decoder(subghz->txrx),
-            subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen));
+        subghz_protocol_decoder_base_deserialize(subghz_txrx_get_decoder(subghz->txrx), raw_data);
 
         SubGhzRadioPreset* preset =
             subghz_history_get_radio_preset(subghz->history, subghz->idx_menu_chosen);
@@ -1,179 +1,414 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
+#include <storage/storage.h>
 
 #include <furi.h>
 
 #define SUBGHZ_HISTORY_MAX 55
+#define SUBGHZ_HISTORY_MAX_SPILL 512
 #define SUBGHZ_HISTORY_FREE_HEAP 20480
+#define SUBGHZ_HISTORY_SPILL_PATH APP_DATA_PATH("history.tmp")
+// Serialized signals are kept in RAM until this much is collected
+#define SUBGHZ_HISTORY_SPILL_THRESHOLD 2048
+#define SUBGHZ_HISTORY_RECENT_COUNT 16
+#define SUBGHZ_HISTORY_RECENT_TIMEOUT 500
+#define SUBGHZ_HISTORY_INDEX_NONE 0xFF
 #define TAG "SubGhzHistory"
 
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-    FuriHalRtcDateTime datetime;
+    uint64_t key;
+    const SubGhzProtocol* protocol;
+    uint32_t frequency;
+    // Position of the serialized signal in the spill file followed by the RAM tail
+    uint32_t data_offset;
+    uint16_t data_size;
+    uint16_t bit_count;
+    uint8_t preset_index;
+    uint8_t manufacture_index;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzRadioPreset, M_POD_OPLIST)
+
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
+
+ARRAY_DEF(SubGhzHistoryNameArray, FuriString*, M_PTR_OPLIST)
+
+#define M_OPL_SubGhzHistoryNameArray_t() ARRAY_OPLIST(SubGhzHistoryNameArray, M_PTR_OPLIST)
+
 typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+    uint32_t hash;
+    uint32_t timestamp;
+} SubGhzHistoryRecent;
 
 struct SubGhzHistory {
-    uint32_t last_update_timestamp;
-    uint16_t last_index_write;
-    uint8_t code_last_hash_data;
+    FuriMutex* mutex;
+    SubGhzHistoryItemArray_t items;
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzHistoryNameArray_t manufactures;
+    SubGhzHistoryRecent recent[SUBGHZ_HISTORY_RECENT_COUNT];
+
+    Storage* storage;
+    Stream* spill;
+    // Spill file is created on the first flush, disabled if that fails
+    bool spill_enabled;
+    bool spill_opened;
+    // Bytes moved to the spill file, the RAM tail continues from here
+    size_t spill_size;
+    Stream* tail;
+
+    // Scratch for the worker thread
+    FlipperFormat* add_data;
+    // Returned by subghz_history_get_raw_data
+    FlipperFormat* raw_data;
+    SubGhzRadioPreset preset;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
 };
 
+static bool subghz_history_spill_open(SubGhzHistory* instance) {
+    if(!instance->spill_opened) {
+        instance->spill_opened = file_stream_open(
+            instance->spill, SUBGHZ_HISTORY_SPILL_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+        if(!instance->spill_opened) {
+            FURI_LOG_W(TAG, "No spill file, history is kept in RAM");
+            file_stream_close(instance->spill);
+            instance->spill_enabled = false;
+        }
+    }
+    return instance->spill_opened;
+}
+
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->spill_opened) {
+        file_stream_close(instance->spill);
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_SPILL_PATH);
+        instance->spill_opened = false;
+    }
+    instance->spill_enabled = true;
+    instance->spill_size = 0;
+}
+
+static void subghz_history_spill_flush(SubGhzHistory* instance) {
+    size_t size = stream_size(instance->tail);
+    if(!instance->spill_enabled || size < SUBGHZ_HISTORY_SPILL_THRESHOLD) return;
+    if(!subghz_history_spill_open(instance)) return;
+
+    stream_rewind(instance->tail);
+    if(!stream_seek(instance->spill, 0, StreamOffsetFromEnd) ||
+       stream_copy(instance->tail, instance->spill, size) != size) {
+        // Partially written data is never read, offsets of the tail stay valid
+        FURI_LOG_E(TAG, "Spill write error");
+        instance->spill_enabled = false;
+        stream_seek(instance->tail, 0, StreamOffsetFromEnd);
+        return;
+    }
+    instance->spill_size += size;
+    stream_clean(instance->tail);
+}
+
+static void subghz_history_clear(SubGhzHistory* instance) {
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->presets);
+    for
+        M_EACH(name, instance->manufactures, SubGhzHistoryNameArray_t) {
+            furi_string_free(*name);
+        }
+    SubGhzHistoryNameArray_reset(instance->manufactures);
+    SubGhzHistoryItemArray_reset(instance->items);
+    memset(instance->recent, 0, sizeof(instance->recent));
+    stream_clean(instance->tail);
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    SubGhzHistoryItemArray_init(instance->items);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    SubGhzHistoryNameArray_init(instance->manufactures);
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->spill = file_stream_alloc(instance->storage);
+    instance->tail = string_stream_alloc();
+    instance->spill_enabled = true;
+
+    instance->add_data = flipper_format_string_alloc();
+    instance->raw_data = flipper_format_string_alloc();
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_clear(instance);
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    SubGhzHistoryNameArray_clear(instance->manufactures);
+    SubGhzHistoryItemArray_clear(instance->items);
+
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    flipper_format_free(instance->raw_data);
+    flipper_format_free(instance->add_data);
+
+    subghz_history_spill_close(instance);
+    stream_free(instance->tail);
+    stream_free(instance->spill);
+    furi_record_close(RECORD_STORAGE);
+
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint32_t frequency = SubGhzHistoryItemArray_get(instance->items, idx)->frequency;
+    furi_mutex_release(instance->mutex);
+    return frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    instance->preset = *SubGhzHistoryPresetArray_get(instance->presets, item->preset_index);
+    instance->preset.frequency = item->frequency;
+    furi_mutex_release(instance->mutex);
+    return &instance->preset;
 }
 
-const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
+void subghz_history_get_preset(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    SubGhzRadioPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->presets, item->preset_index);
+    furi_string_set(output, preset->name);
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
-    furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_clear(instance);
+    subghz_history_spill_close(instance);
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t item_id) {
     furi_assert(instance);
-
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    // Serialized data stays in the append-only spill file
     SubGhzHistoryItemArray_it_t it;
-    //SubGhzHistoryItem* target_item = SubGhzHistoryItemArray_get(instance->history->data, item_id);
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
+    SubGhzHistoryItemArray_it_last(it, instance->items);
     while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_ref(it);
-
         if(it->index == (size_t)(item_id)) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-            SubGhzHistoryItemArray_remove(instance->history->data, it);
+            SubGhzHistoryItemArray_remove(instance->items, it);
         }
         SubGhzHistoryItemArray_previous(it);
     }
-    instance->last_index_write--;
+    furi_mutex_release(instance->mutex);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
     furi_assert(instance);
-    return instance->last_index_write;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t count = SubGhzHistoryItemArray_size(instance->items);
+    furi_mutex_release(instance->mutex);
+    return count;
 }
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint8_t type = SubGhzHistoryItemArray_get(instance->items, idx)->protocol->type;
+    furi_mutex_release(instance->mutex);
+    return type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
-        FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
-    }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const char* name = SubGhzHistoryItemArray_get(instance->items, idx)->protocol->name;
+    furi_mutex_release(instance->mutex);
+    return name;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+    stream_clean(stream);
+
+    bool loaded = false;
+    if(item->data_offset >= instance->spill_size) {
+        loaded = stream_seek(
+                     instance->tail,
+                     item->data_offset - instance->spill_size,
+                     StreamOffsetFromStart) &&
+                 stream_copy(instance->tail, stream, item->data_size) == item->data_size;
+        stream_seek(instance->tail, 0, StreamOffsetFromEnd);
     } else {
+        loaded = stream_seek(instance->spill, item->data_offset, StreamOffsetFromStart) &&
+                 stream_copy(instance->spill, stream, item->data_size) == item->data_size;
+    }
+    furi_mutex_release(instance->mutex);
+
+    if(!loaded) {
+        FURI_LOG_E(TAG, "Load error");
         return NULL;
     }
+    flipper_format_rewind(instance->raw_data);
+    return instance->raw_data;
 }
+
+static uint16_t subghz_history_get_limit(SubGhzHistory* instance) {
+    return instance->spill_enabled ? SUBGHZ_HISTORY_MAX_SPILL : SUBGHZ_HISTORY_MAX;
+}
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint16_t count = SubGhzHistoryItemArray_size(instance->items);
+    uint16_t limit = subghz_history_get_limit(instance);
+    furi_mutex_release(instance->mutex);
+    if(count >= limit) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) furi_string_printf(output, "%02u/%02u", count, limit);
     return false;
 }
 
+void subghz_history_flush(SubGhzHistory* instance) {
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    subghz_history_spill_flush(instance);
+    furi_mutex_release(instance->mutex);
+}
+
 uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
-    return instance->last_index_write;
+    return subghz_history_get_item(instance);
 }
+
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+
+    const char* name = item->protocol->name;
+    if(item->manufacture_index != SUBGHZ_HISTORY_INDEX_NONE) {
+        furi_string_printf(
+            instance->tmp_string,
+            "%s %s",
+            !strcmp(name, "KeeLoq") ? "KL" : "SL",
+            furi_string_get_cstr(
+                *SubGhzHistoryNameArray_get(instance->manufactures, item->manufacture_index)));
+        name = furi_string_get_cstr(instance->tmp_string);
+    }
+
+    uint64_t data = item->key;
+    if(data != 0) {
+        if(!(uint32_t)(data >> 32)) {
+            furi_string_printf(output, "%s %lX", name, (uint32_t)(data & 0xFFFFFFFF));
+        } else {
+            furi_string_printf(
+                output,
+                "%s %lX%08lX",
+                name,
+                (uint32_t)(data >> 32),
+                (uint32_t)(data & 0xFFFFFFFF));
+        }
+    } else {
+        furi_string_set(output, name);
+    }
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    FuriHalRtcDateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    furi_string_printf(output, "%.2d:%.2d:%.2d ", item->hour, item->minute, item->second);
+    furi_mutex_release(instance->mutex);
+}
+
+// FNV-1a
+static uint32_t subghz_history_hash(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+// Returns true if the hash was seen recently, remembers it otherwise
+static bool subghz_history_check_recent(SubGhzHistory* instance, uint32_t hash) {
+    uint32_t now = furi_get_tick();
+    SubGhzHistoryRecent* oldest = &instance->recent[0];
+
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RECENT_COUNT; i++) {
+        SubGhzHistoryRecent* recent = &instance->recent[i];
+        if(recent->hash == hash && (now - recent->timestamp) < SUBGHZ_HISTORY_RECENT_TIMEOUT) {
+            // Signal is still repeated, keep suppressing it
+            recent->timestamp = now;
+            return true;
+        }
+        if((now - recent->timestamp) > (now - oldest->timestamp)) {
+            oldest = recent;
+        }
+    }
+
+    oldest->hash = hash;
+    oldest->timestamp = now;
+    return false;
+}
+
+static uint8_t subghz_history_find_preset(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    size_t count = SubGhzHistoryPresetArray_size(instance->presets);
+    for(size_t i = 0; i < count; i++) {
+        SubGhzRadioPreset* known = SubGhzHistoryPresetArray_get(instance->presets, i);
+        if(known->data == preset->data && known->data_size == preset->data_size &&
+           furi_string_equal(known->name, preset->name)) {
+            return i;
+        }
+    }
+    if(count >= SUBGHZ_HISTORY_INDEX_NONE) return SUBGHZ_HISTORY_INDEX_NONE;
+
+    SubGhzRadioPreset* known = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    known->name = furi_string_alloc_set(preset->name);
+    known->frequency = 0;
+    known->data = preset->data;
+    known->data_size = preset->data_size;
+    return count;
+}
+
+static uint8_t subghz_history_find_manufacture(SubGhzHistory* instance, FuriString* name) {
+    size_t count = SubGhzHistoryNameArray_size(instance->manufactures);
+    for(size_t i = 0; i < count; i++) {
+        if(furi_string_equal(*SubGhzHistoryNameArray_get(instance->manufactures, i), name)) {
+            return i;
+        }
+    }
+    if(count >= SUBGHZ_HISTORY_INDEX_NONE) return SUBGHZ_HISTORY_INDEX_NONE;
+
+    SubGhzHistoryNameArray_push_back(instance->manufactures, furi_string_alloc_set(name));
+    return count;
 }
 
 bool subghz_history_add_to_history(
@@ -183,93 +418,86 @@ bool subghz_history_add_to_history(
     furi_assert(instance);
     furi_assert(context);
 
-    if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) return false;
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    if(subghz_history_get_text_space_left(instance, NULL)) return false;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
+    FlipperFormat* flipper_format = instance->add_data;
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_clean(stream);
+    if(subghz_protocol_decoder_base_serialize(decoder_base, flipper_format, preset) !=
+       SubGhzProtocolStatusOk) {
+        FURI_LOG_E(TAG, "Serialize error");
         return false;
     }
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
+    SubGhzHistoryItem item = {
+        .protocol = decoder_base->protocol,
+        .frequency = preset->frequency,
+        .data_size = stream_size(stream),
+        .manufacture_index = SUBGHZ_HISTORY_INDEX_NONE,
+    };
 
-    FuriString* text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    flipper_format_rewind(flipper_format);
+    if(!flipper_format_read_hex(flipper_format, "Key", key_data, sizeof(uint64_t))) {
+        FURI_LOG_D(TAG, "No Key");
+    }
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        item.key = (item.key << 8) | key_data[i];
+    }
+    uint32_t bit_count = 0;
+    flipper_format_rewind(flipper_format);
+    if(flipper_format_read_uint32(flipper_format, "Bit", &bit_count, 1)) {
+        item.bit_count = bit_count;
+    }
 
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    uint8_t hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    uint32_t hash = 2166136261UL;
+    hash = subghz_history_hash(hash, &item.protocol, sizeof(item.protocol));
+    hash = subghz_history_hash(hash, &item.key, sizeof(item.key));
+    hash = subghz_history_hash(hash, &item.bit_count, sizeof(item.bit_count));
+    hash = subghz_history_hash(hash, &hash_data, sizeof(hash_data));
 
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    bool added = false;
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
+        if(subghz_history_check_recent(instance, hash)) break;
+
+        if(!strcmp(item.protocol->name, "KeeLoq") || !strcmp(item.protocol->name, "Star Line")) {
+            flipper_format_rewind(flipper_format);
+            if(flipper_format_read_string(flipper_format, "Manufacture", instance->tmp_string)) {
+                item.manufacture_index =
+                    subghz_history_find_manufacture(instance, instance->tmp_string);
+            } else {
+                FURI_LOG_E(TAG, "Missing Manufacture");
             }
-            furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
+
+        item.preset_index = subghz_history_find_preset(instance, preset);
+        if(item.preset_index == SUBGHZ_HISTORY_INDEX_NONE) {
+            FURI_LOG_E(TAG, "Too many presets");
             break;
         }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_D(TAG, "No Key");
-        }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(data != 0) {
-            if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data >> 32),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            }
-        } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+
+        FuriHalRtcDateTime datetime;
+        furi_hal_rtc_get_datetime(&datetime);
+        item.hour = datetime.hour;
+        item.minute = datetime.minute;
+        item.second = datetime.second;
+
+        // Partially written data is never referenced, offsets only depend on the tail size
+        stream_seek(instance->tail, 0, StreamOffsetFromEnd);
+        item.data_offset = instance->spill_size + stream_size(instance->tail);
+        stream_rewind(stream);
+        if(stream_copy(stream, instance->tail, item.data_size) != item.data_size) {
+            FURI_LOG_E(TAG, "Store error");
+            break;
         }
 
+        SubGhzHistoryItemArray_push_back(instance->items, item);
+        added = true;
     } while(false);
+    furi_mutex_release(instance->mutex);
 
-    furi_string_free(text);
-    instance->last_index_write++;
-    return true;
+    return added;
 }
@@ -42,10 +42,10 @@ SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint
 /** Get preset to history[idx]
  * 
  * @param instance  - SubGhzHistory instance
+ * @param output    - FuriString* output, receives the preset name
  * @param idx       - record index  
- * @return preset   - preset name
  */
-const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx);
+void subghz_history_get_preset(SubGhzHistory* instance, FuriString* output, uint16_t idx);
 
 /** Get history index write 
  * 
@@ -94,6 +94,12 @@ void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* outp
  */
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output);
 
+/** Move collected signal data to the SD card, call from the GUI thread
+ *
+ * @param instance - SubGhzHistory instance
+ */
+void subghz_history_flush(SubGhzHistory* instance);
+
 /** Return last index
  *
  * @param instance - SubGhzHistory instance
@@ -114,9 +120,10 @@ bool subghz_history_add_to_history(
     SubGhzRadioPreset* preset);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * Data is loaded into a shared buffer that is valid until the next call
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return SubGhzProtocolCommonLoad*, NULL on read error
  */
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
@@ -19,6 +19,7 @@
 #define SUBGHZ_LAST_SETTING_FIELD_IGNORE_FILTER "IgnoreFilter"
 #define SUBGHZ_LAST_SETTING_FIELD_FILTER "Filter"
 #define SUBGHZ_LAST_SETTING_FIELD_RSSI_THRESHOLD "RSSI"
+#define SUBGHZ_LAST_SETTING_FIELD_RAW_PACKED "RAWPacked"
 
 SubGhzLastSettings* subghz_last_settings_alloc(void) {
     SubGhzLastSettings* instance = malloc(sizeof(SubGhzLastSettings));
@@ -47,6 +48,7 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
     uint32_t temp_ignore_filter = 0;
     uint32_t temp_filter = 0;
     float temp_rssi = 0;
+    bool temp_raw_packed = false;
     uint32_t temp_preset = 0;
 
     bool preset_was_read = false;
@@ -106,6 +108,8 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
             1);
         filter_was_read = flipper_format_read_uint32(
             fff_data_file, SUBGHZ_LAST_SETTING_FIELD_FILTER, (uint32_t*)&temp_filter, 1);
+        flipper_format_read_bool(
+            fff_data_file, SUBGHZ_LAST_SETTING_FIELD_RAW_PACKED, (bool*)&temp_raw_packed, 1);
     } else {
         FURI_LOG_E(TAG, "Error open file %s", SUBGHZ_LAST_SETTINGS_PATH);
     }
@@ -126,6 +130,7 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
         // See bin_raw_value in applications/main/subghz/scenes/subghz_scene_receiver_config.c
         instance->filter = SubGhzProtocolFlag_Decodable;
         instance->rssi = SUBGHZ_RAW_THRESHOLD_MIN;
+        instance->raw_packed = false;
     } else {
         instance->frequency = temp_frequency;
         instance->frequency_analyzer_feedback_level =
@@ -161,6 +166,7 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
 
         instance->rssi = rssi_was_read ? temp_rssi : SUBGHZ_RAW_THRESHOLD_MIN;
         instance->enable_hopping = temp_enable_hopping;
+        instance->raw_packed = temp_raw_packed;
         instance->ignore_filter = ignore_filter_was_read ? temp_ignore_filter : 0x00;
 #if SUBGHZ_LAST_SETTING_SAVE_BIN_RAW
         instance->filter = filter_was_read ? temp_filter : SubGhzProtocolFlag_Decodable;
@@ -270,6 +276,10 @@ bool subghz_last_settings_save(SubGhzLastSettings* instance) {
                file, SUBGHZ_LAST_SETTING_FIELD_FILTER, &instance->filter, 1)) {
             break;
         }
+        if(!flipper_format_insert_or_update_bool(
+               file, SUBGHZ_LAST_SETTING_FIELD_RAW_PACKED, &instance->raw_packed, 1)) {
+            break;
+        }
         saved = true;
     } while(0);
 
@@ -302,7 +312,7 @@ void subghz_last_settings_log(SubGhzLastSettings* instance) {
     FURI_LOG_I(
         TAG,
         "Frequency: %03ld.%02ld, FeedbackLevel: %ld, FATrigger: %.2f, External: %s, ExtPower: %s, TimestampNames: %s, ExtPowerAmp: %s,\n"
-        "Hopping: %s,\nPreset: %ld, RSSI: %.2f, "
+        "Hopping: %s,\nPreset: %ld, RSSI: %.2f, RAWPacked: %s, "
         "Starline: %s, Cars: %s, Magellan: %s, NiceFloR-S: %s, BinRAW: %s",
         instance->frequency / 1000000 % 1000,
         instance->frequency / 10000 % 100,
@@ -315,6 +325,7 @@ void subghz_last_settings_log(SubGhzLastSettings* instance) {
         bool_to_char(instance->enable_hopping),
         instance->preset_index,
         (double)instance->rssi,
+        bool_to_char(instance->raw_packed),
         subghz_last_settings_log_filter_get_index(
             instance->ignore_filter, SubGhzProtocolFlag_StarLine),
         subghz_last_settings_log_filter_get_index(
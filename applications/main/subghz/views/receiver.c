@@ -16,9 +16,8 @@
 
 #define FLIP_TIMEOUT (500)
 
+// Text of the item is requested from SubGhzViewReceiverItemCallback when it is drawn
 typedef struct {
-    FuriString* item_str;
-    FuriString* time;
     uint8_t type;
 } SubGhzReceiverMenuItem;
 
@@ -65,6 +64,8 @@ typedef struct {
     bool hopping_enabled;
     bool bin_raw_enabled;
     SubGhzReceiverHistory* history;
+    SubGhzViewReceiverItemCallback item_callback;
+    void* item_context;
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -131,6 +132,22 @@ void subghz_view_receiver_set_callback(
     subghz_receiver->context = context;
 }
 
+void subghz_view_receiver_set_item_callback(
+    SubGhzViewReceiver* subghz_receiver,
+    SubGhzViewReceiverItemCallback callback,
+    void* context) {
+    furi_assert(subghz_receiver);
+    furi_assert(callback);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            model->item_callback = callback;
+            model->item_context = context;
+        },
+        false);
+}
+
 static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiver) {
     furi_assert(subghz_receiver);
 
@@ -171,11 +188,7 @@ static void subghz_view_receiver_flip_string_callback(void* context) {
         true);
 }
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type) {
+void subghz_view_receiver_add_item_to_menu(SubGhzViewReceiver* subghz_receiver, uint8_t type) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view,
@@ -183,8 +196,6 @@ void subghz_view_receiver_add_item_to_menu(
         {
             SubGhzReceiverMenuItem* item_menu =
                 SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->time = furi_string_alloc_set(time);
-            item_menu->item_str = furi_string_alloc_set(name);
             item_menu->type = type;
             if((model->idx == model->history_item - 1)) {
                 model->history_item++;
@@ -280,8 +291,9 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
 
     bool scrollbar = model->history_item > 4;
     FuriString* str_buff = furi_string_alloc();
+    FuriString* time_buff = furi_string_alloc();
 
-    if(!model->nodraw) {
+    if(!model->nodraw && model->item_callback) {
         SubGhzReceiverMenuItem* item_menu;
 
         for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
@@ -293,12 +305,12 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
             if(item_menu->type == 0) {
                 break;
             }
-            furi_string_set(str_buff, item_menu->item_str);
+            model->item_callback(idx, str_buff, time_buff, model->item_context);
             if(model->idx == idx) {
                 subghz_view_receiver_draw_frame(canvas, i, scrollbar);
                 if(model->show_time) {
                     // Show time of signal one moment
-                    furi_string_set(str_buff, item_menu->time);
+                    furi_string_set(str_buff, time_buff);
                 }
             } else {
                 canvas_set_color(canvas, ColorBlack);
@@ -313,6 +325,7 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
         }
     }
     furi_string_free(str_buff);
+    furi_string_free(time_buff);
 
     canvas_set_color(canvas, ColorBlack);
 
@@ -555,12 +568,6 @@ void subghz_view_receiver_exit(void* context) {
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
 
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
                 SubGhzReceiverMenuItemArray_reset(model->history->data);
                 model->idx = 0;
                 model->list_offset = 0;
@@ -627,12 +634,6 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
             furi_string_free(model->progress_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
                 SubGhzReceiverMenuItemArray_clear(model->history->data);
                 free(model->history);
         },
@@ -667,12 +668,7 @@ void subghz_view_receiver_delete_element_callback(SubGhzViewReceiver* subghz_rec
             //     SubGhzReceiverMenuItemArray_get(model->history->data, model->idx);
             SubGhzReceiverMenuItemArray_it_last(it, model->history->data);
             while(!SubGhzReceiverMenuItemArray_end_p(it)) {
-                SubGhzReceiverMenuItem* item = SubGhzReceiverMenuItemArray_ref(it);
-
                 if(it->index == (size_t)(model->idx)) {
-                    furi_string_free(item->item_str);
-                    furi_string_free(item->time);
-                    item->type = 0;
                     SubGhzReceiverMenuItemArray_remove(model->history->data, it);
                 }
 
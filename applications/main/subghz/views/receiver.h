@@ -8,6 +8,13 @@ typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
 typedef void (*SubGhzViewReceiverCallback)(SubGhzCustomEvent event, void* context);
 
+/** Fill the name and the time of the menu item, called for visible items only */
+typedef void (*SubGhzViewReceiverItemCallback)(
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time,
+    void* context);
+
 void subghz_view_receiver_set_mode(
     SubGhzViewReceiver* subghz_receiver,
     SubGhzViewReceiverMode mode);
@@ -21,6 +28,11 @@ void subghz_view_receiver_set_callback(
     SubGhzViewReceiverCallback callback,
     void* context);
 
+void subghz_view_receiver_set_item_callback(
+    SubGhzViewReceiver* subghz_receiver,
+    SubGhzViewReceiverItemCallback callback,
+    void* context);
+
 SubGhzViewReceiver* subghz_view_receiver_alloc();
 
 void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver);
@@ -43,11 +55,7 @@ void subghz_view_receiver_add_data_progress(
     SubGhzViewReceiver* subghz_receiver,
     const char* progress_str);
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type);
+void subghz_view_receiver_add_item_to_menu(SubGhzViewReceiver* subghz_receiver, uint8_t type);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
@@ -263,14 +263,12 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     } else if(!furi_string_cmp(args, "main")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeMain);
         printf("Heap tracking enabled for application main thread");
-#if FURI_DEBUG
     } else if(!furi_string_cmp(args, "tree")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeTree);
         printf("Heap tracking enabled for application main and child threads");
     } else if(!furi_string_cmp(args, "all")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeAll);
         printf("Heap tracking enabled for all threads");
-#endif
     } else {
         cli_print_usage("sysctl heap_track", "<none|main|tree|all>", furi_string_get_cstr(args));
     }
@@ -282,11 +280,7 @@ void cli_command_sysctl_print_usage() {
     printf("Cmd list:\r\n");
 
     printf("\tdebug <0|1>\t - Enable or disable system debug\r\n");
-#if FURI_DEBUG
     printf("\theap_track <none|main|tree|all>\t - Set heap allocation tracking mode\r\n");
-#else
-    printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
-#endif
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -426,6 +420,18 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
     printf("Minimum heap size: %zu\r\n", memmgr_get_minimum_free_heap());
     printf("Maximum heap block: %zu\r\n", memmgr_heap_get_max_free_block());
 
+    for(size_t i = 0; i < memmgr_heap_get_slab_class_count(); i++) {
+        MemmgrHeapSlabClassInfo info;
+        memmgr_heap_get_slab_class_info(i, &info);
+        printf(
+            "Size class %zu: %zu used, %zu free, %zu slabs, %lu allocs\r\n",
+            info.block_size,
+            info.used_blocks,
+            info.free_blocks,
+            info.slab_count,
+            info.alloc_count);
+    }
+
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
 }
@@ -438,6 +444,23 @@ void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+void cli_command_free_sites(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    if(!furi_string_cmp(args, "start")) {
+        memmgr_heap_enable_site_trace();
+        printf("Call site histogram started");
+    } else if(!furi_string_cmp(args, "stop")) {
+        memmgr_heap_disable_site_trace();
+        printf("Call site histogram stopped");
+    } else if(furi_string_empty(args)) {
+        memmgr_heap_printf_sites();
+    } else {
+        cli_print_usage("free_sites", "<start|stop>", furi_string_get_cstr(args));
+    }
+}
+
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
     UNUSED(args);
@@ -479,6 +502,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "free_sites", CliCommandFlagParallelSafe, cli_command_free_sites, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
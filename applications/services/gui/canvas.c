@@ -27,6 +27,7 @@ Canvas* canvas_init() {
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    canvas->frame = malloc(canvas_get_buffer_size(canvas));
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -42,6 +43,7 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    free(canvas->frame);
     free(canvas);
 }
 
@@ -57,7 +59,67 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    u8g2_t* fb = &canvas->fb;
+    const uint8_t* buffer = u8g2_GetBufferPtr(fb);
+    const size_t page_width = u8g2_GetBufferTileWidth(fb) * 8;
+    const size_t page_count = u8g2_GetBufferTileHeight(fb);
+    CanvasDamage* damage = &canvas->damage;
+
+    if(!canvas->frame_valid) {
+        u8g2_SendBuffer(fb);
+        memcpy(canvas->frame, buffer, page_width * page_count);
+        canvas->frame_valid = true;
+        damage->x = 0;
+        damage->width = page_width;
+        damage->page = 0;
+        damage->pages = page_count;
+        return;
+    }
+
+    size_t x_min = page_width, x_max = 0;
+    size_t page_min = page_count, page_max = 0;
+
+    for(size_t page = 0; page < page_count; page++) {
+        const uint8_t* line = buffer + page * page_width;
+        uint8_t* frame_line = canvas->frame + page * page_width;
+
+        size_t first = 0;
+        while(first < page_width && line[first] == frame_line[first]) first++;
+        if(first == page_width) continue;
+        size_t last = page_width - 1;
+        while(line[last] == frame_line[last]) last--;
+
+        // Display is written in tiles of 8 columns
+        const size_t tile_first = first / 8;
+        const size_t tile_last = last / 8;
+        u8g2_UpdateDisplayArea(fb, tile_first, page, tile_last - tile_first + 1, 1);
+        memcpy(frame_line + first, line + first, last - first + 1);
+
+        x_min = MIN(x_min, first);
+        x_max = MAX(x_max, last);
+        page_min = MIN(page_min, page);
+        page_max = page;
+    }
+
+    if(page_min < page_count) {
+        u8x8_RefreshDisplay(u8g2_GetU8x8(fb));
+        damage->x = x_min;
+        damage->width = x_max - x_min + 1;
+        damage->page = page_min;
+        damage->pages = page_max - page_min + 1;
+    } else {
+        memset(damage, 0, sizeof(CanvasDamage));
+    }
+}
+
+const CanvasDamage* canvas_get_damage(const Canvas* canvas) {
+    furi_assert(canvas);
+    return &canvas->damage;
+}
+
+void canvas_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->frame_valid = false;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -259,7 +321,8 @@ void canvas_draw_bitmap(
     x += canvas->offset_x;
     y += canvas->offset_y;
     uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    // Used for dolphin animation frames loaded from storage, caching them would only evict icons
+    compress_icon_decode_uncached(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -57,6 +57,18 @@ typedef enum {
     CanvasOrientationVerticalFlip,
 } CanvasOrientation;
 
+/** Canvas damage: framebuffer area that changed on the last commit
+ *
+ * Display memory is organized in pages of 8 pixel rows, damage is tracked in
+ * the same units: columns along the page and whole pages.
+ */
+typedef struct {
+    uint8_t x; /**< First changed column */
+    uint8_t width; /**< Number of changed columns, 0 if nothing changed */
+    uint8_t page; /**< First changed page */
+    uint8_t pages; /**< Number of changed pages, 0 if nothing changed */
+} CanvasDamage;
+
 /** Font Direction */
 typedef enum {
     CanvasDirectionLeftToRight,
@@ -99,6 +111,8 @@ typedef struct Canvas Canvas;
 void canvas_reset(Canvas* canvas);
 
 /** Commit canvas. Send buffer to display
+ *
+ * Only pages that changed since the previous commit are sent.
  *
  * @param      canvas  Canvas instance
  */
@@ -23,6 +23,10 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    // Last frame sent to the display, for partial updates
+    uint8_t* frame;
+    bool frame_valid;
+    CanvasDamage damage;
 };
 
 /** Allocate memory and initialize canvas
@@ -83,6 +87,22 @@ void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation);
  */
 CanvasOrientation canvas_get_orientation(const Canvas* canvas);
 
+/** Get area changed by the last commit
+ *
+ * @param      canvas  Canvas instance
+ *
+ * @return     pointer to CanvasDamage, valid until the next commit
+ */
+const CanvasDamage* canvas_get_damage(const Canvas* canvas);
+
+/** Send the whole buffer on the next commit
+ *
+ * Use when display memory may no longer match the last sent frame.
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_invalidate(Canvas* canvas);
+
 /** Draw a u8g2 bitmap
  *
  * @param      canvas   Canvas instance
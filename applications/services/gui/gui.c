@@ -619,6 +619,11 @@ size_t gui_get_framebuffer_size(const Gui* gui) {
     return canvas_get_buffer_size(gui->canvas);
 }
 
+const CanvasDamage* gui_get_framebuffer_damage(const Gui* gui) {
+    furi_assert(gui);
+    return canvas_get_damage(gui->canvas);
+}
+
 void gui_set_hide_statusbar(Gui* gui, bool hidden) {
     furi_assert(gui);
 
@@ -103,6 +103,16 @@ void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback,
  */
 size_t gui_get_framebuffer_size(const Gui* gui);
 
+/** Get area of the frame buffer changed by the last redraw
+ *
+ * Meant to be called from GuiCanvasCommitCallback, consumers can use it to
+ * skip or crop unchanged frames.
+ *
+ * @param      gui       Gui instance
+ * @return     pointer to CanvasDamage, valid until the next redraw
+ */
+const CanvasDamage* gui_get_framebuffer_damage(const Gui* gui);
+
 /** Set hidden statusbar
  *
  * Hide the statusbar (stacks if called multiple times).
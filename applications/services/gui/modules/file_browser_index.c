@@ -0,0 +1,907 @@
+#include "file_browser_index.h"
+
+#include <storage/storage.h>
+#include <toolbox/crc32_calc.h>
+#include <furi.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+
+#define TAG "BrowserIndex"
+
+#define BROWSER_INDEX_FOLDER EXT_PATH(".dircache")
+#define BROWSER_INDEX_TEMP_A BROWSER_INDEX_FOLDER "/sort_a.tmp"
+#define BROWSER_INDEX_TEMP_B BROWSER_INDEX_FOLDER "/sort_b.tmp"
+
+#define BROWSER_INDEX_MAGIC 0x58494246U
+#define BROWSER_INDEX_VERSION 2U
+
+#define BROWSER_INDEX_NAME_MAX 255U
+#define BROWSER_INDEX_IO_BUFFER_SIZE 512U
+#define BROWSER_INDEX_RUN_BUFFER_SIZE 4096U
+#define BROWSER_INDEX_RUN_ITEMS_MAX 256U
+
+#define BROWSER_INDEX_FLAG_FOLDER (1U << 0)
+
+#define BROWSER_INDEX_RECORD_HEADER_SIZE (offsetof(BrowserIndexRecord, name))
+
+/*
+ * Index file: header, key, records sorted by name, table of record offsets.
+ * Record: flags byte, name size byte, file size, name without terminator.
+ * Temporary files hold sorted runs: run header followed by records.
+ */
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t key_size;
+    uint32_t count;
+    uint32_t sum;
+    uint32_t xor_sum;
+    uint32_t table_offset;
+} __attribute__((packed)) BrowserIndexHeader;
+
+typedef struct {
+    uint32_t count;
+    uint32_t size;
+} __attribute__((packed)) BrowserIndexRunHeader;
+
+typedef struct {
+    uint8_t flags;
+    uint8_t size;
+    uint32_t file_size;
+    char name[BROWSER_INDEX_NAME_MAX + 1];
+} __attribute__((packed)) BrowserIndexRecord;
+
+typedef struct {
+    File* file;
+    uint32_t position;
+    uint32_t end;
+    uint16_t length;
+    uint16_t offset;
+    uint8_t buffer[BROWSER_INDEX_IO_BUFFER_SIZE];
+} BrowserIndexReader;
+
+typedef struct {
+    File* file;
+    uint32_t position;
+    uint16_t length;
+    uint8_t buffer[BROWSER_INDEX_IO_BUFFER_SIZE];
+} BrowserIndexWriter;
+
+// Buffers needed only while an index is written
+typedef struct {
+    BrowserIndexReader reader[2];
+    BrowserIndexWriter writer[2];
+    BrowserIndexRecord record[2];
+    uint8_t run[BROWSER_INDEX_RUN_BUFFER_SIZE];
+    uint16_t run_items[BROWSER_INDEX_RUN_ITEMS_MAX];
+} BrowserIndexWork;
+
+struct BrowserIndex {
+    Storage* storage;
+    FuriMutex* mutex;
+
+    BrowserIndexFilterCallback filter;
+    void* filter_context;
+    FuriString* config;
+    bool dirs_first;
+
+    FuriString* key;
+    FuriString* file_path;
+    BrowserIndexHeader header;
+
+    BrowserIndexReader reader;
+    BrowserIndexRecord record;
+    char name[BROWSER_INDEX_NAME_MAX + 1];
+};
+
+static uint32_t browser_index_entry_hash(const char* name, bool is_folder, uint32_t file_size) {
+    uint32_t hash = 0x811C9DC5UL;
+    while(*name) {
+        hash = (hash ^ (uint8_t)*name++) * 0x01000193UL;
+    }
+    hash = (hash ^ (is_folder ? 1 : 0)) * 0x01000193UL;
+    for(size_t i = 0; i < sizeof(file_size); i++) {
+        hash = (hash ^ (uint8_t)(file_size >> (i * 8))) * 0x01000193UL;
+    }
+    return hash;
+}
+
+void browser_index_signature_reset(BrowserIndexSignature* signature) {
+    memset(signature, 0, sizeof(BrowserIndexSignature));
+}
+
+void browser_index_signature_add(
+    BrowserIndexSignature* signature,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size) {
+    const uint32_t hash = browser_index_entry_hash(name, is_folder, file_size);
+    signature->count++;
+    signature->sum += hash;
+    signature->xor_sum ^= hash;
+}
+
+static void browser_index_signature_remove(
+    BrowserIndexSignature* signature,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size) {
+    const uint32_t hash = browser_index_entry_hash(name, is_folder, file_size);
+    signature->count--;
+    signature->sum -= hash;
+    signature->xor_sum ^= hash;
+}
+
+static int browser_index_cmp(
+    const BrowserIndex* index,
+    uint8_t a_flags,
+    const char* a_name,
+    uint8_t b_flags,
+    const char* b_name) {
+    if(index->dirs_first && ((a_flags ^ b_flags) & BROWSER_INDEX_FLAG_FOLDER)) {
+        return (a_flags & BROWSER_INDEX_FLAG_FOLDER) ? -1 : 1;
+    }
+
+    int result = strcasecmp(a_name, b_name);
+    if(result == 0) {
+        result = strcmp(a_name, b_name);
+    }
+    return result;
+}
+
+static int browser_index_record_cmp(
+    const BrowserIndex* index,
+    const BrowserIndexRecord* a,
+    const BrowserIndexRecord* b) {
+    return browser_index_cmp(index, a->flags, a->name, b->flags, b->name);
+}
+
+static void browser_index_reader_init(
+    BrowserIndexReader* reader,
+    File* file,
+    uint32_t start,
+    uint32_t end) {
+    reader->file = file;
+    reader->position = start;
+    reader->end = end;
+    reader->length = 0;
+    reader->offset = 0;
+}
+
+// Seeks before every read, so several readers can share one file
+static bool browser_index_reader_fill(BrowserIndexReader* reader, size_t size) {
+    const size_t available = reader->length - reader->offset;
+    if(available >= size) return true;
+
+    memmove(reader->buffer, reader->buffer + reader->offset, available);
+    reader->length = available;
+    reader->offset = 0;
+
+    const size_t to_read =
+        MIN(sizeof(reader->buffer) - reader->length, reader->end - reader->position);
+    if(to_read) {
+        if(!storage_file_seek(reader->file, reader->position, true)) return false;
+        if(storage_file_read(reader->file, reader->buffer + reader->length, to_read) != to_read) {
+            return false;
+        }
+        reader->position += to_read;
+        reader->length += to_read;
+    }
+
+    return reader->length >= size;
+}
+
+static bool browser_index_reader_next(BrowserIndexReader* reader, BrowserIndexRecord* record) {
+    if(!browser_index_reader_fill(reader, BROWSER_INDEX_RECORD_HEADER_SIZE)) return false;
+    memcpy(record, reader->buffer + reader->offset, BROWSER_INDEX_RECORD_HEADER_SIZE);
+
+    if(!browser_index_reader_fill(reader, BROWSER_INDEX_RECORD_HEADER_SIZE + record->size)) {
+        return false;
+    }
+    memcpy(
+        record->name,
+        reader->buffer + reader->offset + BROWSER_INDEX_RECORD_HEADER_SIZE,
+        record->size);
+    record->name[record->size] = '\0';
+    reader->offset += BROWSER_INDEX_RECORD_HEADER_SIZE + record->size;
+
+    return true;
+}
+
+static void browser_index_writer_init(BrowserIndexWriter* writer, File* file) {
+    writer->file = file;
+    writer->position = 0;
+    writer->length = 0;
+}
+
+static bool browser_index_writer_flush(BrowserIndexWriter* writer) {
+    const bool result =
+        (storage_file_write(writer->file, writer->buffer, writer->length) == writer->length);
+    writer->length = 0;
+    return result;
+}
+
+static bool browser_index_writer_write(BrowserIndexWriter* writer, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    while(size) {
+        if(writer->length == sizeof(writer->buffer) && !browser_index_writer_flush(writer)) {
+            return false;
+        }
+        const size_t chunk = MIN(size, sizeof(writer->buffer) - writer->length);
+        memcpy(writer->buffer + writer->length, bytes, chunk);
+        writer->length += chunk;
+        writer->position += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+static bool browser_index_writer_write_record(
+    BrowserIndexWriter* writer,
+    const BrowserIndexRecord* record) {
+    return browser_index_writer_write(writer, record, BROWSER_INDEX_RECORD_HEADER_SIZE) &&
+           browser_index_writer_write(writer, record->name, record->size);
+}
+
+static bool
+    browser_index_read_run_header(File* file, uint32_t offset, BrowserIndexRunHeader* run) {
+    return storage_file_seek(file, offset, true) &&
+           (storage_file_read(file, run, sizeof(BrowserIndexRunHeader)) ==
+            sizeof(BrowserIndexRunHeader));
+}
+
+static void browser_index_set_path(BrowserIndex* index, const char* path) {
+    furi_string_printf(
+        index->key, "%s\n%s\n%u", path, furi_string_get_cstr(index->config), index->dirs_first);
+    furi_string_printf(
+        index->file_path,
+        "%s/%08lX.idx",
+        BROWSER_INDEX_FOLDER,
+        crc32_calc_buffer(0, furi_string_get_cstr(index->key), furi_string_size(index->key)));
+}
+
+// Opens the index and checks that it belongs to the directory and configuration
+static bool browser_index_open(BrowserIndex* index, File* file, const char* path) {
+    browser_index_set_path(index, path);
+
+    bool result = false;
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index->file_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(storage_file_read(file, &index->header, sizeof(BrowserIndexHeader)) !=
+           sizeof(BrowserIndexHeader)) {
+            break;
+        }
+        if(index->header.magic != BROWSER_INDEX_MAGIC ||
+           index->header.version != BROWSER_INDEX_VERSION ||
+           index->header.key_size != furi_string_size(index->key)) {
+            break;
+        }
+
+        const char* key = furi_string_get_cstr(index->key);
+        size_t key_offset = 0;
+        while(key_offset < index->header.key_size) {
+            const size_t chunk = MIN(sizeof(index->name), index->header.key_size - key_offset);
+            if(storage_file_read(file, index->name, chunk) != chunk ||
+               memcmp(index->name, key + key_offset, chunk) != 0) {
+                break;
+            }
+            key_offset += chunk;
+        }
+        result = (key_offset == index->header.key_size);
+    } while(false);
+
+    return result;
+}
+
+static bool browser_index_seek(BrowserIndex* index, File* file, uint32_t idx) {
+    uint32_t offset = 0;
+    if(!storage_file_seek(file, index->header.table_offset + idx * sizeof(uint32_t), true) ||
+       storage_file_read(file, &offset, sizeof(uint32_t)) != sizeof(uint32_t)) {
+        return false;
+    }
+    browser_index_reader_init(&index->reader, file, offset, index->header.table_offset);
+    return true;
+}
+
+static void browser_index_sort_run(BrowserIndex* index, BrowserIndexWork* work, size_t count) {
+    // Runs are short, insertion sort is enough
+    for(size_t i = 1; i < count; i++) {
+        const uint16_t item = work->run_items[i];
+        const uint8_t* record = &work->run[item];
+        size_t j = i;
+        while(j > 0) {
+            const uint8_t* other = &work->run[work->run_items[j - 1]];
+            if(browser_index_cmp(
+                   index,
+                   other[0],
+                   (const char*)&other[BROWSER_INDEX_RECORD_HEADER_SIZE],
+                   record[0],
+                   (const char*)&record[BROWSER_INDEX_RECORD_HEADER_SIZE]) <= 0) {
+                break;
+            }
+            work->run_items[j] = work->run_items[j - 1];
+            j--;
+        }
+        work->run_items[j] = item;
+    }
+}
+
+static bool browser_index_write_run(
+    BrowserIndex* index,
+    BrowserIndexWork* work,
+    BrowserIndexWriter* writer,
+    size_t count) {
+    browser_index_sort_run(index, work, count);
+
+    BrowserIndexRunHeader run = {.count = count, .size = 0};
+    for(size_t i = 0; i < count; i++) {
+        run.size += BROWSER_INDEX_RECORD_HEADER_SIZE + work->run[work->run_items[i] + 1];
+    }
+
+    bool result = browser_index_writer_write(writer, &run, sizeof(run));
+    for(size_t i = 0; result && i < count; i++) {
+        const uint8_t* record = &work->run[work->run_items[i]];
+        result = browser_index_writer_write(
+            writer, record, BROWSER_INDEX_RECORD_HEADER_SIZE + record[1]);
+    }
+    return result;
+}
+
+// Reads the directory into sorted runs of what fits into the run buffer
+static bool browser_index_write_runs(
+    BrowserIndex* index,
+    BrowserIndexWork* work,
+    const char* path,
+    File* output,
+    uint32_t* runs,
+    uint32_t* size,
+    BrowserIndexSignature* signature) {
+    File* directory = storage_file_alloc(index->storage);
+    BrowserIndexWriter* writer = &work->writer[0];
+    browser_index_writer_init(writer, output);
+    browser_index_signature_reset(signature);
+    *runs = 0;
+
+    FileInfo file_info;
+    size_t run_size = 0;
+    size_t run_count = 0;
+
+    bool result = storage_dir_open(directory, path);
+    while(result && storage_dir_read(directory, &file_info, index->name, sizeof(index->name))) {
+        if(storage_file_get_error(directory) != FSE_OK) {
+            result = false;
+            break;
+        }
+        if(index->name[0] == '\0') continue;
+
+        const bool is_folder = file_info_is_dir(&file_info);
+        if(index->filter && !index->filter(index->filter_context, index->name, is_folder)) {
+            continue;
+        }
+
+        const size_t name_size = strlen(index->name);
+        const size_t record_size = BROWSER_INDEX_RECORD_HEADER_SIZE + name_size + 1;
+        if(run_size + record_size > BROWSER_INDEX_RUN_BUFFER_SIZE ||
+           run_count == BROWSER_INDEX_RUN_ITEMS_MAX) {
+            result = browser_index_write_run(index, work, writer, run_count);
+            (*runs)++;
+            run_size = 0;
+            run_count = 0;
+        }
+
+        // Name is kept terminated in the run buffer for comparison
+        const BrowserIndexRecord entry = {
+            .flags = is_folder ? BROWSER_INDEX_FLAG_FOLDER : 0,
+            .size = name_size,
+            .file_size = is_folder ? 0 : file_info.size,
+        };
+        uint8_t* record = &work->run[run_size];
+        memcpy(record, &entry, BROWSER_INDEX_RECORD_HEADER_SIZE);
+        memcpy(record + BROWSER_INDEX_RECORD_HEADER_SIZE, index->name, name_size + 1);
+        work->run_items[run_count++] = run_size;
+        run_size += record_size;
+
+        browser_index_signature_add(signature, index->name, is_folder, entry.file_size);
+    }
+
+    if(result && run_count) {
+        result = browser_index_write_run(index, work, writer, run_count);
+        (*runs)++;
+    }
+    result = result && browser_index_writer_flush(writer);
+    *size = writer->position;
+
+    storage_dir_close(directory);
+    storage_file_free(directory);
+
+    return result;
+}
+
+static bool browser_index_merge_pair(
+    BrowserIndex* index,
+    BrowserIndexWork* work,
+    File* input,
+    const uint32_t start[2],
+    const BrowserIndexRunHeader run[2],
+    BrowserIndexWriter* writer) {
+    BrowserIndexRecord* record = work->record;
+    bool has_record[2];
+    for(size_t i = 0; i < 2; i++) {
+        browser_index_reader_init(&work->reader[i], input, start[i], start[i] + run[i].size);
+        has_record[i] = run[i].count && browser_index_reader_next(&work->reader[i], &record[i]);
+    }
+
+    uint32_t written = 0;
+    while(has_record[0] || has_record[1]) {
+        const size_t i = (has_record[0] &&
+                          (!has_record[1] ||
+                           browser_index_record_cmp(index, &record[0], &record[1]) <= 0)) ?
+                             0 :
+                             1;
+        if(!browser_index_writer_write_record(writer, &record[i])) return false;
+        written++;
+        has_record[i] = browser_index_reader_next(&work->reader[i], &record[i]);
+    }
+
+    return written == run[0].count + run[1].count;
+}
+
+static bool browser_index_merge_runs(
+    BrowserIndex* index,
+    BrowserIndexWork* work,
+    File* input,
+    uint32_t input_size,
+    File* output,
+    uint32_t* runs,
+    uint32_t* output_size) {
+    BrowserIndexWriter* writer = &work->writer[0];
+    browser_index_writer_init(writer, output);
+    *runs = 0;
+
+    bool result = storage_file_seek(output, 0, true);
+    uint32_t position = 0;
+    while(result && position < input_size) {
+        BrowserIndexRunHeader run[2] = {};
+        uint32_t start[2];
+
+        for(size_t i = 0; i < 2; i++) {
+            if(position < input_size) {
+                result = result && browser_index_read_run_header(input, position, &run[i]);
+                start[i] = position + sizeof(BrowserIndexRunHeader);
+                position = start[i] + run[i].size;
+            } else {
+                start[i] = position;
+            }
+        }
+
+        const BrowserIndexRunHeader merged = {
+            .count = run[0].count + run[1].count,
+            .size = run[0].size + run[1].size,
+        };
+        result = result && browser_index_writer_write(writer, &merged, sizeof(merged)) &&
+                 browser_index_merge_pair(index, work, input, start, run, writer);
+        (*runs)++;
+    }
+    result = result && browser_index_writer_flush(writer);
+    *output_size = writer->position;
+
+    return result;
+}
+
+// Writes the index from a single sorted run, table is a temporary file for record offsets
+static bool browser_index_write(
+    BrowserIndex* index,
+    BrowserIndexWork* work,
+    File* input,
+    uint32_t input_size,
+    File* table,
+    const BrowserIndexSignature* signature) {
+    File* file = storage_file_alloc(index->storage);
+    BrowserIndexHeader* header = &index->header;
+    BrowserIndexWriter* writer = &work->writer[0];
+    BrowserIndexWriter* table_writer = &work->writer[1];
+    BrowserIndexReader* reader = &work->reader[0];
+    BrowserIndexRecord* record = &work->record[0];
+    bool result = false;
+
+    do {
+        BrowserIndexRunHeader run = {};
+        if(input_size && !browser_index_read_run_header(input, 0, &run)) break;
+        if(run.count != signature->count) break;
+
+        if(!storage_file_open(
+               file, furi_string_get_cstr(index->file_path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(!storage_file_seek(table, 0, true)) break;
+
+        memset(header, 0, sizeof(BrowserIndexHeader));
+        header->magic = BROWSER_INDEX_MAGIC;
+        header->version = BROWSER_INDEX_VERSION;
+        header->key_size = furi_string_size(index->key);
+        header->count = signature->count;
+        header->sum = signature->sum;
+        header->xor_sum = signature->xor_sum;
+
+        browser_index_writer_init(writer, file);
+        browser_index_writer_init(table_writer, table);
+        if(!browser_index_writer_write(writer, header, sizeof(BrowserIndexHeader)) ||
+           !browser_index_writer_write(
+               writer, furi_string_get_cstr(index->key), header->key_size)) {
+            break;
+        }
+
+        const uint32_t records_start = sizeof(BrowserIndexRunHeader);
+        browser_index_reader_init(reader, input, records_start, records_start + run.size);
+        uint32_t written = 0;
+        while(written < run.count) {
+            const uint32_t offset = writer->position;
+            if(!browser_index_reader_next(reader, record) ||
+               !browser_index_writer_write(table_writer, &offset, sizeof(uint32_t)) ||
+               !browser_index_writer_write_record(writer, record)) {
+                break;
+            }
+            written++;
+        }
+        if(written != run.count) break;
+
+        header->table_offset = writer->position;
+        if(!browser_index_writer_flush(writer) || !browser_index_writer_flush(table_writer)) {
+            break;
+        }
+
+        // Append the offset table, the reader buffer is free at this point
+        uint32_t copied = 0;
+        while(copied < table_writer->position) {
+            const size_t chunk = MIN(sizeof(reader->buffer), table_writer->position - copied);
+            if(!storage_file_seek(table, copied, true) ||
+               storage_file_read(table, reader->buffer, chunk) != chunk ||
+               storage_file_write(file, reader->buffer, chunk) != chunk) {
+                break;
+            }
+            copied += chunk;
+        }
+        if(copied != table_writer->position) break;
+
+        if(!storage_file_seek(file, 0, true) ||
+           storage_file_write(file, header, sizeof(BrowserIndexHeader)) !=
+               sizeof(BrowserIndexHeader)) {
+            break;
+        }
+
+        result = true;
+    } while(false);
+
+    storage_file_free(file);
+    if(!result) {
+        storage_simply_remove(index->storage, furi_string_get_cstr(index->file_path));
+    }
+
+    return result;
+}
+
+static bool browser_index_rebuild(BrowserIndex* index, const char* path, uint32_t* count) {
+    BrowserIndexWork* work = malloc(sizeof(BrowserIndexWork));
+    File* file_a = storage_file_alloc(index->storage);
+    File* file_b = storage_file_alloc(index->storage);
+    BrowserIndexSignature signature;
+    bool result = false;
+
+    do {
+        storage_simply_mkdir(index->storage, BROWSER_INDEX_FOLDER);
+        if(!storage_file_open(file_a, BROWSER_INDEX_TEMP_A, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS) ||
+           !storage_file_open(file_b, BROWSER_INDEX_TEMP_B, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        uint32_t runs = 0;
+        uint32_t size = 0;
+        if(!browser_index_write_runs(index, work, path, file_a, &runs, &size, &signature)) break;
+
+        // Merge pairs of runs until one is left, files are swapped after each pass
+        File* input = file_a;
+        File* output = file_b;
+        bool merged = true;
+        while(merged && runs > 1) {
+            merged = browser_index_merge_runs(index, work, input, size, output, &runs, &size);
+            File* temp = input;
+            input = output;
+            output = temp;
+        }
+        if(!merged) break;
+
+        result = browser_index_write(index, work, input, size, output, &signature);
+        *count = signature.count;
+    } while(false);
+
+    storage_file_free(file_a);
+    storage_file_free(file_b);
+    storage_simply_remove(index->storage, BROWSER_INDEX_TEMP_A);
+    storage_simply_remove(index->storage, BROWSER_INDEX_TEMP_B);
+    free(work);
+
+    if(result) {
+        FURI_LOG_D(TAG, "Indexed %s: %lu items", path, *count);
+    } else {
+        FURI_LOG_E(TAG, "Failed to index %s", path);
+    }
+
+    return result;
+}
+
+// Rewrites an existing index with one entry inserted or removed
+static bool browser_index_patch(
+    BrowserIndex* index,
+    const char* path,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size,
+    bool add) {
+    const size_t name_size = strlen(name);
+    if(name_size == 0 || name_size > BROWSER_INDEX_NAME_MAX) return false;
+
+    BrowserIndexWork* work = malloc(sizeof(BrowserIndexWork));
+    File* file = storage_file_alloc(index->storage);
+    File* file_a = storage_file_alloc(index->storage);
+    File* file_b = storage_file_alloc(index->storage);
+    BrowserIndexWriter* writer = &work->writer[0];
+    BrowserIndexReader* reader = &work->reader[0];
+    BrowserIndexRecord* record = &work->record[0];
+    BrowserIndexRecord* entry = &work->record[1];
+    bool result = false;
+
+    do {
+        if(!browser_index_open(index, file, path)) break;
+        BrowserIndexSignature signature = {
+            .count = index->header.count,
+            .sum = index->header.sum,
+            .xor_sum = index->header.xor_sum,
+        };
+
+        if(!storage_file_open(file_a, BROWSER_INDEX_TEMP_A, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS) ||
+           !storage_file_open(file_b, BROWSER_INDEX_TEMP_B, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        entry->flags = is_folder ? BROWSER_INDEX_FLAG_FOLDER : 0;
+        entry->size = name_size;
+        entry->file_size = is_folder ? 0 : file_size;
+        memcpy(entry->name, name, name_size + 1);
+
+        BrowserIndexRunHeader run = {};
+        browser_index_writer_init(writer, file_a);
+        if(!browser_index_writer_write(writer, &run, sizeof(run))) break;
+
+        browser_index_reader_init(
+            reader,
+            file,
+            sizeof(BrowserIndexHeader) + index->header.key_size,
+            index->header.table_offset);
+
+        bool pending = add;
+        bool changed = false;
+        uint32_t records_read = 0;
+        for(; records_read < index->header.count; records_read++) {
+            if(!browser_index_reader_next(reader, record)) break;
+
+            if(strcmp(record->name, entry->name) == 0) {
+                if(!add) {
+                    browser_index_signature_remove(
+                        &signature,
+                        record->name,
+                        record->flags & BROWSER_INDEX_FLAG_FOLDER,
+                        record->file_size);
+                    changed = true;
+                    continue;
+                }
+                // Already indexed
+                pending = false;
+            } else if(pending && browser_index_record_cmp(index, entry, record) < 0) {
+                if(!browser_index_writer_write_record(writer, entry)) break;
+                browser_index_signature_add(&signature, entry->name, is_folder, entry->file_size);
+                run.count++;
+                run.size += BROWSER_INDEX_RECORD_HEADER_SIZE + entry->size;
+                pending = false;
+                changed = true;
+            }
+
+            if(!browser_index_writer_write_record(writer, record)) break;
+            run.count++;
+            run.size += BROWSER_INDEX_RECORD_HEADER_SIZE + record->size;
+        }
+        if(records_read != index->header.count) break;
+
+        if(pending) {
+            if(!browser_index_writer_write_record(writer, entry)) break;
+            browser_index_signature_add(&signature, entry->name, is_folder, entry->file_size);
+            run.count++;
+            run.size += BROWSER_INDEX_RECORD_HEADER_SIZE + entry->size;
+            changed = true;
+        }
+        if(!changed) break;
+
+        if(!browser_index_writer_flush(writer) || !storage_file_seek(file_a, 0, true) ||
+           storage_file_write(file_a, &run, sizeof(run)) != sizeof(run)) {
+            break;
+        }
+        storage_file_close(file);
+
+        result = browser_index_write(index, work, file_a, writer->position, file_b, &signature);
+    } while(false);
+
+    storage_file_free(file);
+    storage_file_free(file_a);
+    storage_file_free(file_b);
+    storage_simply_remove(index->storage, BROWSER_INDEX_TEMP_A);
+    storage_simply_remove(index->storage, BROWSER_INDEX_TEMP_B);
+    free(work);
+
+    return result;
+}
+
+BrowserIndex* browser_index_alloc(BrowserIndexFilterCallback filter, void* context) {
+    BrowserIndex* index = malloc(sizeof(BrowserIndex));
+
+    index->storage = furi_record_open(RECORD_STORAGE);
+    index->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    index->filter = filter;
+    index->filter_context = context;
+    index->config = furi_string_alloc();
+    index->key = furi_string_alloc();
+    index->file_path = furi_string_alloc();
+
+    return index;
+}
+
+void browser_index_free(BrowserIndex* index) {
+    furi_assert(index);
+
+    furi_string_free(index->file_path);
+    furi_string_free(index->key);
+    furi_string_free(index->config);
+    furi_mutex_free(index->mutex);
+    furi_record_close(RECORD_STORAGE);
+
+    free(index);
+}
+
+void browser_index_set_config(BrowserIndex* index, const char* config, bool dirs_first) {
+    furi_assert(index);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_string_set(index->config, config);
+    index->dirs_first = dirs_first;
+    furi_mutex_release(index->mutex);
+}
+
+bool browser_index_sync(
+    BrowserIndex* index,
+    const char* path,
+    const BrowserIndexSignature* signature,
+    uint32_t* count) {
+    furi_assert(index);
+    furi_assert(signature);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+
+    File* file = storage_file_alloc(index->storage);
+    bool result = false;
+
+    if(browser_index_open(index, file, path) && index->header.count == signature->count &&
+       index->header.sum == signature->sum && index->header.xor_sum == signature->xor_sum) {
+        *count = index->header.count;
+        result = true;
+    } else {
+        if(storage_file_is_open(file)) {
+            storage_file_close(file);
+        }
+        result = browser_index_rebuild(index, path, count);
+    }
+
+    storage_file_free(file);
+    furi_mutex_release(index->mutex);
+    return result;
+}
+
+bool browser_index_find(
+    BrowserIndex* index,
+    const char* path,
+    const char* name,
+    bool is_folder,
+    int32_t* idx) {
+    furi_assert(index);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+
+    File* file = storage_file_alloc(index->storage);
+    const uint8_t flags = is_folder ? BROWSER_INDEX_FLAG_FOLDER : 0;
+    bool result = false;
+
+    if(browser_index_open(index, file, path)) {
+        uint32_t low = 0;
+        uint32_t high = index->header.count;
+        while(low < high) {
+            const uint32_t mid = low + (high - low) / 2;
+            if(!browser_index_seek(index, file, mid) ||
+               !browser_index_reader_next(&index->reader, &index->record)) {
+                break;
+            }
+
+            const int cmp =
+                browser_index_cmp(index, flags, name, index->record.flags, index->record.name);
+            if(cmp == 0) {
+                *idx = mid;
+                result = true;
+                break;
+            } else if(cmp < 0) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+    }
+
+    storage_file_free(file);
+    furi_mutex_release(index->mutex);
+    return result;
+}
+
+bool browser_index_load(
+    BrowserIndex* index,
+    const char* path,
+    uint32_t offset,
+    uint32_t count,
+    BrowserIndexItemCallback callback,
+    void* context) {
+    furi_assert(index);
+    furi_assert(callback);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+
+    File* file = storage_file_alloc(index->storage);
+    bool result = false;
+
+    if(browser_index_open(index, file, path) && offset <= index->header.count) {
+        const uint32_t end = offset + MIN(count, index->header.count - offset);
+        // Records are stored in order, only the first one is looked up in the table
+        result = (offset == end) || browser_index_seek(index, file, offset);
+        for(uint32_t idx = offset; result && idx < end; idx++) {
+            result = browser_index_reader_next(&index->reader, &index->record);
+            if(result) {
+                callback(
+                    context,
+                    index->record.name,
+                    index->record.flags & BROWSER_INDEX_FLAG_FOLDER,
+                    idx);
+            }
+        }
+    }
+
+    storage_file_free(file);
+    furi_mutex_release(index->mutex);
+    return result;
+}
+
+bool browser_index_add(
+    BrowserIndex* index,
+    const char* path,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size) {
+    furi_assert(index);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+    const bool result = browser_index_patch(index, path, name, is_folder, file_size, true);
+    furi_mutex_release(index->mutex);
+    return result;
+}
+
+bool browser_index_remove(BrowserIndex* index, const char* path, const char* name) {
+    furi_assert(index);
+    furi_check(furi_mutex_acquire(index->mutex, FuriWaitForever) == FuriStatusOk);
+    const bool result = browser_index_patch(index, path, name, false, 0, false);
+    furi_mutex_release(index->mutex);
+    return result;
+}
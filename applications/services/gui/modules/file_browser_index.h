@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Persistent directory index for the file browser worker.
+ *
+ * Index file keeps filtered directory entries sorted by name (folders first if configured) and
+ * a table of record offsets, so entry N is read without walking the directory. Indexes live in
+ * /ext/.dircache, one file per directory and filter configuration.
+ *
+ * FAT has no reliable directory modification time, so the directory is scanned on every visit
+ * and an order-independent signature of its entries (count and hashes of names, types and sizes)
+ * is compared with the one saved in the index. The index is rebuilt only if they differ.
+ */
+
+typedef struct BrowserIndex BrowserIndex;
+
+typedef struct {
+    uint32_t count;
+    uint32_t sum;
+    uint32_t xor_sum;
+} BrowserIndexSignature;
+
+typedef bool (*BrowserIndexFilterCallback)(void* context, const char* name, bool is_folder);
+
+typedef void (*BrowserIndexItemCallback)(
+    void* context,
+    const char* name,
+    bool is_folder,
+    uint32_t idx);
+
+void browser_index_signature_reset(BrowserIndexSignature* signature);
+
+void browser_index_signature_add(
+    BrowserIndexSignature* signature,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size);
+
+/**
+ * Allocate BrowserIndex
+ * @param filter Filter applied to directory entries when the index is rebuilt
+ * @param context Filter context
+ * @return BrowserIndex instance
+ */
+BrowserIndex* browser_index_alloc(BrowserIndexFilterCallback filter, void* context);
+
+void browser_index_free(BrowserIndex* index);
+
+/**
+ * Set filter configuration, indexes with other configuration are not used
+ * @param index BrowserIndex instance
+ * @param config String describing the filter
+ * @param dirs_first Sort folders before files
+ */
+void browser_index_set_config(BrowserIndex* index, const char* config, bool dirs_first);
+
+/**
+ * Validate the directory index against the signature of a directory scan, rebuild if needed
+ * @param index BrowserIndex instance
+ * @param path Directory path
+ * @param signature Signature of filtered directory entries
+ * @param count Number of entries
+ * @return true if the index can be used
+ */
+bool browser_index_sync(
+    BrowserIndex* index,
+    const char* path,
+    const BrowserIndexSignature* signature,
+    uint32_t* count);
+
+/**
+ * Find entry position
+ * @param index BrowserIndex instance
+ * @param path Directory path
+ * @param name Entry name
+ * @param is_folder Entry is a folder
+ * @param idx Entry position
+ * @return true if the entry is found
+ */
+bool browser_index_find(
+    BrowserIndex* index,
+    const char* path,
+    const char* name,
+    bool is_folder,
+    int32_t* idx);
+
+/**
+ * Read entries
+ * @param index BrowserIndex instance
+ * @param path Directory path
+ * @param offset First entry position
+ * @param count Number of entries to read
+ * @param callback Called for each entry
+ * @param context Callback context
+ * @return true on success
+ */
+bool browser_index_load(
+    BrowserIndex* index,
+    const char* path,
+    uint32_t offset,
+    uint32_t count,
+    BrowserIndexItemCallback callback,
+    void* context);
+
+/**
+ * Insert an entry into an existing directory index
+ * @param index BrowserIndex instance
+ * @param path Directory path
+ * @param name Entry name
+ * @param is_folder Entry is a folder
+ * @param file_size Entry size
+ * @return true if the index was updated
+ */
+bool browser_index_add(
+    BrowserIndex* index,
+    const char* path,
+    const char* name,
+    bool is_folder,
+    uint32_t file_size);
+
+/**
+ * Remove an entry from an existing directory index
+ * @param index BrowserIndex instance
+ * @param path Directory path
+ * @param name Entry name
+ * @return true if the index was updated
+ */
+bool browser_index_remove(BrowserIndex* index, const char* path, const char* name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "file_browser_worker.h"
+#include "file_browser_index.h"
 
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
@@ -7,6 +8,7 @@
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
+#include <cfw.h>
 
 #include <m-array.h>
 #include <stdbool.h>
@@ -48,6 +50,10 @@ struct BrowserWorker {
     bool hide_dot_files;
     idx_last_array_t idx_last;
 
+    BrowserIndex* index;
+    FuriString* index_name;
+    bool index_active;
+
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
     BrowserWorkerListLoadCallback list_load_cb;
@@ -107,6 +113,52 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     return false;
 }
 
+static bool browser_index_filter_cb(void* context, const char* name, bool is_folder) {
+    BrowserWorker* browser = context;
+    furi_string_set(browser->index_name, name);
+    return browser_filter_by_name(browser, browser->index_name, is_folder);
+}
+
+static void browser_index_item_cb(void* context, const char* name, bool is_folder, uint32_t idx) {
+    BrowserWorker* browser = context;
+    furi_string_printf(
+        browser->index_name, "%s/%s", furi_string_get_cstr(browser->path_current), name);
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, browser->index_name, idx, is_folder, false);
+    }
+}
+
+static void browser_index_update_config(BrowserWorker* browser) {
+    FuriString* config = furi_string_alloc_printf(
+        "%s\n%u%u",
+        furi_string_get_cstr(browser->filter_extension),
+        browser->skip_assets,
+        browser->hide_dot_files);
+    browser_index_set_config(
+        browser->index, furi_string_get_cstr(config), CFW_SETTINGS()->sort_dirs_first);
+    furi_string_free(config);
+}
+
+// Index files are kept on SD card, so only folders there are indexed
+static bool browser_path_is_indexable(FuriString* path) {
+    return furi_string_start_with_str(path, STORAGE_EXT_PATH_PREFIX);
+}
+
+static void browser_index_find_file(
+    BrowserWorker* browser,
+    FuriString* path,
+    FuriString* filename,
+    int32_t* file_idx) {
+    if(!furi_string_empty(filename)) {
+        browser_index_find(
+            browser->index,
+            furi_string_get_cstr(path),
+            furi_string_get_cstr(filename),
+            false,
+            file_idx);
+    }
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -142,6 +194,14 @@ static bool browser_folder_init(
     FileInfo file_info;
     uint32_t total_files_cnt = 0;
 
+    *item_cnt = 0;
+    *file_idx = -1;
+    browser->index_active = false;
+
+    const bool indexable = browser_path_is_indexable(path);
+    BrowserIndexSignature signature;
+    browser_index_signature_reset(&signature);
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
 
@@ -149,9 +209,6 @@ static bool browser_folder_init(
     FuriString* name_str;
     name_str = furi_string_alloc();
 
-    *item_cnt = 0;
-    *file_idx = -1;
-
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
         while(1) {
@@ -168,6 +225,11 @@ static bool browser_folder_init(
                         }
                     }
                     (*item_cnt)++;
+                    browser_index_signature_add(
+                        &signature,
+                        name_temp,
+                        file_info_is_dir(&file_info),
+                        file_info_is_dir(&file_info) ? 0 : file_info.size);
                 }
                 if(total_files_cnt == LONG_LOAD_THRESHOLD) {
                     // There are too many files in folder and counting them will take some time - send callback to app
@@ -186,9 +248,37 @@ static bool browser_folder_init(
 
     furi_record_close(RECORD_STORAGE);
 
+    if(state && indexable && (*item_cnt > BROWSER_SORT_THRESHOLD) &&
+       browser_index_sync(browser->index, furi_string_get_cstr(path), &signature, item_cnt)) {
+        // Positions in the index differ from the directory order
+        browser->index_active = true;
+        *file_idx = -1;
+        browser_index_find_file(browser, path, filename, file_idx);
+    }
+
     return state;
 }
 
+// Load files list from the folder index: sorted, and any chunk is read without walking the folder
+static bool browser_folder_load_index(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    if(browser->list_load_cb) {
+        browser->list_load_cb(browser->cb_ctx, offset);
+    }
+
+    bool ret = browser_index_load(
+        browser->index, furi_string_get_cstr(path), offset, count, browser_index_item_cb, browser);
+
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, NULL, 0, false, true);
+    }
+
+    return ret;
+}
+
 // Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
@@ -346,6 +436,7 @@ static int32_t browser_worker(void* context) {
                 path_extract_filename(browser->path_next, filename, false);
             }
             idx_last_array_reset(browser->idx_last);
+            browser_index_update_config(browser);
 
             furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtFolderEnter);
         }
@@ -414,7 +505,14 @@ static int32_t browser_worker(void* context) {
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
-            if(items_cnt > BROWSER_SORT_THRESHOLD) {
+            if(browser->index_active) {
+                if(items_cnt > BROWSER_SORT_THRESHOLD) {
+                    browser_folder_load_index(
+                        browser, path, browser->load_offset, browser->load_count);
+                } else {
+                    browser_folder_load_index(browser, path, 0, items_cnt);
+                }
+            } else if(items_cnt > BROWSER_SORT_THRESHOLD) {
                 browser_folder_load_chunked(
                     browser, path, browser->load_offset, browser->load_count);
             } else {
@@ -457,6 +555,9 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    browser->index_name = furi_string_alloc();
+    browser->index = browser_index_alloc(browser_index_filter_cb, browser);
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
@@ -475,6 +576,9 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_string_free(browser->path_current);
     furi_string_free(browser->path_start);
 
+    browser_index_free(browser->index);
+    furi_string_free(browser->index_name);
+
     idx_last_array_clear(browser->idx_last);
 
     free(browser);
@@ -550,6 +654,48 @@ void file_browser_worker_folder_refresh(BrowserWorker* browser, int32_t item_idx
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtFolderRefresh);
 }
 
+void file_browser_worker_index_add(BrowserWorker* browser, const char* path) {
+    furi_assert(browser);
+    FuriString* folder = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    FileInfo file_info;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool exists = (storage_common_stat(storage, path, &file_info) == FSE_OK);
+    furi_record_close(RECORD_STORAGE);
+
+    path_extract_dirname(path, folder);
+    path_extract_basename(path, name);
+    if(exists && browser_path_is_indexable(folder) &&
+       browser_filter_by_name(browser, name, file_info_is_dir(&file_info))) {
+        browser_index_add(
+            browser->index,
+            furi_string_get_cstr(folder),
+            furi_string_get_cstr(name),
+            file_info_is_dir(&file_info),
+            file_info.size);
+    }
+
+    furi_string_free(name);
+    furi_string_free(folder);
+}
+
+void file_browser_worker_index_remove(BrowserWorker* browser, const char* path) {
+    furi_assert(browser);
+    FuriString* folder = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    path_extract_dirname(path, folder);
+    path_extract_basename(path, name);
+    if(browser_path_is_indexable(folder)) {
+        browser_index_remove(
+            browser->index, furi_string_get_cstr(folder), furi_string_get_cstr(name));
+    }
+
+    furi_string_free(name);
+    furi_string_free(folder);
+}
+
 void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t count) {
     furi_assert(browser);
     browser->load_offset = offset;
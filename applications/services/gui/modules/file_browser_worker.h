@@ -68,6 +68,12 @@ void file_browser_worker_folder_refresh(BrowserWorker* browser, int32_t item_idx
 
 void file_browser_worker_load(BrowserWorker* browser, uint32_t offset, uint32_t count);
 
+/** Update the folder index after a file or folder was created, so it is not rebuilt on refresh */
+void file_browser_worker_index_add(BrowserWorker* browser, const char* path);
+
+/** Update the folder index after a file or folder was removed, so it is not rebuilt on refresh */
+void file_browser_worker_index_remove(BrowserWorker* browser, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
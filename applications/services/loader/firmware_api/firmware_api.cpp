@@ -7,6 +7,9 @@
 #include <firmware_api_table.h>
 
 #include <furi_hal_info.h>
+#include <furi.h>
+
+#define TAG "FirmwareApi"
 
 static_assert(!has_hash_collisions(elf_api_table), "Detected API method hash collision!");
 
@@ -23,14 +26,46 @@ constexpr HashtableApiInterface mock_elf_api_interface{
 
 const ElfApiInterface* const firmware_api_interface = &mock_elf_api_interface;
 #else
+/* Firmware table ordered by sym_hash_key, with a bucket index on top.
+ * Internal to the firmware: plugin API tables keep the raw hash order of
+ * the exported elf_resolve_from_hashtable.
+ */
+static constexpr auto elf_api_bucketed_table = sort_sym_table_by_key(elf_api_table);
+static constexpr auto elf_api_bucket_index = make_sym_bucket_index(elf_api_bucketed_table);
+static constexpr uint8_t elf_api_bucket_shift = 32 - sym_bucket_bits(elf_api_table.size());
+
+static bool elf_resolve_from_firmware_api(
+    const ElfApiInterface* interface,
+    uint32_t hash,
+    Elf32_Addr* address) {
+    UNUSED(interface);
+    const uint16_t* bucket = &elf_api_bucket_index[sym_hash_key(hash) >> elf_api_bucket_shift];
+    const sym_entry* table_begin = elf_api_bucketed_table.cbegin() + bucket[0];
+    const sym_entry* table_end = elf_api_bucketed_table.cbegin() + bucket[1];
+
+    sym_entry key = {
+        .hash = hash,
+        .address = 0,
+    };
+
+    auto find_res = std::lower_bound(table_begin, table_end, key, sym_key_less);
+    if(find_res == table_end || find_res->hash != hash) {
+        FURI_LOG_W(TAG, "Can't find symbol with hash %lx!", hash);
+        return false;
+    }
+
+    *address = find_res->address;
+    return true;
+}
+
 constexpr HashtableApiInterface elf_api_interface{
     {
         .api_version_major = (elf_api_version >> 16),
         .api_version_minor = (elf_api_version & 0xFFFF),
-        .resolver_callback = &elf_resolve_from_hashtable,
+        .resolver_callback = &elf_resolve_from_firmware_api,
     },
-    .table_cbegin = elf_api_table.cbegin(),
-    .table_cend = elf_api_table.cend(),
+    .table_cbegin = elf_api_bucketed_table.cbegin(),
+    .table_cend = elf_api_bucketed_table.cend(),
 };
 const ElfApiInterface* const firmware_api_interface = &elf_api_interface;
 #endif
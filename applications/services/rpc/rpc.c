@@ -83,6 +83,7 @@ struct RpcSession {
     RpcSessionClosedCallback closed_callback;
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
+    uint32_t features;
     bool status;
     void* context;
 };
@@ -96,6 +97,16 @@ RpcOwner rpc_session_get_owner(RpcSession* session) {
     return session->owner;
 }
 
+void rpc_session_enable_feature(RpcSession* session, RpcSessionFeature feature) {
+    furi_assert(session);
+    session->features |= feature;
+}
+
+bool rpc_session_has_feature(RpcSession* session, RpcSessionFeature feature) {
+    furi_assert(session);
+    return (session->features & feature) != 0;
+}
+
 static void rpc_close_session_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -384,6 +395,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->terminate = false;
     session->decode_error = false;
     session->owner = owner;
+    session->features = 0;
     RpcHandlerDict_init(session->handlers);
 
     session->decoded_message = malloc(sizeof(PB_Main));
@@ -1,6 +1,8 @@
 #include <cli/cli.h>
 #include <furi.h>
 #include <rpc/rpc.h>
+#include <toolbox/args.h>
+#include "rpc_i.h"
 #include <furi_hal.h>
 #include <semphr.h>
 
@@ -38,7 +40,6 @@ static void rpc_cli_session_terminated_callback(void* context) {
 }
 
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
-    UNUSED(args);
     furi_assert(cli);
     furi_assert(context);
     Rpc* rpc = context;
@@ -54,6 +55,15 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
         return;
     }
 
+    // Clients that understand compressed screen frames ask for them on session start
+    FuriString* feature = furi_string_alloc();
+    while(args_read_string_and_trim(args, feature)) {
+        if(furi_string_cmp_str(feature, "compressed_screen") == 0) {
+            rpc_session_enable_feature(rpc_session, RpcSessionFeatureScreenStreamCompression);
+        }
+    }
+    furi_string_free(feature);
+
     CliRpc cli_rpc = {.cli = cli, .session_close_request = false};
     cli_rpc.terminate_semaphore = furi_semaphore_alloc(1, 0);
     rpc_session_set_context(rpc_session, &cli_rpc);
@@ -1,5 +1,6 @@
 #include "flipper.pb.h"
 #include "rpc_i.h"
+#include "rpc_gui_frame.h"
 #include "gui.pb.h"
 #include <gui/gui_i.h>
 #include <desktop/desktop_settings.h>
@@ -16,6 +17,9 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+#define RPC_GUI_KEYFRAME_INTERVAL (32u)
+#define RPC_GUI_STATS_PERIOD_MS (1000u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -27,6 +31,21 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    FuriMutex* transmit_mutex;
+    // Latest frame from GUI, guarded by transmit_mutex
+    uint8_t* pending_frame;
+    CanvasOrientation pending_orientation;
+    bool pending;
+    bool posted;
+    // Last sent frame for delta frames, NULL if compression is off
+    uint8_t* reference_frame;
+    uint32_t keyframe_countdown;
+
+    // Stream statistics
+    uint32_t frames_sent;
+    uint32_t frames_skipped;
+    uint32_t bytes_sent;
+    uint32_t bytes_per_second;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -56,38 +75,102 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    // Nothing to send if the frame did not change
+    if(rpc_gui->reference_frame && rpc_gui->posted &&
+       gui_get_framebuffer_damage(rpc_gui->gui)->pages == 0 &&
+       rpc_gui->pending_orientation == orientation) {
+        furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
+        return;
+    }
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+    // Transmit thread is behind, previous frame is dropped
+    if(rpc_gui->pending) rpc_gui->frames_skipped++;
+    memcpy(rpc_gui->pending_frame, data, size);
+    rpc_gui->pending_orientation = orientation;
+    rpc_gui->pending = true;
+    rpc_gui->posted = true;
+    furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
 
     furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
 }
 
+// Move pending frame to the transmit frame, returns false if there is none
+static bool rpc_system_gui_screen_stream_prepare_frame(RpcGuiSystem* rpc_gui) {
+    PB_Gui_ScreenFrame* screen_frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
+
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    bool pending = rpc_gui->pending;
+
+    if(pending) {
+        screen_frame->orientation =
+            rpc_system_gui_screen_orientation_map[rpc_gui->pending_orientation];
+
+        if(rpc_gui->reference_frame) {
+            const bool keyframe = (rpc_gui->keyframe_countdown == 0);
+            screen_frame->data->size = rpc_gui_frame_encode(
+                rpc_gui->pending_frame,
+                keyframe ? NULL : rpc_gui->reference_frame,
+                framebuffer_size,
+                screen_frame->data->bytes);
+            memcpy(rpc_gui->reference_frame, rpc_gui->pending_frame, framebuffer_size);
+            rpc_gui->keyframe_countdown =
+                keyframe ? RPC_GUI_KEYFRAME_INTERVAL : rpc_gui->keyframe_countdown - 1;
+        } else {
+            memcpy(screen_frame->data->bytes, rpc_gui->pending_frame, framebuffer_size);
+            screen_frame->data->size = framebuffer_size;
+        }
+
+        rpc_gui->pending = false;
+    }
+
+    furi_check(furi_mutex_release(rpc_gui->transmit_mutex) == FuriStatusOk);
+    return pending;
+}
+
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
 
     uint32_t transmit_time = 0;
+    uint32_t stats_time = furi_get_tick();
+    uint32_t stats_bytes = 0;
     while(true) {
         uint32_t flags =
             furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
 
-        if(flags & RpcGuiWorkerFlagTransmit) {
+        if((flags & RpcGuiWorkerFlagTransmit) &&
+           rpc_system_gui_screen_stream_prepare_frame(rpc_gui)) {
             transmit_time = furi_get_tick();
             rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
             transmit_time = furi_get_tick() - transmit_time;
 
+            rpc_gui->frames_sent++;
+            rpc_gui->bytes_sent += rpc_gui->transmit_frame->content.gui_screen_frame.data->size;
+
             // Guaranteed bandwidth reserve
             uint32_t extra_delay = transmit_time / 20;
             if(extra_delay > 500) extra_delay = 500;
             if(extra_delay) furi_delay_tick(extra_delay);
         }
 
+        uint32_t stats_elapsed = furi_get_tick() - stats_time;
+        if(stats_elapsed >= furi_ms_to_ticks(RPC_GUI_STATS_PERIOD_MS)) {
+            rpc_gui->bytes_per_second = (uint64_t)(rpc_gui->bytes_sent - stats_bytes) *
+                                        furi_kernel_get_tick_frequency() / stats_elapsed;
+            FURI_LOG_D(
+                TAG,
+                "Stream: %lu B/s, %lu frames sent, %lu skipped",
+                rpc_gui->bytes_per_second,
+                rpc_gui->frames_sent,
+                rpc_gui->frames_skipped);
+            stats_time += stats_elapsed;
+            stats_bytes = rpc_gui->bytes_sent;
+        }
+
         if(flags & RpcGuiWorkerFlagExit) {
             break;
         }
@@ -114,13 +197,27 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
 
         rpc_gui->is_streaming = true;
         size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
+        bool compressed =
+            rpc_session_has_feature(session, RpcSessionFeatureScreenStreamCompression);
+        size_t frame_size =
+            compressed ? RPC_GUI_FRAME_MAX_SIZE(framebuffer_size) : framebuffer_size;
         // Reusable Frame
         rpc_gui->transmit_frame = malloc(sizeof(PB_Main));
         rpc_gui->transmit_frame->which_content = PB_Main_gui_screen_frame_tag;
         rpc_gui->transmit_frame->command_status = PB_CommandStatus_OK;
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
-            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(frame_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        rpc_gui->transmit_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        rpc_gui->pending_frame = malloc(framebuffer_size);
+        rpc_gui->pending = false;
+        rpc_gui->posted = false;
+        rpc_gui->reference_frame = compressed ? malloc(framebuffer_size) : NULL;
+        rpc_gui->keyframe_countdown = 0;
+        rpc_gui->frames_sent = 0;
+        rpc_gui->frames_skipped = 0;
+        rpc_gui->bytes_sent = 0;
+        rpc_gui->bytes_per_second = 0;
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -154,6 +251,10 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        furi_mutex_free(rpc_gui->transmit_mutex);
+        free(rpc_gui->pending_frame);
+        free(rpc_gui->reference_frame);
+        rpc_gui->reference_frame = NULL;
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -496,6 +597,10 @@ void rpc_system_gui_free(void* context) {
         pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
         free(rpc_gui->transmit_frame);
         rpc_gui->transmit_frame = NULL;
+        furi_mutex_free(rpc_gui->transmit_mutex);
+        free(rpc_gui->pending_frame);
+        free(rpc_gui->reference_frame);
+        rpc_gui->reference_frame = NULL;
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
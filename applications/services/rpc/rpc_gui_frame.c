@@ -0,0 +1,121 @@
+#include "rpc_gui_frame.h"
+
+#include <string.h>
+
+#define RPC_GUI_FRAME_RUN_FLAG 0x80U
+#define RPC_GUI_FRAME_MAX_CHUNK 128U
+
+static inline uint8_t
+    rpc_gui_frame_get(const uint8_t* frame, const uint8_t* reference, size_t index) {
+    return reference ? (frame[index] ^ reference[index]) : frame[index];
+}
+
+// Returns 0 if the encoded data does not fit into the limit
+static size_t rpc_gui_frame_rle_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* output,
+    size_t limit) {
+    size_t index = 0;
+    size_t written = 0;
+
+    while(index < size) {
+        const uint8_t value = rpc_gui_frame_get(frame, reference, index);
+        size_t run = 1;
+        while(index + run < size && run < RPC_GUI_FRAME_MAX_CHUNK &&
+              rpc_gui_frame_get(frame, reference, index + run) == value) {
+            run++;
+        }
+
+        if(run > 1) {
+            if(written + 2 > limit) return 0;
+            output[written++] = RPC_GUI_FRAME_RUN_FLAG | (run - 1);
+            output[written++] = value;
+            index += run;
+        } else {
+            // Literal ends where a run of at least two bytes starts
+            size_t length = 1;
+            while(index + length < size && length < RPC_GUI_FRAME_MAX_CHUNK) {
+                if(index + length + 1 < size &&
+                   rpc_gui_frame_get(frame, reference, index + length) ==
+                       rpc_gui_frame_get(frame, reference, index + length + 1)) {
+                    break;
+                }
+                length++;
+            }
+
+            if(written + 1 + length > limit) return 0;
+            output[written++] = length - 1;
+            for(size_t i = 0; i < length; i++) {
+                output[written++] = rpc_gui_frame_get(frame, reference, index + i);
+            }
+            index += length;
+        }
+    }
+
+    return written;
+}
+
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* output) {
+    size_t encoded_size = rpc_gui_frame_rle_encode(
+        frame, reference, size, output + RPC_GUI_FRAME_HEADER_SIZE, size);
+
+    if(encoded_size) {
+        output[0] = reference ? RpcGuiFrameTypeDelta : RpcGuiFrameTypeKey;
+    } else {
+        output[0] = RpcGuiFrameTypeRaw;
+        memcpy(output + RPC_GUI_FRAME_HEADER_SIZE, frame, size);
+        encoded_size = size;
+    }
+
+    return encoded_size + RPC_GUI_FRAME_HEADER_SIZE;
+}
+
+bool rpc_gui_frame_decode(const uint8_t* data, size_t data_size, uint8_t* frame, size_t size) {
+    if(data_size < RPC_GUI_FRAME_HEADER_SIZE) return false;
+
+    const uint8_t type = data[0];
+    data += RPC_GUI_FRAME_HEADER_SIZE;
+    data_size -= RPC_GUI_FRAME_HEADER_SIZE;
+
+    if(type == RpcGuiFrameTypeRaw) {
+        if(data_size != size) return false;
+        memcpy(frame, data, size);
+        return true;
+    } else if(type != RpcGuiFrameTypeKey && type != RpcGuiFrameTypeDelta) {
+        return false;
+    }
+
+    const bool delta = (type == RpcGuiFrameTypeDelta);
+    size_t index = 0;
+    size_t read = 0;
+
+    while(read < data_size) {
+        const uint8_t control = data[read++];
+
+        if(control & RPC_GUI_FRAME_RUN_FLAG) {
+            const size_t run = (control & ~RPC_GUI_FRAME_RUN_FLAG) + 1;
+            if(read >= data_size || index + run > size) return false;
+            const uint8_t value = data[read++];
+            for(size_t i = 0; i < run; i++) {
+                frame[index] = delta ? (frame[index] ^ value) : value;
+                index++;
+            }
+        } else {
+            const size_t length = control + 1;
+            if(read + length > data_size || index + length > size) return false;
+            for(size_t i = 0; i < length; i++) {
+                frame[index] = delta ? (frame[index] ^ data[read]) : data[read];
+                index++;
+                read++;
+            }
+        }
+    }
+
+    return index == size;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compressed screen frames.
+ *
+ * StartScreenStreamRequest has no fields, so clients that understand compressed frames ask for
+ * them when the session is started: "start_rpc_session compressed_screen". ScreenFrame data
+ * then starts with a RpcGuiFrameType byte. Key and delta frames are run-length encoded: control
+ * byte with the top bit set is a run of (low bits + 1) copies of the next byte, otherwise
+ * (control byte + 1) literal bytes follow.
+ * Delta frames carry the XOR with the previous frame, so unchanged areas become long zero runs.
+ */
+
+typedef enum {
+    RpcGuiFrameTypeRaw = 0x00, /**< Uncompressed frame */
+    RpcGuiFrameTypeKey = 0x01, /**< Run-length encoded frame */
+    RpcGuiFrameTypeDelta = 0x02, /**< Run-length encoded XOR with the previous frame */
+} RpcGuiFrameType;
+
+#define RPC_GUI_FRAME_HEADER_SIZE 1U
+
+/** Size of the output buffer required to encode a frame of the given size */
+#define RPC_GUI_FRAME_MAX_SIZE(size) ((size) + RPC_GUI_FRAME_HEADER_SIZE)
+
+/**
+ * Encode a frame. Raw frame is produced if compression does not pay off.
+ * @param frame Frame to encode
+ * @param reference Previous frame for a delta frame, NULL for a key frame
+ * @param size Frame size
+ * @param output Output buffer of RPC_GUI_FRAME_MAX_SIZE(size) bytes
+ * @return Encoded size
+ */
+size_t rpc_gui_frame_encode(
+    const uint8_t* frame,
+    const uint8_t* reference,
+    size_t size,
+    uint8_t* output);
+
+/**
+ * Decode a frame.
+ * @param data Encoded frame
+ * @param data_size Encoded frame size
+ * @param frame Previous frame, replaced with the decoded one
+ * @param size Frame size
+ * @return true On success, false if data is malformed
+ */
+bool rpc_gui_frame_decode(const uint8_t* data, size_t data_size, uint8_t* frame, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
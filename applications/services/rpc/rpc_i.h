@@ -7,6 +7,11 @@
 #include <flipper.pb.h>
 #include <cli/cli.h>
 
+/** Optional behaviour the client asked for when the session was started */
+typedef enum {
+    RpcSessionFeatureScreenStreamCompression = (1 << 0), /**< Compressed ScreenFrame data */
+} RpcSessionFeature;
+
 typedef void* (*RpcSystemAlloc)(RpcSession* session);
 typedef void (*RpcSystemFree)(void* context);
 typedef void (*PBMessageHandler)(const PB_Main* msg_request, void* context);
@@ -25,6 +30,10 @@ void rpc_send_and_release_empty(RpcSession* session, uint32_t command_id, PB_Com
 
 void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* handler);
 
+void rpc_session_enable_feature(RpcSession* session, RpcSessionFeature feature);
+
+bool rpc_session_has_feature(RpcSession* session, RpcSessionFeature feature);
+
 void* rpc_system_system_alloc(RpcSession* session);
 void* rpc_system_storage_alloc(RpcSession* session);
 void rpc_system_storage_free(void* ctx);
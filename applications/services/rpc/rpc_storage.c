@@ -18,6 +18,13 @@
 #define MAX_NAME_LENGTH 255
 
 static const size_t MAX_DATA_SIZE = 512;
+// USB link is fast enough to benefit from larger messages
+static const size_t MAX_DATA_SIZE_USB = 4096;
+
+#define RPC_STORAGE_READ_BUFFER_COUNT (2U)
+// Reads may run FatFS on the reader stack, so it matches the storage thread
+#define RPC_STORAGE_READER_STACK_SIZE (3 * 1024U)
+#define RPC_STORAGE_WRITE_BUFFER_SIZE (4096U)
 
 typedef enum {
     RpcStorageStateIdle = 0,
@@ -30,8 +37,44 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    size_t data_size;
+    // Small write chunks are collected here before going to the file
+    uint8_t* write_buffer;
+    size_t write_buffer_used;
 } RpcStorageSystem;
 
+typedef struct {
+    File* file;
+    size_t size_left;
+    size_t data_size;
+    FuriMessageQueue* free_queue;
+    FuriMessageQueue* filled_queue;
+} RpcStorageReader;
+
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    size_t size = rpc_storage->write_buffer_used;
+    rpc_storage->write_buffer_used = 0;
+    if(!size) return true;
+    return storage_file_write(rpc_storage->file, rpc_storage->write_buffer, size) == size;
+}
+
+static bool rpc_system_storage_write_buffered(
+    RpcStorageSystem* rpc_storage,
+    const uint8_t* data,
+    size_t size) {
+    if(rpc_storage->write_buffer_used + size > RPC_STORAGE_WRITE_BUFFER_SIZE) {
+        if(!rpc_system_storage_write_flush(rpc_storage)) return false;
+    }
+
+    if(size >= RPC_STORAGE_WRITE_BUFFER_SIZE) {
+        return storage_file_write(rpc_storage->file, data, size) == size;
+    }
+
+    memcpy(rpc_storage->write_buffer + rpc_storage->write_buffer_used, data, size);
+    rpc_storage->write_buffer_used += size;
+    return true;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -48,9 +91,16 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            // Keep what was received, as if chunks were written right away
+            if(storage_file_is_open(rpc_storage->file)) {
+                rpc_system_storage_write_flush(rpc_storage);
+            }
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
+            free(rpc_storage->write_buffer);
+            rpc_storage->write_buffer = NULL;
+            rpc_storage->write_buffer_used = 0;
         }
 
         rpc_storage->state = RpcStorageStateIdle;
@@ -354,6 +404,109 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_record_close(RECORD_STORAGE);
 }
 
+// Reads file ahead, so that SD access overlaps with sending of the previous chunk
+static int32_t rpc_system_storage_read_worker(void* context) {
+    RpcStorageReader* reader = context;
+
+    while(reader->size_left) {
+        pb_bytes_array_t* data;
+        furi_check(
+            furi_message_queue_get(reader->free_queue, &data, FuriWaitForever) == FuriStatusOk);
+
+        const size_t read_size = MIN(reader->size_left, reader->data_size);
+        const size_t size_read = storage_file_read(reader->file, data->bytes, read_size);
+        data->size = size_read;
+        furi_check(
+            furi_message_queue_put(reader->filled_queue, &data, FuriWaitForever) ==
+            FuriStatusOk);
+
+        if(size_read != read_size) break;
+        reader->size_left -= read_size;
+    }
+
+    return 0;
+}
+
+static void rpc_system_storage_read_send(
+    RpcSession* session,
+    PB_Main* response,
+    uint32_t command_id,
+    pb_bytes_array_t* data,
+    bool has_next) {
+    response->command_id = command_id;
+    response->which_content = PB_Main_storage_read_response_tag;
+    response->command_status = PB_CommandStatus_OK;
+    response->has_next = has_next;
+    response->content.storage_read_response.has_file = true;
+    response->content.storage_read_response.file.data = data;
+    // Data buffer is owned by the caller and reused for the next chunk
+    rpc_send(session, response);
+    response->content.storage_read_response.file.data = NULL;
+}
+
+static bool rpc_system_storage_read_chunked(
+    RpcStorageSystem* rpc_storage,
+    File* file,
+    size_t size,
+    PB_Main* response,
+    uint32_t command_id) {
+    RpcStorageReader reader = {
+        .file = file,
+        .size_left = size,
+        .data_size = rpc_storage->data_size,
+        .free_queue =
+            furi_message_queue_alloc(RPC_STORAGE_READ_BUFFER_COUNT, sizeof(pb_bytes_array_t*)),
+        .filled_queue =
+            furi_message_queue_alloc(RPC_STORAGE_READ_BUFFER_COUNT, sizeof(pb_bytes_array_t*)),
+    };
+
+    pb_bytes_array_t* buffers[RPC_STORAGE_READ_BUFFER_COUNT];
+    for(size_t i = 0; i < RPC_STORAGE_READ_BUFFER_COUNT; i++) {
+        buffers[i] = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(reader.data_size));
+        furi_check(
+            furi_message_queue_put(reader.free_queue, &buffers[i], FuriWaitForever) ==
+            FuriStatusOk);
+    }
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "RpcStorageReader",
+        RPC_STORAGE_READER_STACK_SIZE,
+        rpc_system_storage_read_worker,
+        &reader);
+    furi_thread_start(thread);
+
+    bool success = true;
+    size_t size_left = size;
+    while(size_left) {
+        pb_bytes_array_t* data;
+        furi_check(
+            furi_message_queue_get(reader.filled_queue, &data, FuriWaitForever) == FuriStatusOk);
+
+        const size_t read_size = MIN(size_left, reader.data_size);
+        if(data->size != read_size) {
+            success = false;
+            break;
+        }
+
+        size_left -= read_size;
+        rpc_system_storage_read_send(
+            rpc_storage->session, response, command_id, data, size_left > 0);
+        furi_check(
+            furi_message_queue_put(reader.free_queue, &data, FuriWaitForever) == FuriStatusOk);
+    }
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    for(size_t i = 0; i < RPC_STORAGE_READ_BUFFER_COUNT; i++) {
+        free(buffers[i]);
+    }
+    furi_message_queue_free(reader.filled_queue);
+    furi_message_queue_free(reader.free_queue);
+
+    return success;
+}
+
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -375,38 +528,21 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(fs_operation_success) {
-        size_t size_left = storage_file_size(file);
-        do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
-            }
+        const size_t size = storage_file_size(file);
 
+        if(size > rpc_storage->data_size) {
+            fs_operation_success = rpc_system_storage_read_chunked(
+                rpc_storage, file, size, response, request->command_id);
+        } else {
+            // Single chunk, nothing to overlap with
+            pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(size));
+            data->size = storage_file_read(file, data->bytes, size);
+            fs_operation_success = (data->size == size);
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_system_storage_read_send(session, response, request->command_id, data, false);
             }
-        } while((size_left != 0) && fs_operation_success);
+            free(data);
+        }
     }
 
     if(!fs_operation_success) {
@@ -452,6 +588,8 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
+        rpc_storage->write_buffer = malloc(RPC_STORAGE_WRITE_BUFFER_SIZE);
+        rpc_storage->write_buffer_used = 0;
         const char* path = request->content.storage_write_request.path;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
@@ -466,8 +604,12 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            uint16_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            fs_operation_success =
+                rpc_system_storage_write_buffered(rpc_storage, buffer, buffer_size);
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -715,6 +857,8 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_storage->api = furi_record_open(RECORD_STORAGE);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->data_size =
+        (rpc_session_get_owner(session) == RpcOwnerUsb) ? MAX_DATA_SIZE_USB : MAX_DATA_SIZE;
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
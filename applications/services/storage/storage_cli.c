@@ -7,6 +7,7 @@
 #include <lib/toolbox/dir_walk.h>
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
+#include <storage/storage_i.h>
 #include <power/power_service/power.h>
 
 #define MAX_NAME_LENGTH 255
@@ -33,6 +34,7 @@ static void storage_cli_print_usage() {
     printf("\tmd5\t - md5 hash of the file\r\n");
     printf("\tstat\t - info about file or dir\r\n");
     printf("\ttimestamp\t - last modification timestamp\r\n");
+    printf("\tstats\t - request counters and wait times, no path needed\r\n");
 }
 
 static void storage_cli_print_error(FS_Error error) {
@@ -496,6 +498,61 @@ static void storage_cli_md5(Cli* cli, FuriString* path) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static const char* const storage_cli_command_names[StorageCommandCount] = {
+    [StorageCommandFileOpen] = "file_open",
+    [StorageCommandFileClose] = "file_close",
+    [StorageCommandFileRead] = "file_read",
+    [StorageCommandFileWrite] = "file_write",
+    [StorageCommandFileSeek] = "file_seek",
+    [StorageCommandFileTell] = "file_tell",
+    [StorageCommandFileExpand] = "file_expand",
+    [StorageCommandFileTruncate] = "file_truncate",
+    [StorageCommandFileSize] = "file_size",
+    [StorageCommandFileSync] = "file_sync",
+    [StorageCommandFileEof] = "file_eof",
+    [StorageCommandDirOpen] = "dir_open",
+    [StorageCommandDirClose] = "dir_close",
+    [StorageCommandDirRead] = "dir_read",
+    [StorageCommandDirRewind] = "dir_rewind",
+    [StorageCommandCommonTimestamp] = "timestamp",
+    [StorageCommandCommonStat] = "stat",
+    [StorageCommandCommonRemove] = "remove",
+    [StorageCommandCommonMkDir] = "mkdir",
+    [StorageCommandCommonFSInfo] = "fs_info",
+    [StorageCommandSDFormat] = "sd_format",
+    [StorageCommandSDUnmount] = "sd_unmount",
+    [StorageCommandSDInfo] = "sd_info",
+    [StorageCommandSDStatus] = "sd_status",
+    [StorageCommandCommonResolvePath] = "resolve_path",
+    [StorageCommandSDMount] = "sd_mount",
+};
+
+static void storage_cli_stats(Cli* cli) {
+    UNUSED(cli);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    StorageCommandStats* stats = malloc(sizeof(api->stats));
+    furi_check(furi_mutex_acquire(api->mutex, FuriWaitForever) == FuriStatusOk);
+    memcpy(stats, api->stats, sizeof(api->stats));
+    furi_check(furi_mutex_release(api->mutex) == FuriStatusOk);
+
+    printf("Command        Queued  Avg wait  Max wait  Direct  Avg wait\r\n");
+    for(size_t i = 0; i < StorageCommandCount; i++) {
+        if(!stats[i].queued && !stats[i].direct) continue;
+        printf(
+            "%-13s %7lu %7luus %7luus %7lu %7luus\r\n",
+            storage_cli_command_names[i],
+            stats[i].queued,
+            stats[i].queued ? stats[i].queue_wait_us / stats[i].queued : 0,
+            stats[i].queue_wait_max_us,
+            stats[i].direct,
+            stats[i].direct ? stats[i].lock_wait_us / stats[i].direct : 0);
+    }
+
+    free(stats);
+    furi_record_close(RECORD_STORAGE);
+}
+
 void storage_cli(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     FuriString* cmd;
@@ -509,6 +566,11 @@ void storage_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "stats") == 0) {
+            storage_cli_stats(cli);
+            break;
+        }
+
         if(!args_read_probably_quoted_string_and_trim(args, path)) {
             storage_cli_print_usage();
             break;
@@ -3,6 +3,7 @@
 #include "storage.h"
 #include "storage_i.h"
 #include "storage_message.h"
+#include "storage_processing.h"
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/dir_walk.h>
 #include "toolbox/path.h"
@@ -20,11 +21,20 @@
     furi_assert(storage);
 
 #define S_API_EPILOGUE                                                               \
+    message.time_queued = DWT->CYCCNT;                                               \
     furi_check(                                                                      \
         furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) == \
         FuriStatusOk);                                                               \
     api_lock_wait_unlock_and_free(lock)
 
+/* Requests on open files are processed in the caller thread if possible */
+#define S_API_DIRECT_EPILOGUE                                 \
+    if(!storage_process_message_direct(storage, &message)) { \
+        FuriApiLock lock = api_lock_alloc_locked();           \
+        message.lock = lock;                                  \
+        S_API_EPILOGUE;                                       \
+    }
+
 #define S_API_MESSAGE(_command)      \
     SAReturn return_data;            \
     StorageMessage message = {       \
@@ -34,6 +44,15 @@
         .return_data = &return_data, \
     };
 
+#define S_API_DIRECT_MESSAGE(_command) \
+    SAReturn return_data;              \
+    StorageMessage message = {         \
+        .lock = NULL,                  \
+        .command = _command,           \
+        .data = &data,                 \
+        .return_data = &return_data,   \
+    };
+
 #define S_API_DATA_FILE   \
     SAData data = {       \
         .file = {         \
@@ -145,7 +164,6 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
     }
 
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
 
     SAData data = {
         .fread = {
@@ -154,8 +172,8 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
             .bytes_to_read = bytes_to_read,
         }};
 
-    S_API_MESSAGE(StorageCommandFileRead);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileRead);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_UINT16;
 }
 
@@ -165,7 +183,6 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
     }
 
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
 
     SAData data = {
         .fwrite = {
@@ -174,14 +191,13 @@ uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_writ
             .bytes_to_write = bytes_to_write,
         }};
 
-    S_API_MESSAGE(StorageCommandFileWrite);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileWrite);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_UINT16;
 }
 
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
 
     SAData data = {
         .fseek = {
@@ -190,23 +206,21 @@ bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
             .from_start = from_start,
         }};
 
-    S_API_MESSAGE(StorageCommandFileSeek);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileSeek);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 uint64_t storage_file_tell(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
     S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileTell);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileTell);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_UINT64;
 }
 
 bool storage_file_expand(File* file, uint64_t size) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
 
     SAData data = {
         .fexpand = {
@@ -214,44 +228,40 @@ bool storage_file_expand(File* file, uint64_t size) {
             .size = size,
         }};
 
-    S_API_MESSAGE(StorageCommandFileExpand);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileExpand);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 bool storage_file_truncate(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
     S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileTruncate);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileTruncate);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 uint64_t storage_file_size(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
     S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileSize);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileSize);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_UINT64;
 }
 
 bool storage_file_sync(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
     S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileSync);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileSync);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
 bool storage_file_eof(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
     S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileEof);
-    S_API_EPILOGUE;
+    S_API_DIRECT_MESSAGE(StorageCommandFileEof);
+    S_API_DIRECT_EPILOGUE;
     return S_RETURN_BOOL;
 }
 
@@ -5,6 +5,7 @@
 #include "storage_glue.h"
 #include "storage_sd_api.h"
 #include "filesystem_api_internal.h"
+#include "storage_message.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,11 +21,22 @@ typedef struct {
     bool enabled;
 } StorageSDGui;
 
+typedef struct {
+    uint32_t queued; /**< Requests processed by the storage thread */
+    uint32_t queue_wait_us; /**< Total time requests waited in the queue */
+    uint32_t queue_wait_max_us; /**< Longest time a request waited in the queue */
+    uint32_t direct; /**< Requests processed in the caller thread */
+    uint32_t lock_wait_us; /**< Total time callers waited for the lock */
+} StorageCommandStats;
+
 struct Storage {
     FuriMessageQueue* message_queue;
+    // Held while a request is processed, by the storage thread or by the caller
+    FuriMutex* mutex;
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageCommandStats stats[StorageCommandCount];
 };
 
 #ifdef __cplusplus
@@ -149,13 +149,17 @@ typedef enum {
     StorageCommandSDStatus,
     StorageCommandCommonResolvePath,
     StorageCommandSDMount,
+
+    // Keep last for commands number calculation
+    StorageCommandCount,
 } StorageCommand;
 
 typedef struct {
-    FuriApiLock lock;
+    FuriApiLock lock; /**< NULL when processed in the caller thread */
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    uint32_t time_queued; /**< DWT cycle counter value when the message was queued */
 } StorageMessage;
 
 #ifdef __cplusplus
@@ -15,6 +15,11 @@ _Static_assert(
 
 #define FS_CALL(_storage, _fn) ret = _storage->fs_api->_fn;
 
+/* Free stack a caller must have kept at all times to run a request directly.
+ * Requests on open files run within the 3 KiB storage thread stack next to its
+ * message loop, half of it is required from callers to leave a margin. */
+#define STORAGE_DIRECT_STACK_SPACE_MIN (1536u)
+
 static bool storage_type_is_valid(StorageType type) {
 #ifdef FURI_RAM_EXEC
     return type == ST_EXT;
@@ -696,9 +701,53 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         furi_string_free(path);
     }
 
-    api_lock_unlock(message->lock);
+    if(message->lock) api_lock_unlock(message->lock);
+}
+
+static void storage_stats_add(
+    Storage* app,
+    StorageCommand command,
+    uint32_t time_start,
+    bool direct) {
+    furi_assert(command < StorageCommandCount);
+    StorageCommandStats* stats = &app->stats[command];
+    const uint32_t wait_us =
+        (DWT->CYCCNT - time_start) / furi_hal_cortex_instructions_per_microsecond();
+
+    if(direct) {
+        stats->direct++;
+        stats->lock_wait_us += wait_us;
+    } else {
+        stats->queued++;
+        stats->queue_wait_us += wait_us;
+        stats->queue_wait_max_us = MAX(stats->queue_wait_max_us, wait_us);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
+    storage_stats_add(app, message->command, message->time_queued, false);
     storage_process_message_internal(app, message);
+    furi_check(furi_mutex_release(app->mutex) == FuriStatusOk);
+}
+
+bool storage_process_message_direct(Storage* app, StorageMessage* message) {
+    // Stack watermark only goes down, so a thread that got close once keeps using the queue
+    if(furi_thread_get_stack_space(furi_thread_get_current_id()) <
+       STORAGE_DIRECT_STACK_SPACE_MIN) {
+        return false;
+    }
+
+    const uint32_t time_start = DWT->CYCCNT;
+    furi_check(furi_mutex_acquire(app->mutex, FuriWaitForever) == FuriStatusOk);
+
+    const bool direct =
+        (get_storage_by_file(message->data->file.file, app->storage) == &app->storage[ST_EXT]);
+    if(direct) {
+        storage_stats_add(app, message->command, time_start, true);
+        storage_process_message_internal(app, message);
+    }
+
+    furi_check(furi_mutex_release(app->mutex) == FuriStatusOk);
+    return direct;
 }
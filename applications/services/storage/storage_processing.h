@@ -13,6 +13,16 @@ FS_Error storage_get_data(Storage* app, FuriString* path, StorageData** storage)
 
 void storage_process_message(Storage* app, StorageMessage* message);
 
+/**
+ * Process a request on an open file in the caller thread.
+ * Only files on the external storage qualify, and only for callers whose stack watermark still
+ * leaves room for FatFS, others go through the queue.
+ * @param app Storage instance
+ * @param message Request, first member of the data must be the file
+ * @return false if the request must go through the storage thread
+ */
+bool storage_process_message_direct(Storage* app, StorageMessage* message);
+
 #ifdef __cplusplus
 }
 #endif
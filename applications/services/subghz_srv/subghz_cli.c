@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_packed.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <applications/drivers/subghz/cc1101_ext/cc1101_ext_interconnect.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
@@ -19,6 +20,7 @@
 
 #include <notification/notification_messages.h>
 #include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/buffered_file_stream.h>
 
 #define SUBGHZ_FREQUENCY_RANGE_STR \
     "299999755...348000000 or 386999938...464000000 or 778999847...928000000"
@@ -585,6 +587,10 @@ static void subghz_cli_command_print_usage() {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\traw_pack <path_RAW_file> <path_packed_RAW_file>\t - Convert RAW file to packed format\r\n");
+    printf(
+        "\traw_unpack <path_packed_RAW_file> <path_RAW_file>\t - Convert packed RAW file to text format\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -674,6 +680,60 @@ static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_raw_convert(Cli* cli, FuriString* args, bool pack) {
+    UNUSED(cli);
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* input = buffered_file_stream_alloc(storage);
+    Stream* output = buffered_file_stream_alloc(storage);
+
+    do {
+        if(!args_read_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!buffered_file_stream_open(
+               input, furi_string_get_cstr(source), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            printf("Failed to open %s\r\n", furi_string_get_cstr(source));
+            break;
+        }
+
+        if(!buffered_file_stream_open(
+               output, furi_string_get_cstr(destination), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+            printf("Failed to open %s\r\n", furi_string_get_cstr(destination));
+            break;
+        }
+
+        bool converted = pack ? subghz_raw_packed_pack(input, output) :
+                                subghz_raw_packed_unpack(input, output);
+        if(!converted || !buffered_file_stream_sync(output)) {
+            printf("Failed to convert %s\r\n", furi_string_get_cstr(source));
+            break;
+        }
+
+        printf(
+            "Converted %zu bytes to %zu bytes\r\n", stream_size(input), stream_size(output));
+    } while(false);
+
+    buffered_file_stream_close(output);
+    buffered_file_stream_close(input);
+    stream_free(output);
+    stream_free(input);
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_chat(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
     uint32_t frequency = 433920000;
@@ -898,6 +958,16 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "raw_pack") == 0) {
+            subghz_cli_command_raw_convert(cli, args, true);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "raw_unpack") == 0) {
+            subghz_cli_command_raw_convert(cli, args, false);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(furi_string_cmp_str(cmd, "encrypt_keeloq") == 0) {
                 subghz_cli_command_encrypt_keeloq(cli, args);
@@ -90,6 +90,25 @@ static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert);
  */
 static void prvHeapInit(void);
 
+/*
+ * Takes a block of xWantedSize bytes, header included, out of the list of free
+ * blocks.  Must be called with the scheduler suspended.
+ */
+static void* prvHeapAllocate(size_t xWantedSize);
+
+/*
+ * Same as prvHeapAllocate(), but takes the block from the end of the highest
+ * free block that is large enough, keeping long lived slabs away from the
+ * blocks handed out by the first fit walk.
+ */
+static void* prvHeapAllocateTop(size_t xWantedSize);
+
+/*
+ * pvPortMalloc() that records the given call site in the histogram, used by
+ * the libc allocation functions to report their callers.
+ */
+void* memmgr_heap_alloc(size_t xWantedSize, const void* site);
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -112,37 +131,118 @@ space. */
 static size_t xBlockAllocatedBit = 0;
 
 /* Furi heap extension */
-#include <m-dict.h>
-
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t) //-V1048
 
-DICT_DEF2( //-V1048
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
+/* Small blocks are served from slabs: heap blocks split into equal slots of one
+size class. Slot has the same header as a heap block, but pxNextFreeBlock points
+to its slab and xBlockSize has MEMMGR_HEAP_SLAB_BIT set. */
+#define MEMMGR_HEAP_SLAB_BIT ((size_t)1 << ((sizeof(size_t) * heapBITS_PER_BYTE) - 2))
+#define MEMMGR_HEAP_SLAB_SIZE 1024U
+#define MEMMGR_HEAP_SLAB_MIN_SLOTS 4U
+#define MEMMGR_HEAP_SLAB_MAX_BLOCK 256U
+#define MEMMGR_HEAP_SLAB_LOOKUP_SHIFT 4U
+
+/* Allocated blocks of traced threads keep the trace slot (plus one) in the
+bits right below MEMMGR_HEAP_SLAB_BIT, zero means that the block is not traced. */
+#define MEMMGR_HEAP_TRACE_SHIFT ((sizeof(size_t) * heapBITS_PER_BYTE) - 7)
+#define MEMMGR_HEAP_TRACE_MASK ((size_t)0x1F << MEMMGR_HEAP_TRACE_SHIFT)
+#define MEMMGR_HEAP_TRACE_SLOTS 31U
+
+/* Call site histogram size, must be a power of two */
+#define MEMMGR_HEAP_SITES 64U
+
+typedef struct MemmgrHeapSlab {
+    struct MemmgrHeapSlab* next;
+    struct MemmgrHeapSlab* prev;
+    BlockLink_t* free_slots; /*<< Free slots, linked through the first word of the data. */
+    uint16_t used;
+    uint16_t capacity;
+    uint8_t class_index;
+} MemmgrHeapSlab;
+
+typedef struct {
+    MemmgrHeapSlab* available; /*<< Slabs with free slots, full slabs are not linked. */
+    size_t slab_count;
+    size_t used_blocks;
+    size_t free_blocks;
+    uint32_t alloc_count;
+} MemmgrHeapSlabClass;
+
+static const uint16_t memmgr_heap_slab_block_size[] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+/* Size class for every 16 bytes of requested size */
+static const uint8_t memmgr_heap_slab_class_lookup[] =
+    {0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7};
+
+static MemmgrHeapSlabClass memmgr_heap_slab_class[COUNT_OF(memmgr_heap_slab_block_size)] = {0};
+
+typedef struct {
+    FuriThreadId thread_id; /*<< NULL if the slot is free. */
+    size_t memory; /*<< Bytes allocated by the thread and not freed yet. */
+} MemmgrHeapTrace;
 
 /* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
+static MemmgrHeapTrace memmgr_heap_trace[MEMMGR_HEAP_TRACE_SLOTS] = {0};
+static size_t memmgr_heap_trace_count = 0;
+static size_t memmgr_heap_trace_last = 0;
+/* Slots are taken round robin, so that blocks of a finished thread are
+unlikely to be accounted to a new one. */
+static size_t memmgr_heap_trace_next = 0;
+
+typedef struct {
+    const void* site;
+    uint32_t count;
+    uint32_t size;
+} MemmgrHeapSite;
+
+/* Call site histogram, NULL when disabled */
+static MemmgrHeapSite* memmgr_heap_sites = NULL;
+static MemmgrHeapSite memmgr_heap_sites_other = {0};
+
+static inline size_t memmgr_heap_get_block_size(const BlockLink_t* block) {
+    return block->xBlockSize &
+           ~(xBlockAllocatedBit | MEMMGR_HEAP_SLAB_BIT | MEMMGR_HEAP_TRACE_MASK);
+}
 
 /* Initialize tracing storage on start */
 void memmgr_heap_init() {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    memset(memmgr_heap_trace, 0, sizeof(memmgr_heap_trace));
+}
+
+/* Trace slot of the thread plus one, zero if the thread is not traced */
+static size_t memmgr_heap_trace_get_tag(FuriThreadId thread_id) {
+    if(memmgr_heap_trace_count == 0 || thread_id == NULL) {
+        return 0;
+    }
+
+    if(memmgr_heap_trace[memmgr_heap_trace_last].thread_id == thread_id) {
+        return memmgr_heap_trace_last + 1;
+    }
+
+    for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SLOTS; i++) {
+        if(memmgr_heap_trace[i].thread_id == thread_id) {
+            memmgr_heap_trace_last = i;
+            return i + 1;
+        }
+    }
+
+    return 0;
 }
 
 void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
+        furi_check(memmgr_heap_trace_get_tag(thread_id) == 0);
+        for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SLOTS; i++) {
+            size_t slot = (memmgr_heap_trace_next + i) % MEMMGR_HEAP_TRACE_SLOTS;
+            if(memmgr_heap_trace[slot].thread_id == NULL) {
+                /* Thread stays untraced if all slots are taken */
+                memmgr_heap_trace[slot].thread_id = thread_id;
+                memmgr_heap_trace[slot].memory = 0;
+                memmgr_heap_trace_next = (slot + 1) % MEMMGR_HEAP_TRACE_SLOTS;
+                memmgr_heap_trace_count++;
+                break;
+            }
+        }
     }
     (void)xTaskResumeAll();
 }
@@ -150,9 +250,11 @@ void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
 void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
-        memmgr_heap_thread_trace_depth--;
+        size_t tag = memmgr_heap_trace_get_tag(thread_id);
+        if(tag) {
+            memmgr_heap_trace[tag - 1].thread_id = NULL;
+            memmgr_heap_trace_count--;
+        }
     }
     (void)xTaskResumeAll();
 }
@@ -161,63 +263,288 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
     size_t leftovers = MEMMGR_HEAP_UNKNOWN;
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            leftovers = 0;
-            MemmgrHeapAllocDict_it_t alloc_dict_it;
-            for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-                !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-                MemmgrHeapAllocDict_next(alloc_dict_it)) {
-                MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-                if(data->key != 0) {
-                    uint8_t* puc = (uint8_t*)data->key;
-                    puc -= xHeapStructSize;
-                    BlockLink_t* pxLink = (void*)puc;
-
-                    if((pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
-                       pxLink->pxNextFreeBlock == NULL) {
-                        leftovers += data->value;
-                    }
-                }
-            }
+        size_t tag = memmgr_heap_trace_get_tag(thread_id);
+        if(tag) {
+            leftovers = memmgr_heap_trace[tag - 1].memory;
         }
-        memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
     return leftovers;
 }
 
+/* Size accounted to the owner, the same on allocation and release: heap blocks may be larger
+than requested when they are not split, slab slots have the header outside of the block size */
+static inline size_t memmgr_heap_trace_get_size(const BlockLink_t* block) {
+    if(block->xBlockSize & MEMMGR_HEAP_SLAB_BIT) {
+        return xHeapStructSize + memmgr_heap_get_block_size(block);
+    }
+    return memmgr_heap_get_block_size(block);
+}
+
 #undef traceMALLOC
 static inline void traceMALLOC(void* pointer, size_t size) {
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
-        }
-        memmgr_heap_thread_trace_depth--;
+    UNUSED(size);
+    if(pointer == NULL) return;
+
+    size_t tag = memmgr_heap_trace_get_tag(furi_thread_get_current_id());
+    if(tag) {
+        BlockLink_t* pxLink = (void*)(((uint8_t*)pointer) - xHeapStructSize);
+        pxLink->xBlockSize |= tag << MEMMGR_HEAP_TRACE_SHIFT;
+        memmgr_heap_trace[tag - 1].memory += memmgr_heap_trace_get_size(pxLink);
     }
 }
 
 #undef traceFREE
 static inline void traceFREE(void* pointer, size_t size) {
-    UNUSED(size);
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            // In some cases thread may want to release memory that was not allocated by it
-            const bool res = MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-            UNUSED(res);
+    BlockLink_t* pxLink = (void*)(((uint8_t*)pointer) - xHeapStructSize);
+    size_t tag = (pxLink->xBlockSize & MEMMGR_HEAP_TRACE_MASK) >> MEMMGR_HEAP_TRACE_SHIFT;
+    pxLink->xBlockSize &= ~MEMMGR_HEAP_TRACE_MASK;
+
+    /* Memory is accounted to the owner, no matter which thread releases it */
+    if(tag && memmgr_heap_trace[tag - 1].thread_id) {
+        MemmgrHeapTrace* trace = &memmgr_heap_trace[tag - 1];
+        trace->memory -= MIN(trace->memory, size);
+    }
+}
+
+static void memmgr_heap_site_add(const void* site, size_t size) {
+    MemmgrHeapSite* entry = &memmgr_heap_sites_other;
+
+    size_t index = ((size_t)site >> 1) & (MEMMGR_HEAP_SITES - 1);
+    for(size_t i = 0; i < MEMMGR_HEAP_SITES; i++) {
+        MemmgrHeapSite* probe = &memmgr_heap_sites[(index + i) & (MEMMGR_HEAP_SITES - 1)];
+        if(probe->site == site || probe->site == NULL) {
+            probe->site = site;
+            entry = probe;
+            break;
         }
-        memmgr_heap_thread_trace_depth--;
     }
+
+    entry->count++;
+    entry->size += size;
+}
+
+void memmgr_heap_enable_site_trace() {
+    MemmgrHeapSite* sites = pvPortMalloc(sizeof(MemmgrHeapSite) * MEMMGR_HEAP_SITES);
+    vTaskSuspendAll();
+    {
+        MemmgrHeapSite* old_sites = memmgr_heap_sites;
+        memmgr_heap_sites = sites;
+        sites = old_sites;
+        memset(&memmgr_heap_sites_other, 0, sizeof(MemmgrHeapSite));
+    }
+    (void)xTaskResumeAll();
+    vPortFree(sites);
+}
+
+void memmgr_heap_disable_site_trace() {
+    MemmgrHeapSite* sites;
+    vTaskSuspendAll();
+    {
+        sites = memmgr_heap_sites;
+        memmgr_heap_sites = NULL;
+    }
+    (void)xTaskResumeAll();
+    vPortFree(sites);
+}
+
+void memmgr_heap_printf_sites() {
+    MemmgrHeapSite* sites = pvPortMalloc(sizeof(MemmgrHeapSite) * MEMMGR_HEAP_SITES);
+    MemmgrHeapSite other;
+    bool enabled;
+
+    /* Take a snapshot, printf can not be called with a locked scheduler */
+    vTaskSuspendAll();
+    {
+        enabled = (memmgr_heap_sites != NULL);
+        if(enabled) {
+            memcpy(sites, memmgr_heap_sites, sizeof(MemmgrHeapSite) * MEMMGR_HEAP_SITES);
+        }
+        other = memmgr_heap_sites_other;
+    }
+    (void)xTaskResumeAll();
+
+    if(enabled) {
+        for(size_t i = 0; i < MEMMGR_HEAP_SITES; i++) {
+            if(sites[i].site) {
+                printf(
+                    "P %p C %lu S %lu\r\n", sites[i].site, sites[i].count, sites[i].size);
+            }
+        }
+        if(other.count) {
+            printf("P other C %lu S %lu\r\n", other.count, other.size);
+        }
+    }
+
+    vPortFree(sites);
+}
+
+static inline size_t memmgr_heap_slab_get_slot_size(size_t class_index) {
+    return xHeapStructSize + memmgr_heap_slab_block_size[class_index];
+}
+
+static inline BlockLink_t** memmgr_heap_slab_get_slot_link(BlockLink_t* slot) {
+    return (BlockLink_t**)(((uint8_t*)slot) + xHeapStructSize);
+}
+
+static void memmgr_heap_slab_link(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlab* slab) {
+    slab->prev = NULL;
+    slab->next = slab_class->available;
+    if(slab->next) {
+        slab->next->prev = slab;
+    }
+    slab_class->available = slab;
+}
+
+static void memmgr_heap_slab_unlink(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlab* slab) {
+    if(slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        slab_class->available = slab->next;
+    }
+    if(slab->next) {
+        slab->next->prev = slab->prev;
+    }
+    slab->next = NULL;
+    slab->prev = NULL;
+}
+
+/* Carve a new slab out of the heap, scheduler must be suspended */
+static MemmgrHeapSlab* memmgr_heap_slab_create(size_t class_index) {
+    const size_t header_size = (sizeof(MemmgrHeapSlab) + portBYTE_ALIGNMENT_MASK) &
+                               ~((size_t)portBYTE_ALIGNMENT_MASK);
+    const size_t slot_size = memmgr_heap_slab_get_slot_size(class_index);
+    const size_t capacity =
+        MAX((MEMMGR_HEAP_SLAB_SIZE - header_size) / slot_size, MEMMGR_HEAP_SLAB_MIN_SLOTS);
+
+    MemmgrHeapSlab* slab =
+        prvHeapAllocateTop(xHeapStructSize + header_size + capacity * slot_size);
+    if(slab == NULL) {
+        return NULL;
+    }
+
+    slab->free_slots = NULL;
+    slab->used = 0;
+    slab->capacity = capacity;
+    slab->class_index = class_index;
+
+    /* Link slots backwards, so that they are handed out in address order */
+    uint8_t* slots = ((uint8_t*)slab) + header_size;
+    for(size_t i = capacity; i > 0; i--) {
+        BlockLink_t* slot = (void*)(slots + (i - 1) * slot_size);
+        slot->pxNextFreeBlock = (void*)slab;
+        slot->xBlockSize = memmgr_heap_slab_block_size[class_index] | MEMMGR_HEAP_SLAB_BIT;
+        *memmgr_heap_slab_get_slot_link(slot) = slab->free_slots;
+        slab->free_slots = slot;
+    }
+
+    /* Free slots are still free memory, only the slab header is an overhead */
+    xFreeBytesRemaining += capacity * slot_size;
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_class[class_index];
+    slab_class->slab_count++;
+    slab_class->free_blocks += capacity;
+    memmgr_heap_slab_link(slab_class, slab);
+
+    return slab;
+}
+
+/* Give an empty slab back to the heap, scheduler must be suspended */
+static void memmgr_heap_slab_destroy(MemmgrHeapSlab* slab) {
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_class[slab->class_index];
+    memmgr_heap_slab_unlink(slab_class, slab);
+    slab_class->slab_count--;
+    slab_class->free_blocks -= slab->capacity;
+    xFreeBytesRemaining -= slab->capacity * memmgr_heap_slab_get_slot_size(slab->class_index);
+
+    BlockLink_t* pxLink = (void*)(((uint8_t*)slab) - xHeapStructSize);
+    pxLink->xBlockSize &= ~xBlockAllocatedBit;
+    xFreeBytesRemaining += pxLink->xBlockSize;
+    memset(slab, 0, pxLink->xBlockSize - xHeapStructSize);
+    prvInsertBlockIntoFreeList(pxLink);
+}
+
+/* Take a slot of the smallest fitting class, scheduler must be suspended */
+static void* memmgr_heap_slab_alloc(size_t* size) {
+    const size_t class_index =
+        memmgr_heap_slab_class_lookup[(*size - 1) >> MEMMGR_HEAP_SLAB_LOOKUP_SHIFT];
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_class[class_index];
+
+    MemmgrHeapSlab* slab = slab_class->available;
+    if(slab == NULL) {
+        slab = memmgr_heap_slab_create(class_index);
+        if(slab == NULL) {
+            return NULL;
+        }
+    }
+
+    BlockLink_t* slot = slab->free_slots;
+    slab->free_slots = *memmgr_heap_slab_get_slot_link(slot);
+    slab->used++;
+    if(slab->free_slots == NULL) {
+        memmgr_heap_slab_unlink(slab_class, slab);
+    }
+
+    slot->xBlockSize |= xBlockAllocatedBit;
+    slab_class->used_blocks++;
+    slab_class->free_blocks--;
+    slab_class->alloc_count++;
+
+    *size = memmgr_heap_slab_get_slot_size(class_index);
+    xFreeBytesRemaining -= *size;
+    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+
+    return ((uint8_t*)slot) + xHeapStructSize;
+}
+
+/* Return a slot to its slab, scheduler must be suspended */
+static void memmgr_heap_slab_free(BlockLink_t* slot) {
+    MemmgrHeapSlab* slab = (void*)slot->pxNextFreeBlock;
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_class[slab->class_index];
+
+    slot->xBlockSize &= ~xBlockAllocatedBit;
+    memset(
+        memmgr_heap_slab_get_slot_link(slot),
+        0,
+        memmgr_heap_slab_block_size[slab->class_index]);
+
+    if(slab->free_slots == NULL) {
+        memmgr_heap_slab_link(slab_class, slab);
+    }
+    *memmgr_heap_slab_get_slot_link(slot) = slab->free_slots;
+    slab->free_slots = slot;
+    slab->used--;
+
+    slab_class->used_blocks--;
+    slab_class->free_blocks++;
+    xFreeBytesRemaining += memmgr_heap_slab_get_slot_size(slab->class_index);
+
+    /* Keep one slab with free slots around, so that alloc/free pairs do not hit the heap */
+    if(slab->used == 0 && (slab->prev || slab->next)) {
+        memmgr_heap_slab_destroy(slab);
+    }
+}
+
+size_t memmgr_heap_get_slab_class_count() {
+    return COUNT_OF(memmgr_heap_slab_class);
+}
+
+void memmgr_heap_get_slab_class_info(size_t index, MemmgrHeapSlabClassInfo* info) {
+    furi_check(index < COUNT_OF(memmgr_heap_slab_class));
+    furi_check(info);
+
+    vTaskSuspendAll();
+    {
+        const MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_class[index];
+        info->block_size = memmgr_heap_slab_block_size[index];
+        info->slab_count = slab_class->slab_count;
+        info->used_blocks = slab_class->used_blocks;
+        info->free_blocks = slab_class->free_blocks;
+        info->alloc_count = slab_class->alloc_count;
+    }
+    (void)xTaskResumeAll();
 }
 
 size_t memmgr_heap_get_max_free_block() {
@@ -249,6 +576,17 @@ void memmgr_heap_printf_free_blocks() {
     }
 
     //xTaskResumeAll();
+
+    for(size_t i = 0; i < memmgr_heap_get_slab_class_count(); i++) {
+        MemmgrHeapSlabClassInfo info;
+        memmgr_heap_get_slab_class_info(i, &info);
+        printf(
+            "C %zu U %zu F %zu N %zu\r\n",
+            info.block_size,
+            info.used_blocks,
+            info.free_blocks,
+            info.slab_count);
+    }
 }
 
 #ifdef HEAP_PRINT_DEBUG
@@ -338,7 +676,11 @@ static void print_heap_free(void* ptr) {
 /*-----------------------------------------------------------*/
 
 void* pvPortMalloc(size_t xWantedSize) {
-    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    return memmgr_heap_alloc(xWantedSize, __builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
+void* memmgr_heap_alloc(size_t xWantedSize, const void* site) {
     void* pvReturn = NULL;
     size_t to_wipe = xWantedSize;
 
@@ -346,10 +688,6 @@ void* pvPortMalloc(size_t xWantedSize) {
         furi_crash("memmgt in ISR");
     }
 
-#ifdef HEAP_PRINT_DEBUG
-    BlockLink_t* print_heap_block = NULL;
-#endif
-
     /* If this is the first call to malloc then the heap will require
         initialisation to setup the list of free blocks. */
     if(pxEnd == NULL) {
@@ -369,11 +707,19 @@ void* pvPortMalloc(size_t xWantedSize) {
 
     vTaskSuspendAll();
     {
+        /* Small blocks come from the size classes, the heap is only walked
+        when a new slab is needed. */
+        if((xWantedSize > 0) && (xWantedSize <= MEMMGR_HEAP_SLAB_MAX_BLOCK)) {
+            pvReturn = memmgr_heap_slab_alloc(&xWantedSize);
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         /* Check the requested block size is not so large that the top bit is
         set.  The top bit of the block size member of the BlockLink_t structure
         is used to determine who owns the block - the application or the
         kernel, so it must be free. */
-        if((xWantedSize & xBlockAllocatedBit) == 0) {
+        if((pvReturn == NULL) && ((xWantedSize & xBlockAllocatedBit) == 0)) {
             /* The wanted size is increased so it can contain a BlockLink_t
             structure in addition to the requested amount of bytes. */
             if(xWantedSize > 0) {
@@ -392,81 +738,26 @@ void* pvPortMalloc(size_t xWantedSize) {
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-                while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
-                }
-
-                /* If the end marker was reached then a block of adequate size
-                was not found. */
-                if(pxBlock != pxEnd) {
-                    /* Return the memory space pointed to - jumping over the
-                    BlockLink_t structure at its start. */
-                    pvReturn =
-                        (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
-
-                    /* This block is being returned for use so must be taken out
-                    of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                    two. */
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                        block following the number of bytes requested. The void
-                        cast is used to prevent byte alignment warnings from the
-                        compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                        single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* The block is being returned - it is allocated and owned
-                    by the application and has no "next" block. */
-                    pxBlock->xBlockSize |= xBlockAllocatedBit;
-                    pxBlock->pxNextFreeBlock = NULL;
-
-#ifdef HEAP_PRINT_DEBUG
-                    print_heap_block = pxBlock;
-#endif
-                } else {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            } else {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            pvReturn = prvHeapAllocate(xWantedSize);
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
 
         traceMALLOC(pvReturn, xWantedSize);
+
+        if(memmgr_heap_sites != NULL && pvReturn != NULL) {
+            memmgr_heap_site_add(site, to_wipe);
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     (void)xTaskResumeAll();
 
 #ifdef HEAP_PRINT_DEBUG
-    print_heap_malloc(print_heap_block, print_heap_block->xBlockSize & ~xBlockAllocatedBit);
+    if(pvReturn != NULL) {
+        BlockLink_t* print_heap_block = (void*)(((uint8_t*)pvReturn) - xHeapStructSize);
+        print_heap_malloc(print_heap_block, memmgr_heap_get_block_size(print_heap_block));
+    }
 #endif
 
 #if(configUSE_MALLOC_FAILED_HOOK == 1)
@@ -488,6 +779,126 @@ void* pvPortMalloc(size_t xWantedSize) {
 }
 /*-----------------------------------------------------------*/
 
+static void* prvHeapAllocate(size_t xWantedSize) {
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    void* pvReturn = NULL;
+
+    if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
+        /* Traverse the list from the start (lowest address) block until
+        one of adequate size is found. */
+        pxPreviousBlock = &xStart;
+        pxBlock = xStart.pxNextFreeBlock;
+        while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+
+        /* If the end marker was reached then a block of adequate size
+        was not found. */
+        if(pxBlock != pxEnd) {
+            /* Return the memory space pointed to - jumping over the
+            BlockLink_t structure at its start. */
+            pvReturn = (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
+
+            /* This block is being returned for use so must be taken out
+            of the list of free blocks. */
+            pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+            /* If the block is larger than required it can be split into
+            two. */
+            if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+                /* This block is to be split into two.  Create a new
+                block following the number of bytes requested. The void
+                cast is used to prevent byte alignment warnings from the
+                compiler. */
+                pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+                configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+                /* Calculate the sizes of two blocks split from the
+                single block. */
+                pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                pxBlock->xBlockSize = xWantedSize;
+
+                /* Insert the new block into the list of free blocks. */
+                prvInsertBlockIntoFreeList(pxNewBlockLink);
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block is being returned - it is allocated and owned
+            by the application and has no "next" block. */
+            pxBlock->xBlockSize |= xBlockAllocatedBit;
+            pxBlock->pxNextFreeBlock = NULL;
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void* prvHeapAllocateTop(size_t xWantedSize) {
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxFoundBlock = NULL, *pxFoundPreviousBlock = NULL;
+    void* pvReturn = NULL;
+
+    if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
+        /* The whole list is walked, but only when a new slab is needed. */
+        pxPreviousBlock = &xStart;
+        pxBlock = xStart.pxNextFreeBlock;
+        while(pxBlock != pxEnd) {
+            if(pxBlock->xBlockSize >= xWantedSize) {
+                pxFoundPreviousBlock = pxPreviousBlock;
+                pxFoundBlock = pxBlock;
+            }
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+
+        if(pxFoundBlock != NULL) {
+            if((pxFoundBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+                /* Shrink the free block and return its tail. */
+                pxFoundBlock->xBlockSize -= xWantedSize;
+                pxBlock = (void*)(((uint8_t*)pxFoundBlock) + pxFoundBlock->xBlockSize);
+                configASSERT((((size_t)pxBlock) & portBYTE_ALIGNMENT_MASK) == 0);
+                pxBlock->xBlockSize = xWantedSize;
+            } else {
+                pxFoundPreviousBlock->pxNextFreeBlock = pxFoundBlock->pxNextFreeBlock;
+                pxBlock = pxFoundBlock;
+            }
+
+            xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxBlock->xBlockSize |= xBlockAllocatedBit;
+            pxBlock->pxNextFreeBlock = NULL;
+            pvReturn = (void*)(((uint8_t*)pxBlock) + xHeapStructSize);
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vPortFree(void* pv) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
@@ -506,9 +917,25 @@ void vPortFree(void* pv) {
 
         /* Check the block is actually allocated. */
         configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
-        configASSERT(pxLink->pxNextFreeBlock == NULL);
 
-        if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
+        if((pxLink->xBlockSize & (xBlockAllocatedBit | MEMMGR_HEAP_SLAB_BIT)) ==
+           (xBlockAllocatedBit | MEMMGR_HEAP_SLAB_BIT)) {
+#ifdef HEAP_PRINT_DEBUG
+            print_heap_free(pxLink);
+#endif
+
+            vTaskSuspendAll();
+            {
+                furi_assert((size_t)pv >= SRAM_BASE);
+                furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
+
+                traceFREE(pv, memmgr_heap_trace_get_size(pxLink));
+                memmgr_heap_slab_free(pxLink);
+            }
+            (void)xTaskResumeAll();
+        } else if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
+            configASSERT(pxLink->pxNextFreeBlock == NULL);
+
             if(pxLink->pxNextFreeBlock == NULL) {
                 /* The block is being returned to the heap - it is no longer
                 allocated. */
@@ -520,6 +947,8 @@ void vPortFree(void* pv) {
 
                 vTaskSuspendAll();
                 {
+                    traceFREE(pv, memmgr_heap_trace_get_size(pxLink));
+
                     furi_assert((size_t)pv >= SRAM_BASE);
                     furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
                     furi_assert(pxLink->xBlockSize >= xHeapStructSize);
@@ -527,7 +956,6 @@ void vPortFree(void* pv) {
 
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE(pv, pxLink->xBlockSize);
                     memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
                     prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
                 }
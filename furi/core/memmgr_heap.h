@@ -14,7 +14,18 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Size class statistics */
+typedef struct {
+    size_t block_size; /**< Largest request served by the class */
+    size_t slab_count; /**< Slabs taken from the heap */
+    size_t used_blocks; /**< Blocks in use */
+    size_t free_blocks; /**< Blocks ready for allocation */
+    uint32_t alloc_count; /**< Allocations since boot */
+} MemmgrHeapSlabClassInfo;
+
 /** Memmgr heap enable thread allocation tracking
+ *
+ * Up to 31 threads are tracked at once, others are left untracked.
  *
  * @param      thread_id  - thread id to track
  */
@@ -27,10 +38,12 @@ void memmgr_heap_enable_thread_trace(FuriThreadId taks_handle);
 void memmgr_heap_disable_thread_trace(FuriThreadId taks_handle);
 
 /** Memmgr heap get allocatred thread memory
+ *
+ * Blocks are accounted to the thread that allocated them, even if they are freed by another one.
  *
  * @param      thread_id  - thread id to track
  *
- * @return     bytes allocated right now
+ * @return     bytes allocated right now, MEMMGR_HEAP_UNKNOWN if the thread is not tracked
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
 
@@ -40,10 +53,40 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId taks_handle);
  */
 size_t memmgr_heap_get_max_free_block();
 
-/** Print the address and size of all free blocks to stdout
+/** Print the address and size of all free blocks and size class statistics to stdout
  */
 void memmgr_heap_printf_free_blocks();
 
+/** Memmgr heap get the number of size classes
+ *
+ * Requests up to 256 bytes are served from per-class slabs, larger ones go to the heap.
+ *
+ * @return     size_t number of size classes
+ */
+size_t memmgr_heap_get_slab_class_count();
+
+/** Memmgr heap get size class statistics
+ *
+ * @param      index  - size class index
+ * @param      info   - pointer to a MemmgrHeapSlabClassInfo to fill
+ */
+void memmgr_heap_get_slab_class_info(size_t index, MemmgrHeapSlabClassInfo* info);
+
+/** Memmgr heap start the call site histogram
+ *
+ * Every allocation is counted against the address it was requested from.
+ * Histogram is cleared if it is already running.
+ */
+void memmgr_heap_enable_site_trace();
+
+/** Memmgr heap stop the call site histogram and drop collected data
+ */
+void memmgr_heap_disable_site_trace();
+
+/** Print allocation count and total size for every call site to stdout
+ */
+void memmgr_heap_printf_sites();
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,7 @@ void CFW_SETTINGS_LOAD() {
     CfwSettings* x = &cfw_settings;
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* file = flipper_format_file_alloc(storage);
+    flipper_format_set_index_mode(file, true);
     if(flipper_format_file_open_existing(file, CFW_SETTINGS_PATH)) {
         flipper_format_rewind(file);
         flipper_format_read_uint32(file, "anim_style", (uint32_t*)&x->anim_style, 1);
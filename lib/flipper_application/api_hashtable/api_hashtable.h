@@ -35,6 +35,7 @@ uint32_t elf_symbolname_hash(const char* s);
 
 #include <array>
 #include <algorithm>
+#include "compilesort.hpp"
 
 /**
  * @brief  HashtableApiInterface is an implementation of ElfApiInterface
@@ -86,4 +87,56 @@ constexpr bool has_hash_collisions(const std::array<sym_entry, N>& api_methods)
     return false;
 }
 
+/* Sort key for the bucketed firmware API table. GNU hashes of short names
+ * leave the top bits empty, so the hash is mixed with a multiplication by an
+ * odd constant. It is a bijection: hashes still collide only if keys do.
+ * Tables for elf_resolve_from_hashtable stay sorted by the raw hash.
+ */
+constexpr uint32_t sym_hash_key(uint32_t hash) {
+    return hash * 0x9E3779B1U;
+}
+
+constexpr bool sym_key_less(const sym_entry& k1, const sym_entry& k2) {
+    return sym_hash_key(k1.hash) < sym_hash_key(k2.hash);
+}
+
+/* Copy of an API table reordered by sym_hash_key, for make_sym_bucket_index */
+template <std::size_t N>
+constexpr auto sort_sym_table_by_key(std::array<sym_entry, N> api_methods) {
+    quick_sort(api_methods.begin(), api_methods.end(), sym_key_less);
+    return api_methods;
+}
+
+/* Number of hash bits used to select a bucket, about two entries per bucket */
+constexpr std::size_t sym_bucket_bits(std::size_t count) {
+    std::size_t bits = 1;
+    while(bits < 15 && (std::size_t(2) << bits) < count) {
+        ++bits;
+    }
+    return bits;
+}
+
+/* Compile-time bucket index for a table ordered by sort_sym_table_by_key.
+ * Entries of bucket b are [index[b], index[b + 1]), where b is the top
+ * sym_bucket_bits(N) bits of sym_hash_key, so the bucket is found with a
+ * shift by 32 - sym_bucket_bits(N).
+ * Usage: static constexpr auto api_bucket_index = make_sym_bucket_index(api_methods);
+ */
+template <std::size_t N>
+constexpr auto make_sym_bucket_index(const std::array<sym_entry, N>& api_methods) {
+    static_assert(N <= UINT16_MAX, "API table is too big for the bucket index");
+    constexpr std::size_t bits = sym_bucket_bits(N);
+    std::array<uint16_t, (std::size_t(1) << bits) + 1> index{};
+
+    std::size_t entry = 0;
+    for(std::size_t bucket = 0; bucket < index.size(); ++bucket) {
+        while(entry < N && (sym_hash_key(api_methods[entry].hash) >> (32 - bits)) < bucket) {
+            ++entry;
+        }
+        index[bucket] = entry;
+    }
+
+    return index;
+}
+
 #endif
\ No newline at end of file
@@ -4,14 +4,21 @@
 #include "elf_file_i.h"
 #include "elf_api_interface.h"
 #include "../api_hashtable/api_hashtable.h"
+#include <toolbox/crc32_calc.h>
 
 #define TAG "Elf"
 
 #define ELF_NAME_BUFFER_LEN 32
-#define SECTION_OFFSET(e, n) ((e)->section_table + (n) * sizeof(Elf32_Shdr))
 #define IS_FLAGS_SET(v, m) (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
 #define FAST_RELOCATION_VERSION 1
+#define RELOCATION_BUFFER_COUNT 32
+
+#define SYMBOL_CACHE_FOLDER EXT_PATH(".fapcache")
+#define SYMBOL_CACHE_MAGIC 0x43534C45
+#define SYMBOL_CACHE_VERSION 3
+#define SYMBOL_CACHE_CRC_BUFFER_LEN 512
+#define SYMBOL_CACHE_MAX_ENTRIES (UINT16_MAX / sizeof(ELFSymbolCacheEntry))
 
 // #define ELF_DEBUG_LOG 1
 
@@ -36,6 +43,23 @@ typedef struct {
     uint32_t addr;
 } __attribute__((packed)) JMPTrampoline;
 
+/**
+ * Symbol cache file header, followed by ELFSymbolCacheEntry records.
+ * Cache is valid for the same file size, section table, symbol table and its string table with
+ * the same API version: imports are cached by name hash, so a renamed import invalidates it.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t file_size;
+    uint32_t section_table_crc;
+    uint32_t symbol_table_crc;
+    uint32_t string_table_crc;
+    uint32_t entry_count;
+} __attribute__((packed)) ELFSymbolCacheHeader;
+
 /**************************************************************************************************/
 /********************************************* Caches *********************************************/
 /**************************************************************************************************/
@@ -89,11 +113,42 @@ static ELFSection* elf_file_get_or_put_section(ELFFile* elf, const char* name) {
     return section_p;
 }
 
+static bool elf_load_section_tables(ELFFile* elf) {
+    if(elf->section_headers) return true;
+
+    const size_t headers_size = elf->sections_count * sizeof(Elf32_Shdr);
+    const size_t names_size = elf->section_table_strings_size;
+    Elf32_Shdr* headers = malloc(headers_size);
+    char* names = malloc(names_size + 1);
+    names[names_size] = 0;
+
+    if(headers_size > UINT16_MAX || names_size > UINT16_MAX ||
+       !storage_file_seek(elf->fd, elf->section_table, true) ||
+       storage_file_read(elf->fd, headers, headers_size) != headers_size ||
+       !storage_file_seek(elf->fd, elf->section_table_strings, true) ||
+       storage_file_read(elf->fd, names, names_size) != names_size) {
+        free(headers);
+        free(names);
+        return false;
+    }
+
+    elf->section_headers = headers;
+    elf->section_names = names;
+    return true;
+}
+
+static void elf_release_section_tables(ELFFile* elf) {
+    if(elf->section_headers) {
+        free(elf->section_headers);
+        free(elf->section_names);
+        elf->section_headers = NULL;
+        elf->section_names = NULL;
+    }
+}
+
 static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString* name) {
     bool result = false;
 
-    off_t old = storage_file_tell(elf->fd);
-
     do {
         if(!storage_file_seek(elf->fd, offset, true)) break;
 
@@ -112,13 +167,17 @@ static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString*
         }
 
     } while(false);
-    storage_file_seek(elf->fd, old, true);
 
     return result;
 }
 
 static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
-    return elf_read_string_from_offset(elf, elf->section_table_strings + offset, name);
+    if(!elf_load_section_tables(elf) || (size_t)offset >= elf->section_table_strings_size) {
+        return false;
+    }
+
+    furi_string_cat_str(name, elf->section_names + offset);
+    return true;
 }
 
 static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
@@ -126,9 +185,12 @@ static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
 }
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
-    off_t offset = SECTION_OFFSET(elf, section_idx);
-    return storage_file_seek(elf->fd, offset, true) &&
-           storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
+    if(!elf_load_section_tables(elf) || section_idx >= elf->sections_count) {
+        return false;
+    }
+
+    *section_header = elf->section_headers[section_idx];
+    return true;
 }
 
 static bool elf_read_section(
@@ -149,7 +211,6 @@ static bool elf_read_section(
 
 static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* name) {
     bool success = false;
-    off_t old = storage_file_tell(elf->fd);
     off_t pos = elf->symbol_table + n * sizeof(Elf32_Sym);
     if(storage_file_seek(elf->fd, pos, true) &&
        storage_file_read(elf->fd, sym, sizeof(Elf32_Sym)) == sizeof(Elf32_Sym)) {
@@ -160,7 +221,6 @@ static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* nam
             success = elf_read_section(elf, sym->st_shndx, &shdr, name);
         }
     }
-    storage_file_seek(elf->fd, old, true);
     return success;
 }
 
@@ -176,20 +236,19 @@ static ELFSection* elf_section_of(ELFFile* elf, int index) {
     return NULL;
 }
 
-static Elf32_Addr elf_address_of(ELFFile* elf, Elf32_Sym* sym, const char* sName) {
-    if(sym->st_shndx == SHN_UNDEF) {
+static Elf32_Addr elf_address_of(ELFFile* elf, const ELFSymbolCacheEntry* symbol) {
+    if(symbol->section == SHN_UNDEF) {
         Elf32_Addr addr = 0;
-        uint32_t hash = elf_symbolname_hash(sName);
-        if(elf->api_interface->resolver_callback(elf->api_interface, hash, &addr)) {
+        if(elf->api_interface->resolver_callback(elf->api_interface, symbol->value, &addr)) {
             return addr;
         }
     } else {
-        ELFSection* symSec = elf_section_of(elf, sym->st_shndx);
+        ELFSection* symSec = elf_section_of(elf, symbol->section);
         if(symSec) {
-            return ((Elf32_Addr)symSec->data) + sym->st_value;
+            return ((Elf32_Addr)symSec->data) + symbol->value;
         }
     }
-    FURI_LOG_D(TAG, "  Can not find address for symbol %s", sName);
+    FURI_LOG_D(TAG, "  Can not find address for symbol #%lu", symbol->index);
     return ELF_INVALID_ADDRESS;
 }
 
@@ -352,10 +411,11 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
 
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
-        Elf32_Rel rel;
+        Elf32_Rel* rels = malloc(sizeof(Elf32_Rel) * RELOCATION_BUFFER_COUNT);
+        size_t rels_start = 0;
+        size_t rels_count = 0;
         size_t relEntries = s->rel_count;
         size_t relCount;
-        (void)storage_file_seek(elf->fd, s->rel_offset, true);
         FURI_LOG_D(TAG, " Offset   Info     Type             Name");
 
         int relocate_result = true;
@@ -368,37 +428,54 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
-                FURI_LOG_E(TAG, "  reloc read fail");
-                furi_string_free(symbol_name);
-                return false;
+            if(relCount == rels_start + rels_count) {
+                // Symbol reads move the file position, so every chunk is sought to
+                rels_start = relCount;
+                rels_count = MIN(relEntries - relCount, (size_t)RELOCATION_BUFFER_COUNT);
+                const size_t size = rels_count * sizeof(Elf32_Rel);
+                if(!storage_file_seek(
+                       elf->fd, s->rel_offset + rels_start * sizeof(Elf32_Rel), true) ||
+                   storage_file_read(elf->fd, rels, size) != size) {
+                    FURI_LOG_E(TAG, "  reloc read fail");
+                    relocate_result = false;
+                    break;
+                }
             }
 
+            const Elf32_Rel* rel = &rels[relCount - rels_start];
             Elf32_Addr symAddr;
 
-            int symEntry = ELF32_R_SYM(rel.r_info);
-            int relType = ELF32_R_TYPE(rel.r_info);
-            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
+            int symEntry = ELF32_R_SYM(rel->r_info);
+            int relType = ELF32_R_TYPE(rel->r_info);
+            Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel->r_offset;
 
             if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
                 Elf32_Sym sym;
                 furi_string_reset(symbol_name);
                 if(!elf_read_symbol(elf, symEntry, &sym, symbol_name)) {
                     FURI_LOG_E(TAG, "  symbol read fail");
-                    furi_string_free(symbol_name);
-                    return false;
+                    relocate_result = false;
+                    break;
                 }
 
                 FURI_LOG_D(
                     TAG,
                     " %08X %08X %-16s %s",
-                    (unsigned int)rel.r_offset,
-                    (unsigned int)rel.r_info,
+                    (unsigned int)rel->r_offset,
+                    (unsigned int)rel->r_info,
                     elf_reloc_type_to_str(relType),
                     furi_string_get_cstr(symbol_name));
 
-                symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
+                ELFSymbolCacheEntry symbol = {
+                    .index = symEntry,
+                    .value = (sym.st_shndx == SHN_UNDEF) ?
+                                 elf_symbolname_hash(furi_string_get_cstr(symbol_name)) :
+                                 sym.st_value,
+                    .section = sym.st_shndx,
+                };
+                symAddr = elf_address_of(elf, &symbol);
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                ELFSymbolCacheArray_push_back(elf->symbol_cache, symbol);
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -416,6 +493,7 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
             }
         }
         furi_string_free(symbol_name);
+        free(rels);
 
         return relocate_result;
     } else {
@@ -425,6 +503,137 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     return false;
 }
 
+/**************************************************************************************************/
+/****************************************** Symbol cache ******************************************/
+/**************************************************************************************************/
+
+static FuriString* elf_symbol_cache_get_path(ELFFile* elf) {
+    const char* path = furi_string_get_cstr(elf->path);
+    return furi_string_alloc_printf(
+        "%s/%08lX.sym", SYMBOL_CACHE_FOLDER, crc32_calc_buffer(0, path, strlen(path)));
+}
+
+static bool elf_file_crc(ELFFile* elf, off_t offset, size_t size, uint32_t* crc) {
+    if(!storage_file_seek(elf->fd, offset, true)) return false;
+
+    uint8_t* buffer = malloc(SYMBOL_CACHE_CRC_BUFFER_LEN);
+    *crc = 0;
+    while(size > 0) {
+        const uint16_t chunk = MIN(size, (size_t)SYMBOL_CACHE_CRC_BUFFER_LEN);
+        if(storage_file_read(elf->fd, buffer, chunk) != chunk) break;
+        *crc = crc32_calc_buffer(*crc, buffer, chunk);
+        size -= chunk;
+    }
+    free(buffer);
+
+    return size == 0;
+}
+
+static const Elf32_Shdr* elf_symbol_cache_get_string_table(ELFFile* elf) {
+    for(size_t i = 1; i < elf->sections_count; i++) {
+        const Elf32_Shdr* section_header = &elf->section_headers[i];
+        if(section_header->sh_type == SHT_SYMTAB &&
+           section_header->sh_offset == (Elf32_Off)elf->symbol_table) {
+            if(section_header->sh_link >= elf->sections_count) break;
+            return &elf->section_headers[section_header->sh_link];
+        }
+    }
+    return NULL;
+}
+
+static bool elf_symbol_cache_get_header(ELFFile* elf, ELFSymbolCacheHeader* header) {
+    if(!elf_load_section_tables(elf)) return false;
+
+    const Elf32_Shdr* string_table = elf_symbol_cache_get_string_table(elf);
+    if(!string_table ||
+       !elf_file_crc(
+           elf,
+           elf->symbol_table,
+           elf->symbol_count * sizeof(Elf32_Sym),
+           &header->symbol_table_crc) ||
+       !elf_file_crc(
+           elf, string_table->sh_offset, string_table->sh_size, &header->string_table_crc)) {
+        return false;
+    }
+
+    header->magic = SYMBOL_CACHE_MAGIC;
+    header->version = SYMBOL_CACHE_VERSION;
+    header->api_version_major = elf->api_interface->api_version_major;
+    header->api_version_minor = elf->api_interface->api_version_minor;
+    header->file_size = storage_file_size(elf->fd);
+    header->section_table_crc =
+        crc32_calc_buffer(0, elf->section_headers, elf->sections_count * sizeof(Elf32_Shdr));
+    header->entry_count = 0;
+    return true;
+}
+
+/* Put cached symbols to the relocation cache, so symbol table is not read */
+static bool elf_symbol_cache_load(ELFFile* elf, const ELFSymbolCacheHeader* expected) {
+    FuriString* cache_path = elf_symbol_cache_get_path(elf);
+    File* file = storage_file_alloc(elf->storage);
+    ELFSymbolCacheEntry* symbols = NULL;
+    bool success = false;
+
+    do {
+        ELFSymbolCacheHeader header;
+        if(!storage_file_open(
+               file, furi_string_get_cstr(cache_path), FSAM_READ, FSOM_OPEN_EXISTING) ||
+           storage_file_read(file, &header, sizeof(header)) != sizeof(header)) {
+            break;
+        }
+
+        const size_t count = header.entry_count;
+        const size_t size = count * sizeof(ELFSymbolCacheEntry);
+        header.entry_count = 0;
+        if(memcmp(&header, expected, sizeof(header)) != 0 || count > SYMBOL_CACHE_MAX_ENTRIES ||
+           storage_file_size(file) != sizeof(header) + size) {
+            FURI_LOG_D(TAG, "Symbol cache is outdated");
+            break;
+        }
+
+        symbols = malloc(size);
+        if(storage_file_read(file, symbols, size) != size) break;
+
+        for(size_t i = 0; i < count; i++) {
+            address_cache_put(
+                elf->relocation_cache, symbols[i].index, elf_address_of(elf, &symbols[i]));
+        }
+
+        FURI_LOG_D(TAG, "Loaded %zu symbols from cache", count);
+        success = true;
+    } while(false);
+
+    if(symbols) free(symbols);
+    storage_file_free(file);
+    furi_string_free(cache_path);
+    return success;
+}
+
+static void elf_symbol_cache_save(ELFFile* elf, const ELFSymbolCacheHeader* expected) {
+    const size_t count = ELFSymbolCacheArray_size(elf->symbol_cache);
+    if(count == 0 || count > SYMBOL_CACHE_MAX_ENTRIES) return;
+
+    FuriString* cache_path = elf_symbol_cache_get_path(elf);
+    File* file = storage_file_alloc(elf->storage);
+
+    ELFSymbolCacheHeader header = *expected;
+    header.entry_count = count;
+    const size_t size = count * sizeof(ELFSymbolCacheEntry);
+
+    if(!storage_simply_mkdir(elf->storage, SYMBOL_CACHE_FOLDER) ||
+       !storage_file_open(
+           file, furi_string_get_cstr(cache_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) ||
+       storage_file_write(file, &header, sizeof(header)) != sizeof(header) ||
+       storage_file_write(file, ELFSymbolCacheArray_cget(elf->symbol_cache, 0), size) != size) {
+        FURI_LOG_W(TAG, "Failed to save symbol cache");
+        storage_file_close(file);
+        storage_simply_remove(elf->storage, furi_string_get_cstr(cache_path));
+    }
+
+    storage_file_free(file);
+    furi_string_free(cache_path);
+}
+
 /**************************************************************************************************/
 /************************************ Internal FAP interfaces *************************************/
 /**************************************************************************************************/
@@ -757,6 +966,8 @@ static void elf_file_call_section_list(ELFSection* section, bool reverse_order)
 
 ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     ELFFile* elf = malloc(sizeof(ELFFile));
+    elf->storage = storage;
+    elf->path = furi_string_alloc();
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
@@ -807,7 +1018,9 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    elf_release_section_tables(elf);
     elf_file_maybe_release_fd(elf);
+    furi_string_free(elf->path);
     free(elf);
 }
 
@@ -823,10 +1036,12 @@ bool elf_file_open(ELFFile* elf, const char* path) {
         return false;
     }
 
+    furi_string_set(elf->path, path);
     elf->entry = h.e_entry;
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+    elf->section_table_strings_size = sH.sh_size;
     return true;
 }
 
@@ -903,6 +1118,20 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     ELFSectionDict_it_t it;
 
     AddressCache_init(elf->relocation_cache);
+    ELFSymbolCacheArray_init(elf->symbol_cache);
+
+    // Fast relocations reference imports by hash and never read the symbol table
+    bool fast_rel = false;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        if(ELFSectionDict_cref(it)->value.fast_rel) {
+            fast_rel = true;
+            break;
+        }
+    }
+
+    ELFSymbolCacheHeader cache_header;
+    const bool cache_valid = !fast_rel && elf_symbol_cache_get_header(elf, &cache_header);
+    const bool cache_loaded = cache_valid && elf_symbol_cache_load(elf, &cache_header);
 
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
@@ -925,9 +1154,15 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         }
     }
 
+    // Symbols are only collected when relocating without the cache
+    if(status == ELFFileLoadStatusSuccess && cache_valid && !cache_loaded) {
+        elf_symbol_cache_save(elf, &cache_header);
+    }
+
     FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
+    ELFSymbolCacheArray_clear(elf->symbol_cache);
 
     {
         size_t total_size = 0;
@@ -939,6 +1174,7 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
         FURI_LOG_I(TAG, "Total size of loaded sections: %zu", total_size);
     }
 
+    elf_release_section_tables(elf);
     elf_file_maybe_release_fd(elf);
     return status;
 }
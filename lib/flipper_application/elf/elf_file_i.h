@@ -1,6 +1,7 @@
 #pragma once
 #include "elf_file.h"
 #include <m-dict.h>
+#include <m-array.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,10 +29,26 @@ struct ELFSection {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+/**
+ * Resolved symbol, stored in the symbol cache
+ */
+typedef struct {
+    uint32_t index; /* Symbol table index */
+    uint32_t value; /* Name hash for imports, offset in the section otherwise */
+    uint16_t section; /* Section index, SHN_UNDEF for imports */
+} __attribute__((packed)) ELFSymbolCacheEntry;
+
+ARRAY_DEF(ELFSymbolCacheArray, ELFSymbolCacheEntry, M_POD_OPLIST)
+
 struct ELFFile {
     size_t sections_count;
     off_t section_table;
     off_t section_table_strings;
+    size_t section_table_strings_size;
+
+    /* Section header table and names, loaded on first access */
+    Elf32_Shdr* section_headers;
+    char* section_names;
 
     size_t symbol_count;
     off_t symbol_table;
@@ -41,7 +58,10 @@ struct ELFFile {
 
     AddressCache_t relocation_cache;
     AddressCache_t trampoline_cache;
+    ELFSymbolCacheArray_t symbol_cache;
 
+    Storage* storage;
+    FuriString* path;
     File* fd;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
@@ -7,10 +7,12 @@
 #include "flipper_format_i.h"
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
+#include "flipper_format_index.h"
 
 /********************************** Private **********************************/
 struct FlipperFormat {
     Stream* stream;
+    FlipperFormatIndex* index;
     bool strict_mode;
 };
 
@@ -21,11 +23,16 @@ Stream* flipper_format_get_raw_stream(FlipperFormat* flipper_format) {
     return flipper_format->stream;
 }
 
+static void flipper_format_reset_index(FlipperFormat* flipper_format) {
+    if(flipper_format->index) flipper_format_index_reset(flipper_format->index);
+}
+
 /********************************** Public **********************************/
 
 FlipperFormat* flipper_format_string_alloc() {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = string_stream_alloc();
+    flipper_format->index = NULL;
     flipper_format->strict_mode = false;
     return flipper_format;
 }
@@ -33,6 +40,7 @@ FlipperFormat* flipper_format_string_alloc() {
 FlipperFormat* flipper_format_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = file_stream_alloc(storage);
+    flipper_format->index = NULL;
     flipper_format->strict_mode = false;
     return flipper_format;
 }
@@ -40,23 +48,27 @@ FlipperFormat* flipper_format_file_alloc(Storage* storage) {
 FlipperFormat* flipper_format_buffered_file_alloc(Storage* storage) {
     FlipperFormat* flipper_format = malloc(sizeof(FlipperFormat));
     flipper_format->stream = buffered_file_stream_alloc(storage);
+    flipper_format->index = NULL;
     flipper_format->strict_mode = false;
     return flipper_format;
 }
 
 bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_buffered_file_open_existing(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
 }
 
 bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
 
     bool result =
         file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_OPEN_APPEND);
@@ -88,32 +100,38 @@ bool flipper_format_file_open_append(FlipperFormat* flipper_format, const char*
 
 bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_buffered_file_open_always(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return buffered_file_stream_open(
         flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
 }
 
 bool flipper_format_file_open_new(FlipperFormat* flipper_format, const char* path) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return file_stream_open(flipper_format->stream, path, FSAM_READ_WRITE, FSOM_CREATE_NEW);
 }
 
 bool flipper_format_file_close(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return file_stream_close(flipper_format->stream);
 }
 
 bool flipper_format_buffered_file_close(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    flipper_format_reset_index(flipper_format);
     return buffered_file_stream_close(flipper_format->stream);
 }
 
 void flipper_format_free(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
+    if(flipper_format->index) flipper_format_index_free(flipper_format->index);
     stream_free(flipper_format->stream);
     free(flipper_format);
 }
@@ -122,6 +140,16 @@ void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_m
     flipper_format->strict_mode = strict_mode;
 }
 
+void flipper_format_set_index_mode(FlipperFormat* flipper_format, bool index_mode) {
+    furi_assert(flipper_format);
+    if(index_mode && !flipper_format->index) {
+        flipper_format->index = flipper_format_index_alloc();
+    } else if(!index_mode && flipper_format->index) {
+        flipper_format_index_free(flipper_format->index);
+        flipper_format->index = NULL;
+    }
+}
+
 bool flipper_format_rewind(FlipperFormat* flipper_format) {
     furi_assert(flipper_format);
     return stream_rewind(flipper_format->stream);
@@ -135,7 +163,8 @@ bool flipper_format_seek_to_end(FlipperFormat* flipper_format) {
 bool flipper_format_key_exist(FlipperFormat* flipper_format, const char* key) {
     size_t pos = stream_tell(flipper_format->stream);
     stream_seek(flipper_format->stream, 0, StreamOffsetFromStart);
-    bool result = flipper_format_stream_seek_to_key(flipper_format->stream, key, false);
+    bool result = flipper_format_stream_seek_to_key_indexed(
+        flipper_format->stream, flipper_format->index, key, false);
     stream_seek(flipper_format->stream, pos, StreamOffsetFromStart);
 
     return result;
@@ -174,14 +203,20 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count) {
     furi_assert(flipper_format);
-    return flipper_format_stream_get_value_count(
-        flipper_format->stream, key, count, flipper_format->strict_mode);
+    return flipper_format_stream_get_value_count_indexed(
+        flipper_format->stream, flipper_format->index, key, count, flipper_format->strict_mode);
 }
 
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_assert(flipper_format);
-    return flipper_format_stream_read_value_line(
-        flipper_format->stream, key, FlipperStreamValueStr, data, 1, flipper_format->strict_mode);
+    return flipper_format_stream_read_value_line_indexed(
+        flipper_format->stream,
+        flipper_format->index,
+        key,
+        FlipperStreamValueStr,
+        data,
+        1,
+        flipper_format->strict_mode);
 }
 
 bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
@@ -192,7 +227,8 @@ bool flipper_format_write_string(FlipperFormat* flipper_format, const char* key,
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -207,7 +243,8 @@ bool flipper_format_write_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -217,8 +254,9 @@ bool flipper_format_read_hex_uint64(
     uint64_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_format);
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueHexUint64,
         data,
@@ -238,7 +276,8 @@ bool flipper_format_write_hex_uint64(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -248,8 +287,9 @@ bool flipper_format_read_uint32(
     uint32_t* data,
     const uint16_t data_size) {
     furi_assert(flipper_format);
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueUint32,
         data,
@@ -269,7 +309,8 @@ bool flipper_format_write_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -278,8 +319,9 @@ bool flipper_format_read_int32(
     const char* key,
     int32_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueInt32,
         data,
@@ -299,7 +341,8 @@ bool flipper_format_write_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -308,8 +351,9 @@ bool flipper_format_read_bool(
     const char* key,
     bool* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueBool,
         data,
@@ -329,7 +373,8 @@ bool flipper_format_write_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -338,8 +383,9 @@ bool flipper_format_read_float(
     const char* key,
     float* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueFloat,
         data,
@@ -359,7 +405,8 @@ bool flipper_format_write_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -368,8 +415,9 @@ bool flipper_format_read_hex(
     const char* key,
     uint8_t* data,
     const uint16_t data_size) {
-    return flipper_format_stream_read_value_line(
+    return flipper_format_stream_read_value_line_indexed(
         flipper_format->stream,
+        flipper_format->index,
         key,
         FlipperStreamValueHex,
         data,
@@ -389,7 +437,8 @@ bool flipper_format_write_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_write_value_line(flipper_format->stream, &write_data);
+    bool result = flipper_format_stream_write_value_line_indexed(
+        flipper_format->stream, flipper_format->index, &write_data);
     return result;
 }
 
@@ -400,7 +449,8 @@ bool flipper_format_write_comment(FlipperFormat* flipper_format, FuriString* dat
 
 bool flipper_format_write_comment_cstr(FlipperFormat* flipper_format, const char* data) {
     furi_assert(flipper_format);
-    return flipper_format_stream_write_comment_cstr(flipper_format->stream, data);
+    return flipper_format_stream_write_comment_cstr_indexed(
+        flipper_format->stream, flipper_format->index, data);
 }
 
 bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
@@ -411,8 +461,8 @@ bool flipper_format_delete_key(FlipperFormat* flipper_format, const char* key) {
         .data = NULL,
         .data_size = 0,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -424,8 +474,8 @@ bool flipper_format_update_string(FlipperFormat* flipper_format, const char* key
         .data = furi_string_get_cstr(data),
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -440,8 +490,8 @@ bool flipper_format_update_string_cstr(
         .data = data,
         .data_size = 1,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -457,8 +507,8 @@ bool flipper_format_update_uint32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -473,8 +523,8 @@ bool flipper_format_update_int32(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -489,8 +539,8 @@ bool flipper_format_update_bool(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -505,8 +555,8 @@ bool flipper_format_update_float(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
@@ -521,8 +571,8 @@ bool flipper_format_update_hex(
         .data = data,
         .data_size = data_size,
     };
-    bool result = flipper_format_stream_delete_key_and_write(
-        flipper_format->stream, &write_data, flipper_format->strict_mode);
+    bool result = flipper_format_stream_delete_key_and_write_indexed(
+        flipper_format->stream, flipper_format->index, &write_data, flipper_format->strict_mode);
     return result;
 }
 
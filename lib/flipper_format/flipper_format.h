@@ -203,6 +203,17 @@ void flipper_format_free(FlipperFormat* flipper_format);
  */
 void flipper_format_set_strict_mode(FlipperFormat* flipper_format, bool strict_mode);
 
+/**
+ * Set FlipperFormat key index mode.
+ * In index mode offsets of all keys are recorded with a single pass on the first lookup, and
+ * reads, updates and deletes seek directly to the key instead of scanning the file. The index
+ * is dropped when a file is opened or closed, and kept up to date on writes done through
+ * FlipperFormat. Drop it by toggling the mode after modifying the raw stream.
+ * @param flipper_format Pointer to a FlipperFormat instance
+ * @param index_mode True enables the key index. False by default.
+ */
+void flipper_format_set_index_mode(FlipperFormat* flipper_format, bool index_mode);
+
 /**
  * Rewind the RW pointer.
  * @param flipper_format Pointer to a FlipperFormat instance
@@ -0,0 +1,263 @@
+#include <furi.h>
+#include <m-array.h>
+#include "flipper_format_index.h"
+#include "flipper_format_stream_i.h"
+
+typedef struct {
+    uint32_t position;
+    uint16_t key_id;
+} FlipperFormatIndexEntry;
+
+ARRAY_DEF(FlipperFormatIndexEntryArray, FlipperFormatIndexEntry, M_POD_OPLIST)
+ARRAY_DEF(FlipperFormatIndexKeyArray, FuriString*, FURI_STRING_OPLIST)
+
+struct FlipperFormatIndex {
+    // Unique keys, entries refer to them by position in this array
+    FlipperFormatIndexKeyArray_t keys;
+    // Key lines sorted by position
+    FlipperFormatIndexEntryArray_t entries;
+    size_t stream_size;
+    bool valid;
+};
+
+FlipperFormatIndex* flipper_format_index_alloc() {
+    FlipperFormatIndex* index = malloc(sizeof(FlipperFormatIndex));
+    FlipperFormatIndexKeyArray_init(index->keys);
+    FlipperFormatIndexEntryArray_init(index->entries);
+    index->valid = false;
+    return index;
+}
+
+void flipper_format_index_free(FlipperFormatIndex* index) {
+    furi_assert(index);
+    FlipperFormatIndexKeyArray_clear(index->keys);
+    FlipperFormatIndexEntryArray_clear(index->entries);
+    free(index);
+}
+
+void flipper_format_index_reset(FlipperFormatIndex* index) {
+    furi_assert(index);
+    FlipperFormatIndexKeyArray_reset(index->keys);
+    FlipperFormatIndexEntryArray_reset(index->entries);
+    index->stream_size = 0;
+    index->valid = false;
+}
+
+static bool
+    flipper_format_index_get_key_id(FlipperFormatIndex* index, const char* key, uint16_t* key_id) {
+    size_t count = FlipperFormatIndexKeyArray_size(index->keys);
+    for(size_t i = 0; i < count; i++) {
+        if(furi_string_cmp_str(*FlipperFormatIndexKeyArray_get(index->keys, i), key) == 0) {
+            *key_id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool
+    flipper_format_index_add_key_id(FlipperFormatIndex* index, const char* key, uint16_t* key_id) {
+    if(flipper_format_index_get_key_id(index, key, key_id)) return true;
+
+    size_t count = FlipperFormatIndexKeyArray_size(index->keys);
+    if(count > UINT16_MAX) return false;
+
+    FuriString** new_key = FlipperFormatIndexKeyArray_push_new(index->keys);
+    furi_string_set_str(*new_key, key);
+    *key_id = count;
+    return true;
+}
+
+static bool flipper_format_index_add_entry(
+    FlipperFormatIndex* index,
+    const char* key,
+    size_t position) {
+    if(position > UINT32_MAX) return false;
+
+    FlipperFormatIndexEntry entry = {.position = position};
+    if(!flipper_format_index_add_key_id(index, key, &entry.key_id)) return false;
+    FlipperFormatIndexEntryArray_push_back(index->entries, entry);
+    return true;
+}
+
+// First entry at or after the position
+static size_t flipper_format_index_lower_bound(FlipperFormatIndex* index, size_t position) {
+    size_t low = 0;
+    size_t high = FlipperFormatIndexEntryArray_size(index->entries);
+
+    while(low < high) {
+        size_t middle = low + (high - low) / 2;
+        if(FlipperFormatIndexEntryArray_get(index->entries, middle)->position < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+bool flipper_format_index_prepare(FlipperFormatIndex* index, Stream* stream) {
+    furi_assert(index);
+    size_t size = stream_size(stream);
+    if(index->valid && index->stream_size == size) return true;
+
+    flipper_format_index_reset(index);
+    size_t position = stream_tell(stream);
+    if(!stream_rewind(stream)) return false;
+
+    FuriString* key = furi_string_alloc();
+    bool error = false;
+
+    while(!stream_eof(stream)) {
+        if(!flipper_format_stream_read_valid_key(stream, key)) break;
+
+        // Stream is at the delimiter, key is right before it
+        size_t key_size = furi_string_size(key);
+        size_t delimiter_position = stream_tell(stream);
+        if(delimiter_position < key_size ||
+           !flipper_format_index_add_entry(
+               index, furi_string_get_cstr(key), delimiter_position - key_size)) {
+            error = true;
+            break;
+        }
+    }
+
+    furi_string_free(key);
+
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) error = true;
+
+    if(error) {
+        flipper_format_index_reset(index);
+    } else {
+        index->stream_size = size;
+        index->valid = true;
+    }
+
+    return index->valid;
+}
+
+// Make sure that the indexed line still starts with the key and the delimiter
+static bool flipper_format_index_check_key(Stream* stream, size_t position, const char* key) {
+    if(!stream_seek(stream, position, StreamOffsetFromStart)) return false;
+
+    const size_t buffer_size = 32;
+    uint8_t buffer[buffer_size];
+    const size_t check_size = strlen(key) + 1;
+    size_t checked = 0;
+
+    while(checked < check_size) {
+        size_t to_read = MIN(buffer_size, check_size - checked);
+        if(stream_read(stream, buffer, to_read) != to_read) return false;
+
+        for(size_t i = 0; i < to_read; i++) {
+            char expected = (checked + i + 1 < check_size) ? key[checked + i] :
+                                                             flipper_format_delimiter;
+            if(buffer[i] != (uint8_t)expected) return false;
+        }
+
+        checked += to_read;
+    }
+
+    return true;
+}
+
+bool flipper_format_index_seek_to_key(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode) {
+    furi_assert(index);
+    furi_assert(index->valid);
+
+    size_t position = stream_tell(stream);
+    const FlipperFormatIndexEntry* found = NULL;
+
+    uint16_t key_id;
+    if(flipper_format_index_get_key_id(index, key, &key_id)) {
+        size_t count = FlipperFormatIndexEntryArray_size(index->entries);
+        for(size_t i = flipper_format_index_lower_bound(index, position); i < count; i++) {
+            const FlipperFormatIndexEntry* entry =
+                FlipperFormatIndexEntryArray_cget(index->entries, i);
+            if(entry->key_id == key_id) {
+                found = entry;
+                break;
+            } else if(strict_mode) {
+                break;
+            }
+        }
+    }
+
+    if(!found) {
+        stream_seek(stream, 0, StreamOffsetFromEnd);
+        return false;
+    }
+
+    if(!flipper_format_index_check_key(stream, found->position, key)) {
+        // Stream was changed behind our back, forget everything and scan
+        flipper_format_index_reset(index);
+        if(!stream_seek(stream, position, StreamOffsetFromStart)) return false;
+        return flipper_format_stream_seek_to_key(stream, key, strict_mode);
+    }
+
+    return stream_seek(stream, found->position + strlen(key) + 2, StreamOffsetFromStart);
+}
+
+void flipper_format_index_write(
+    FlipperFormatIndex* index,
+    const char* key,
+    size_t position,
+    size_t old_size,
+    size_t new_size) {
+    furi_assert(index);
+    if(!index->valid) return;
+
+    if(index->stream_size != old_size || position != old_size) {
+        flipper_format_index_reset(index);
+        return;
+    }
+
+    if(key && new_size > old_size) {
+        if(!flipper_format_index_add_entry(index, key, position)) {
+            flipper_format_index_reset(index);
+            return;
+        }
+    }
+
+    index->stream_size = new_size;
+}
+
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    size_t position,
+    bool keep_key,
+    size_t old_size,
+    size_t new_size) {
+    furi_assert(index);
+    if(!index->valid) return;
+
+    size_t count = FlipperFormatIndexEntryArray_size(index->entries);
+    size_t i = flipper_format_index_lower_bound(index, position);
+
+    if(index->stream_size != old_size || i >= count ||
+       FlipperFormatIndexEntryArray_get(index->entries, i)->position != position ||
+       new_size > UINT32_MAX) {
+        flipper_format_index_reset(index);
+        return;
+    }
+
+    if(keep_key) {
+        i++;
+    } else {
+        FlipperFormatIndexEntryArray_remove_v(index->entries, i, i + 1);
+        count--;
+    }
+
+    // Unsigned wrap-around gives the right result for shrinking streams too
+    for(; i < count; i++) {
+        FlipperFormatIndexEntry* entry = FlipperFormatIndexEntryArray_get(index->entries, i);
+        entry->position = entry->position + new_size - old_size;
+    }
+
+    index->stream_size = new_size;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key offset index of a Flipper Format stream.
+ * Records the position of every key line, so that lookups can seek directly to the value
+ * instead of rescanning the stream from the current position.
+ */
+typedef struct FlipperFormatIndex FlipperFormatIndex;
+
+/**
+ * Allocate an empty index. Index is built on first use.
+ * @return FlipperFormatIndex*
+ */
+FlipperFormatIndex* flipper_format_index_alloc();
+
+/**
+ * Free the index
+ * @param index
+ */
+void flipper_format_index_free(FlipperFormatIndex* index);
+
+/**
+ * Drop recorded offsets. Index will be rebuilt on next lookup.
+ * @param index
+ */
+void flipper_format_index_reset(FlipperFormatIndex* index);
+
+/**
+ * Make sure the index describes the stream, build it with a single pass if it is not.
+ * Stream position is preserved.
+ * @param index
+ * @param stream
+ * @return true index can be used
+ * @return false index cannot be built, use a plain scan
+ */
+bool flipper_format_index_prepare(FlipperFormatIndex* index, Stream* stream);
+
+/**
+ * Seek to the key from the current position of the stream, using the index.
+ * Behaves as flipper_format_stream_seek_to_key, assuming that the current position is at
+ * the beginning of a line or inside of an already read line.
+ * @param index prepared index
+ * @param stream
+ * @param key
+ * @param strict_mode
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_index_seek_to_key(
+    FlipperFormatIndex* index,
+    Stream* stream,
+    const char* key,
+    bool strict_mode);
+
+/**
+ * Record a write made at the end of the stream.
+ * Writes made elsewhere overwrite indexed data and reset the index.
+ * @param index
+ * @param key written key, NULL if no key line was written
+ * @param position position of the write
+ * @param old_size stream size before the write
+ * @param new_size stream size after the write
+ */
+void flipper_format_index_write(
+    FlipperFormatIndex* index,
+    const char* key,
+    size_t position,
+    size_t old_size,
+    size_t new_size);
+
+/**
+ * Record replacement of a key line.
+ * @param index
+ * @param position key line start
+ * @param keep_key true if the line was rewritten with the same key, false if it was deleted
+ * @param old_size stream size before the replacement
+ * @param new_size stream size after the replacement
+ */
+void flipper_format_index_replace(
+    FlipperFormatIndex* index,
+    size_t position,
+    bool keep_key,
+    size_t old_size,
+    size_t new_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,6 +3,7 @@
 #include <core/check.h>
 #include "flipper_format_stream.h"
 #include "flipper_format_stream_i.h"
+#include "flipper_format_index.h"
 
 static inline bool flipper_format_stream_is_space(char c) {
     return c == ' ' || c == '\t' || c == flipper_format_eolr;
@@ -30,7 +31,7 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
-static bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
+bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key) {
     furi_string_reset(key);
     const size_t buffer_size = 32;
     uint8_t buffer[buffer_size];
@@ -121,6 +122,18 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
     return found;
 }
 
+bool flipper_format_stream_seek_to_key_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    bool strict_mode) {
+    if(index && flipper_format_index_prepare(index, stream)) {
+        return flipper_format_index_seek_to_key(index, stream, key, strict_mode);
+    } else {
+        return flipper_format_stream_seek_to_key(stream, key, strict_mode);
+    }
+}
+
 static bool flipper_format_stream_read_value(Stream* stream, FuriString* value, bool* last) {
     enum { LeadingSpace, ReadValue, TrailingSpace } state = LeadingSpace;
     const size_t buffer_size = 32;
@@ -261,6 +274,24 @@ static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
     return result;
 }
 
+bool flipper_format_stream_write_value_line_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    FlipperStreamWriteData* write_data) {
+    size_t position = stream_tell(stream);
+    size_t old_size = stream_size(stream);
+    bool result = flipper_format_stream_write_value_line(stream, write_data);
+    if(index) {
+        if(result) {
+            flipper_format_index_write(
+                index, write_data->key, position, old_size, stream_size(stream));
+        } else {
+            flipper_format_index_reset(index);
+        }
+    }
+    return result;
+}
+
 bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteData* write_data) {
     bool result = false;
 
@@ -342,10 +373,22 @@ bool flipper_format_stream_read_value_line(
     void* _data,
     size_t data_size,
     bool strict_mode) {
+    return flipper_format_stream_read_value_line_indexed(
+        stream, NULL, key, type, _data, data_size, strict_mode);
+}
+
+bool flipper_format_stream_read_value_line_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size,
+    bool strict_mode) {
     bool result = false;
 
     do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
+        if(!flipper_format_stream_seek_to_key_indexed(stream, index, key, strict_mode)) break;
 
         if(type == FlipperStreamValueStr) {
             FuriString* data = (FuriString*)_data;
@@ -441,6 +484,15 @@ bool flipper_format_stream_get_value_count(
     const char* key,
     uint32_t* count,
     bool strict_mode) {
+    return flipper_format_stream_get_value_count_indexed(stream, NULL, key, count, strict_mode);
+}
+
+bool flipper_format_stream_get_value_count_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    uint32_t* count,
+    bool strict_mode) {
     bool result = false;
     bool last = false;
 
@@ -449,7 +501,7 @@ bool flipper_format_stream_get_value_count(
 
     uint32_t position = stream_tell(stream);
     do {
-        if(!flipper_format_stream_seek_to_key(stream, key, strict_mode)) break;
+        if(!flipper_format_stream_seek_to_key_indexed(stream, index, key, strict_mode)) break;
         *count = 0;
 
         result = true;
@@ -477,6 +529,15 @@ bool flipper_format_stream_delete_key_and_write(
     Stream* stream,
     FlipperStreamWriteData* write_data,
     bool strict_mode) {
+    return flipper_format_stream_delete_key_and_write_indexed(
+        stream, NULL, write_data, strict_mode);
+}
+
+bool flipper_format_stream_delete_key_and_write_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    FlipperStreamWriteData* write_data,
+    bool strict_mode) {
     bool result = false;
 
     do {
@@ -486,7 +547,9 @@ bool flipper_format_stream_delete_key_and_write(
         if(!stream_rewind(stream)) break;
 
         // find key
-        if(!flipper_format_stream_seek_to_key(stream, write_data->key, strict_mode)) break;
+        if(!flipper_format_stream_seek_to_key_indexed(
+               stream, index, write_data->key, strict_mode))
+            break;
 
         // get key start position
         size_t start_position = stream_tell(stream) - strlen(write_data->key);
@@ -510,8 +573,20 @@ bool flipper_format_stream_delete_key_and_write(
                stream,
                end_position - start_position,
                (StreamWriteCB)flipper_format_stream_write_value_line,
-               write_data))
+               write_data)) {
+            if(index) flipper_format_index_reset(index);
             break;
+        }
+
+        if(index) {
+            // shift offsets of the following keys instead of rebuilding the index
+            flipper_format_index_replace(
+                index,
+                start_position,
+                write_data->type != FlipperStreamValueIgnore,
+                size,
+                stream_size(stream));
+        }
 
         result = true;
     } while(false);
@@ -519,6 +594,23 @@ bool flipper_format_stream_delete_key_and_write(
     return result;
 }
 
+bool flipper_format_stream_write_comment_cstr_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* data) {
+    size_t position = stream_tell(stream);
+    size_t old_size = stream_size(stream);
+    bool result = flipper_format_stream_write_comment_cstr(stream, data);
+    if(index) {
+        if(result) {
+            flipper_format_index_write(index, NULL, position, old_size, stream_size(stream));
+        } else {
+            flipper_format_index_reset(index);
+        }
+    }
+    return result;
+}
+
 bool flipper_format_stream_write_comment_cstr(Stream* stream, const char* data) {
     bool result = false;
     do {
@@ -1,5 +1,6 @@
 #pragma once
 #include "flipper_format_stream.h"
+#include "flipper_format_index.h"
 
 static const char flipper_format_delimiter = ':';
 static const char flipper_format_comment = '#';
@@ -29,6 +30,110 @@ bool flipper_format_stream_write_eol(Stream* stream);
  */
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode);
 
+/**
+ * Same as flipper_format_stream_seek_to_key, uses the index if there is one.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param key 
+ * @param strict_mode 
+ * @return true key is found
+ * @return false key is not found
+ */
+bool flipper_format_stream_seek_to_key_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    bool strict_mode);
+
+/**
+ * Read the next key from the current position of the stream.
+ * Position will be at the delimiter after the key, if the key is found.
+ * @param stream 
+ * @param key 
+ * @return true key is found
+ * @return false end of the stream
+ */
+bool flipper_format_stream_read_valid_key(Stream* stream, FuriString* key);
+
+/**
+ * Same as flipper_format_stream_write_value_line, keeps the index up to date.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param write_data 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_write_value_line_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    FlipperStreamWriteData* write_data);
+
+/**
+ * Same as flipper_format_stream_read_value_line, seeks to the key using the index.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param key 
+ * @param type 
+ * @param _data 
+ * @param data_size 
+ * @param strict_mode 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_read_value_line_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    FlipperStreamValue type,
+    void* _data,
+    size_t data_size,
+    bool strict_mode);
+
+/**
+ * Same as flipper_format_stream_get_value_count, seeks to the key using the index.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param key 
+ * @param count 
+ * @param strict_mode 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_get_value_count_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* key,
+    uint32_t* count,
+    bool strict_mode);
+
+/**
+ * Same as flipper_format_stream_delete_key_and_write, patches the index instead of rebuilding it.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param write_data 
+ * @param strict_mode 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_delete_key_and_write_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    FlipperStreamWriteData* write_data,
+    bool strict_mode);
+
+/**
+ * Same as flipper_format_stream_write_comment_cstr, keeps the index up to date.
+ * @param stream 
+ * @param index key offset index, can be NULL
+ * @param data 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_write_comment_cstr_indexed(
+    Stream* stream,
+    FlipperFormatIndex* index,
+    const char* data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@ static uint32_t infrared_tx_raw_timings_index = 0;
 static uint32_t infrared_tx_raw_timings_number = 0;
 static uint32_t infrared_tx_raw_start_from_mark = 0;
 static bool infrared_tx_raw_add_silence = false;
+static InfraredEncoderHandler* infrared_tx_encoder = NULL;
 
 FuriHalInfraredTxGetDataState
     infrared_get_raw_data_callback(void* context, uint32_t* duration, bool* level) {
@@ -36,13 +37,14 @@ FuriHalInfraredTxGetDataState
     return state;
 }
 
-void infrared_send_raw_ext(
+void infrared_send_raw_ext_start(
     const uint32_t timings[],
     uint32_t timings_cnt,
     bool start_from_mark,
     uint32_t frequency,
     float duty_cycle) {
     furi_assert(timings);
+    furi_assert(!furi_hal_infrared_is_busy());
 
     infrared_tx_raw_start_from_mark = start_from_mark;
     infrared_tx_raw_timings_index = 0;
@@ -51,9 +53,16 @@ void infrared_send_raw_ext(
     furi_hal_infrared_async_tx_set_data_isr_callback(
         infrared_get_raw_data_callback, (void*)timings);
     furi_hal_infrared_async_tx_start(frequency, duty_cycle);
-    furi_hal_infrared_async_tx_wait_termination();
+}
 
-    furi_assert(!furi_hal_infrared_is_busy());
+void infrared_send_raw_ext(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle) {
+    infrared_send_raw_ext_start(timings, timings_cnt, start_from_mark, frequency, duty_cycle);
+    infrared_send_wait();
 }
 
 void infrared_send_raw(const uint32_t timings[], uint32_t timings_cnt, bool start_from_mark) {
@@ -94,24 +103,38 @@ FuriHalInfraredTxGetDataState
     return state;
 }
 
-void infrared_send(const InfraredMessage* message, int times) {
+void infrared_send_start(const InfraredMessage* message, int times) {
     furi_assert(message);
     furi_assert(times);
     furi_assert(infrared_is_protocol_valid(message->protocol));
+    furi_assert(!furi_hal_infrared_is_busy());
 
-    InfraredEncoderHandler* handler = infrared_alloc_encoder();
-    infrared_reset_encoder(handler, message);
+    // Encoder stays alive until the transmission is waited for
+    infrared_tx_encoder = infrared_alloc_encoder();
+    infrared_reset_encoder(infrared_tx_encoder, message);
     infrared_tx_number_of_transmissions =
         MAX((int)infrared_get_protocol_min_repeat_count(message->protocol), times);
 
     uint32_t frequency = infrared_get_protocol_frequency(message->protocol);
     float duty_cycle = infrared_get_protocol_duty_cycle(message->protocol);
 
-    furi_hal_infrared_async_tx_set_data_isr_callback(infrared_get_data_callback, handler);
+    furi_hal_infrared_async_tx_set_data_isr_callback(
+        infrared_get_data_callback, infrared_tx_encoder);
     furi_hal_infrared_async_tx_start(frequency, duty_cycle);
+}
+
+void infrared_send(const InfraredMessage* message, int times) {
+    infrared_send_start(message, times);
+    infrared_send_wait();
+}
+
+void infrared_send_wait() {
     furi_hal_infrared_async_tx_wait_termination();
 
-    infrared_free_encoder(handler);
+    if(infrared_tx_encoder) {
+        infrared_free_encoder(infrared_tx_encoder);
+        infrared_tx_encoder = NULL;
+    }
 
     furi_assert(!furi_hal_infrared_is_busy());
 }
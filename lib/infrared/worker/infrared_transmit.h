@@ -41,6 +41,39 @@ void infrared_send_raw_ext(
     uint32_t frequency,
     float duty_cycle);
 
+/**
+ * Start sending message over INFRARED and return without waiting for the end of transmission.
+ * Transmission must be completed with infrared_send_wait() before the next one is started.
+ *
+ * \param[in]   message     - message to send.
+ * \param[in]   times       - number of times message should be sent.
+ */
+void infrared_send_start(const InfraredMessage* message, int times);
+
+/**
+ * Start sending raw data through infrared port and return without waiting for the end of
+ * transmission. Timings array must stay valid until infrared_send_wait() returns.
+ *
+ * \param[in]   timings - array of timings to send.
+ * \param[in]   timings_cnt - timings array size.
+ * \param[in]   start_from_mark - true if timings starts from mark,
+ *              otherwise from space
+ * \param[in]   duty_cycle - duty cycle to generate on PWM
+ * \param[in]   frequency - frequency to generate on PWM
+ */
+void infrared_send_raw_ext_start(
+    const uint32_t timings[],
+    uint32_t timings_cnt,
+    bool start_from_mark,
+    uint32_t frequency,
+    float duty_cycle);
+
+/**
+ * Wait for the end of transmission started with infrared_send_start()
+ * or infrared_send_raw_ext_start().
+ */
+void infrared_send_wait();
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,98 @@
+#include <furi.h>
+#include <toolbox/manchester_decoder.h>
+#include <lfrfid/tools/fsk_demod.h>
+#include "lfrfid_demods.h"
+
+#define FSK_JITTER_TIME (20)
+#define FSK_MIN_TIME (64 - FSK_JITTER_TIME)
+#define FSK_MAX_TIME (80 + FSK_JITTER_TIME)
+
+#define MANCHESTER_RF32_SHORT_TIME (128)
+#define MANCHESTER_RF32_LONG_TIME (256)
+#define MANCHESTER_RF32_JITTER_TIME (60)
+
+#define MANCHESTER_RF32_SHORT_TIME_LOW (MANCHESTER_RF32_SHORT_TIME - MANCHESTER_RF32_JITTER_TIME)
+#define MANCHESTER_RF32_SHORT_TIME_HIGH (MANCHESTER_RF32_SHORT_TIME + MANCHESTER_RF32_JITTER_TIME)
+#define MANCHESTER_RF32_LONG_TIME_LOW (MANCHESTER_RF32_LONG_TIME - MANCHESTER_RF32_JITTER_TIME)
+#define MANCHESTER_RF32_LONG_TIME_HIGH (MANCHESTER_RF32_LONG_TIME + MANCHESTER_RF32_JITTER_TIME)
+
+/*********************** FSK ***********************/
+
+static void* lfrfid_demod_fsk_rf50_alloc(void) {
+    return fsk_demod_alloc(FSK_MIN_TIME, 6, FSK_MAX_TIME, 5);
+}
+
+static void* lfrfid_demod_fsk_rf64_alloc(void) {
+    return fsk_demod_alloc(FSK_MIN_TIME, 8, FSK_MAX_TIME, 6);
+}
+
+static void lfrfid_demod_fsk_reset(FSKDemod* demod) {
+    UNUSED(demod);
+    // FSK demod resyncs on the next valid pulse
+}
+
+const ProtocolDemod lfrfid_demod_fsk_rf50 = {
+    .alloc = lfrfid_demod_fsk_rf50_alloc,
+    .free = (ProtocolDemodFree)fsk_demod_free,
+    .reset = (ProtocolDemodReset)lfrfid_demod_fsk_reset,
+    .feed = (ProtocolDemodFeed)fsk_demod_feed,
+};
+
+const ProtocolDemod lfrfid_demod_fsk_rf64 = {
+    .alloc = lfrfid_demod_fsk_rf64_alloc,
+    .free = (ProtocolDemodFree)fsk_demod_free,
+    .reset = (ProtocolDemodReset)lfrfid_demod_fsk_reset,
+    .feed = (ProtocolDemodFeed)fsk_demod_feed,
+};
+
+/*********************** MANCHESTER ***********************/
+
+static void* lfrfid_demod_manchester_alloc(void) {
+    return malloc(sizeof(ManchesterState));
+}
+
+static void lfrfid_demod_manchester_free(ManchesterState* state) {
+    free(state);
+}
+
+static void lfrfid_demod_manchester_reset(ManchesterState* state) {
+    manchester_advance(*state, ManchesterEventReset, state, NULL);
+}
+
+static void lfrfid_demod_manchester_rf32_feed(
+    ManchesterState* state,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count) {
+    ManchesterEvent event = ManchesterEventReset;
+    *count = 0;
+
+    if(duration > MANCHESTER_RF32_SHORT_TIME_LOW && duration < MANCHESTER_RF32_SHORT_TIME_HIGH) {
+        if(!level) {
+            event = ManchesterEventShortHigh;
+        } else {
+            event = ManchesterEventShortLow;
+        }
+    } else if(
+        duration > MANCHESTER_RF32_LONG_TIME_LOW && duration < MANCHESTER_RF32_LONG_TIME_HIGH) {
+        if(!level) {
+            event = ManchesterEventLongHigh;
+        } else {
+            event = ManchesterEventLongLow;
+        }
+    }
+
+    if(event != ManchesterEventReset) {
+        if(manchester_advance(*state, event, state, value)) {
+            *count = 1;
+        }
+    }
+}
+
+const ProtocolDemod lfrfid_demod_manchester_rf32 = {
+    .alloc = lfrfid_demod_manchester_alloc,
+    .free = (ProtocolDemodFree)lfrfid_demod_manchester_free,
+    .reset = (ProtocolDemodReset)lfrfid_demod_manchester_reset,
+    .feed = (ProtocolDemodFeed)lfrfid_demod_manchester_rf32_feed,
+};
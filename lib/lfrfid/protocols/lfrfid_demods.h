@@ -0,0 +1,15 @@
+#pragma once
+#include <toolbox/protocols/protocol.h>
+
+/**
+ * Demodulators shared by LF RFID protocols, timings are in the read timer ticks.
+ */
+
+/** FSK2a RF/50: fc/8 and fc/10, HID and alike */
+extern const ProtocolDemod lfrfid_demod_fsk_rf50;
+
+/** FSK2a RF/64: fc/8 and fc/10, IoProx */
+extern const ProtocolDemod lfrfid_demod_fsk_rf64;
+
+/** Manchester RF/32 */
+extern const ProtocolDemod lfrfid_demod_manchester_rf32;
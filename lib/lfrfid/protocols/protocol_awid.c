@@ -1,13 +1,9 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
-
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
+#include "lfrfid_demods.h"
 
 #define AWID_DECODED_DATA_SIZE (9)
 
@@ -16,7 +12,8 @@
 #define AWID_ENCODED_DATA_LAST (AWID_ENCODED_DATA_SIZE - 1)
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(AWID_ENCODED_DATA_SIZE * 8)];
 } ProtocolAwidDecoder;
 
 typedef struct {
@@ -33,14 +30,14 @@ typedef struct {
 
 ProtocolAwid* protocol_awid_alloc(void) {
     ProtocolAwid* protocol = malloc(sizeof(ProtocolAwid));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, AWID_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_awid_free(ProtocolAwid* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -50,7 +47,7 @@ uint8_t* protocol_awid_get_data(ProtocolAwid* protocol) {
 };
 
 void protocol_awid_decoder_start(ProtocolAwid* protocol) {
-    memset(protocol->encoded_data, 0, AWID_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static bool protocol_awid_can_be_decoded(uint8_t* data) {
@@ -93,15 +90,16 @@ static void protocol_awid_decode(uint8_t* encoded_data, uint8_t* decoded_data) {
     bit_lib_copy_bits(decoded_data, 0, 66, encoded_data, 8);
 }
 
-bool protocol_awid_decoder_feed(ProtocolAwid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_awid_decoder_feed_bits(ProtocolAwid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, AWID_ENCODED_DATA_SIZE, value);
+            bit_lib_window_push(&protocol->decoder.window, value);
+            if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 8) != 0b00000001) {
+                continue;
+            }
+            bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
             if(protocol_awid_can_be_decoded(protocol->encoded_data)) {
                 protocol_awid_decode(protocol->encoded_data, protocol->data);
 
@@ -242,7 +240,6 @@ const ProtocolBase protocol_awid = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_awid_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_awid_decoder_feed,
         },
     .encoder =
         {
@@ -252,4 +249,6 @@ const ProtocolBase protocol_awid = {
     .render_data = (ProtocolRenderData)protocol_awid_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_awid_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_awid_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_awid_decoder_feed_bits,
 };
\ No newline at end of file
@@ -1,14 +1,10 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 #include <lfrfid/tools/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define FDXA_DATA_SIZE 10
 #define FDXA_PREAMBLE_SIZE 2
 
@@ -21,7 +17,8 @@
 #define FDXA_PREAMBLE_1 0x1D
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(FDXA_ENCODED_DATA_SIZE * 8)];
 } ProtocolFDXADecoder;
 
 typedef struct {
@@ -40,14 +37,14 @@ typedef struct {
 
 ProtocolFDXA* protocol_fdx_a_alloc(void) {
     ProtocolFDXA* protocol = malloc(sizeof(ProtocolFDXA));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, FDXA_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_fdx_a_free(ProtocolFDXA* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -57,7 +54,7 @@ uint8_t* protocol_fdx_a_get_data(ProtocolFDXA* protocol) {
 };
 
 void protocol_fdx_a_decoder_start(ProtocolFDXA* protocol) {
-    memset(protocol->encoded_data, 0, FDXA_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static bool protocol_fdx_a_decode(const uint8_t* from, uint8_t* to) {
@@ -107,15 +104,17 @@ static bool protocol_fdx_a_can_be_decoded(const uint8_t* data) {
     return (parity_sum == 0);
 }
 
-bool protocol_fdx_a_decoder_feed(ProtocolFDXA* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_fdx_a_decoder_feed_bits(ProtocolFDXA* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, FDXA_ENCODED_DATA_SIZE, value);
+            bit_lib_window_push(&protocol->decoder.window, value);
+            if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 16) !=
+               ((FDXA_PREAMBLE_0 << 8) | FDXA_PREAMBLE_1)) {
+                continue;
+            }
+            bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
             if(protocol_fdx_a_can_be_decoded(protocol->encoded_data)) {
                 protocol_fdx_a_decode(protocol->encoded_data, protocol->data);
                 result = true;
@@ -239,7 +238,6 @@ const ProtocolBase protocol_fdx_a = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_fdx_a_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_fdx_a_decoder_feed,
         },
     .encoder =
         {
@@ -249,4 +247,6 @@ const ProtocolBase protocol_fdx_a = {
     .render_data = (ProtocolRenderData)protocol_fdx_a_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_fdx_a_render_data,
     .write_data = (ProtocolWriteData)protocol_fdx_a_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_fdx_a_decoder_feed_bits,
 };
\ No newline at end of file
@@ -28,11 +28,15 @@ typedef struct {
     bool last_level;
     size_t encoded_index;
     uint8_t encoded_data[FDX_B_ENCODED_BYTE_FULL_SIZE];
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(FDX_B_ENCODED_BYTE_FULL_SIZE * 8)];
     uint8_t data[FDXB_DECODED_DATA_SIZE];
 } ProtocolFDXB;
 
 ProtocolFDXB* protocol_fdx_b_alloc(void) {
     ProtocolFDXB* protocol = malloc(sizeof(ProtocolFDXB));
+    bit_lib_window_init(
+        &protocol->window, protocol->window_data, FDX_B_ENCODED_BYTE_FULL_SIZE * 8);
     return protocol;
 };
 
@@ -45,7 +49,7 @@ uint8_t* protocol_fdx_b_get_data(ProtocolFDXB* proto) {
 };
 
 void protocol_fdx_b_decoder_start(ProtocolFDXB* protocol) {
-    memset(protocol->encoded_data, 0, FDX_B_ENCODED_BYTE_FULL_SIZE);
+    bit_lib_window_reset(&protocol->window);
     protocol->last_short = false;
 };
 
@@ -99,6 +103,12 @@ static bool protocol_fdx_b_can_be_decoded(ProtocolFDXB* protocol) {
     return result;
 }
 
+static bool protocol_fdx_b_window_can_be_decoded(ProtocolFDXB* protocol) {
+    if(bit_lib_window_get_bits_32(&protocol->window, 0, 11) != 0b10000000000) return false;
+    bit_lib_window_copy(&protocol->window, protocol->encoded_data);
+    return protocol_fdx_b_can_be_decoded(protocol);
+}
+
 void protocol_fdx_b_decode(ProtocolFDXB* protocol) {
     // remove parity
     bit_lib_remove_bit_every_nth(protocol->encoded_data, 3, 13 * 9, 9);
@@ -157,13 +167,13 @@ bool protocol_fdx_b_decoder_feed(ProtocolFDXB* protocol, bool level, uint32_t du
             protocol->last_short = true;
         } else {
             pushed = true;
-            bit_lib_push_bit(protocol->encoded_data, FDX_B_ENCODED_BYTE_FULL_SIZE, false);
+            bit_lib_window_push(&protocol->window, false);
             protocol->last_short = false;
         }
     } else if(duration >= FDX_B_LONG_TIME_LOW && duration <= FDX_B_LONG_TIME_HIGH) {
         if(protocol->last_short == false) {
             pushed = true;
-            bit_lib_push_bit(protocol->encoded_data, FDX_B_ENCODED_BYTE_FULL_SIZE, true);
+            bit_lib_window_push(&protocol->window, true);
         } else {
             // reset
             protocol->last_short = false;
@@ -173,7 +183,7 @@ bool protocol_fdx_b_decoder_feed(ProtocolFDXB* protocol, bool level, uint32_t du
         protocol->last_short = false;
     }
 
-    if(pushed && protocol_fdx_b_can_be_decoded(protocol)) {
+    if(pushed && protocol_fdx_b_window_can_be_decoded(protocol)) {
         protocol_fdx_b_decode(protocol);
         result = true;
     }
@@ -1,8 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define GALLAGHER_CLOCK_PER_BIT (32)
 
@@ -14,27 +14,19 @@
     (GALLAGHER_ENCODED_BYTE_SIZE + GALLAGHER_PREAMBLE_BYTE_SIZE)
 #define GALLAGHER_DECODED_DATA_SIZE 8
 
-#define GALLAGHER_READ_SHORT_TIME (128)
-#define GALLAGHER_READ_LONG_TIME (256)
-#define GALLAGHER_READ_JITTER_TIME (60)
-
-#define GALLAGHER_READ_SHORT_TIME_LOW (GALLAGHER_READ_SHORT_TIME - GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_SHORT_TIME_HIGH (GALLAGHER_READ_SHORT_TIME + GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_LONG_TIME_LOW (GALLAGHER_READ_LONG_TIME - GALLAGHER_READ_JITTER_TIME)
-#define GALLAGHER_READ_LONG_TIME_HIGH (GALLAGHER_READ_LONG_TIME + GALLAGHER_READ_JITTER_TIME)
-
 typedef struct {
     uint8_t data[GALLAGHER_DECODED_DATA_SIZE];
     uint8_t encoded_data[GALLAGHER_ENCODED_BYTE_FULL_SIZE];
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(GALLAGHER_ENCODED_BYTE_FULL_SIZE * 8)];
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolGallagher;
 
 ProtocolGallagher* protocol_gallagher_alloc(void) {
     ProtocolGallagher* proto = malloc(sizeof(ProtocolGallagher));
+    bit_lib_window_init(&proto->window, proto->window_data, GALLAGHER_ENCODED_BYTE_FULL_SIZE * 8);
     return (void*)proto;
 };
 
@@ -145,47 +137,29 @@ static bool protocol_gallagher_can_be_decoded(ProtocolGallagher* protocol) {
     return true;
 }
 
+static bool protocol_gallagher_window_can_be_decoded(ProtocolGallagher* protocol) {
+    if(bit_lib_window_get_bits_32(&protocol->window, 0, 16) != 0b0111111111101010) return false;
+    bit_lib_window_copy(&protocol->window, protocol->encoded_data);
+    return protocol_gallagher_can_be_decoded(protocol);
+}
+
 void protocol_gallagher_decoder_start(ProtocolGallagher* protocol) {
-    memset(protocol->encoded_data, 0, GALLAGHER_ENCODED_BYTE_FULL_SIZE);
-    manchester_advance(
-        protocol->decoder_manchester_state,
-        ManchesterEventReset,
-        &protocol->decoder_manchester_state,
-        NULL);
+    bit_lib_window_reset(&protocol->window);
 };
 
-bool protocol_gallagher_decoder_feed(ProtocolGallagher* protocol, bool level, uint32_t duration) {
+bool protocol_gallagher_decoder_feed_bits(
+    ProtocolGallagher* protocol,
+    bool value,
+    uint32_t count) {
+    // Manchester demod yields a single bit per pulse
+    UNUSED(count);
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > GALLAGHER_READ_SHORT_TIME_LOW && duration < GALLAGHER_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > GALLAGHER_READ_LONG_TIME_LOW && duration < GALLAGHER_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            protocol->decoder_manchester_state, event, &protocol->decoder_manchester_state, &data);
+    bit_lib_window_push(&protocol->window, value);
 
-        if(data_ok) {
-            bit_lib_push_bit(protocol->encoded_data, GALLAGHER_ENCODED_BYTE_FULL_SIZE, data);
-
-            if(protocol_gallagher_can_be_decoded(protocol)) {
-                protocol_gallagher_decode(protocol);
-                result = true;
-            }
-        }
+    if(protocol_gallagher_window_can_be_decoded(protocol)) {
+        protocol_gallagher_decode(protocol);
+        result = true;
     }
 
     return result;
@@ -291,7 +265,6 @@ const ProtocolBase protocol_gallagher = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_gallagher_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_gallagher_decoder_feed,
         },
     .encoder =
         {
@@ -301,4 +274,6 @@ const ProtocolBase protocol_gallagher = {
     .render_data = (ProtocolRenderData)protocol_gallagher_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_gallagher_render_data,
     .write_data = (ProtocolWriteData)protocol_gallagher_write_data,
+    .demod = &lfrfid_demod_manchester_rf32,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_gallagher_decoder_feed_bits,
 };
\ No newline at end of file
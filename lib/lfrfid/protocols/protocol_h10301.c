@@ -1,12 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
-
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
+#include "lfrfid_demods.h"
 
 #define H10301_DECODED_DATA_SIZE (3)
 #define H10301_ENCODED_DATA_SIZE_U32 (3)
@@ -15,10 +11,6 @@
 #define H10301_BIT_SIZE (sizeof(uint32_t) * 8)
 #define H10301_BIT_MAX_SIZE (H10301_BIT_SIZE * H10301_DECODED_DATA_SIZE)
 
-typedef struct {
-    FSKDemod* fsk_demod;
-} ProtocolH10301Decoder;
-
 typedef struct {
     FSKOsc* fsk_osc;
     uint8_t encoded_index;
@@ -26,7 +18,6 @@ typedef struct {
 } ProtocolH10301Encoder;
 
 typedef struct {
-    ProtocolH10301Decoder decoder;
     ProtocolH10301Encoder encoder;
     uint32_t encoded_data[H10301_ENCODED_DATA_SIZE_U32];
     uint8_t data[H10301_DECODED_DATA_SIZE];
@@ -34,14 +25,12 @@ typedef struct {
 
 ProtocolH10301* protocol_h10301_alloc(void) {
     ProtocolH10301* protocol = malloc(sizeof(ProtocolH10301));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_h10301_free(ProtocolH10301* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -187,12 +176,9 @@ static void protocol_h10301_decode(const uint32_t* card_data, uint8_t* decoded_d
     memcpy(decoded_data, &data, H10301_DECODED_DATA_SIZE);
 }
 
-bool protocol_h10301_decoder_feed(ProtocolH10301* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_h10301_decoder_feed_bits(ProtocolH10301* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
             protocol_h10301_decoder_store_data(protocol, value);
@@ -377,7 +363,6 @@ const ProtocolBase protocol_h10301 = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_h10301_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_h10301_decoder_feed,
         },
     .encoder =
         {
@@ -387,4 +372,6 @@ const ProtocolBase protocol_h10301 = {
     .render_data = (ProtocolRenderData)protocol_h10301_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_h10301_render_data,
     .write_data = (ProtocolWriteData)protocol_h10301_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_h10301_decoder_feed_bits,
 };
\ No newline at end of file
@@ -1,14 +1,10 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 #include <lfrfid/tools/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define HID_DATA_SIZE 23
 #define HID_PREAMBLE_SIZE 1
 
@@ -20,7 +16,8 @@
 #define HID_PREAMBLE 0x1D
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(HID_ENCODED_DATA_SIZE * 8)];
 } ProtocolHIDExDecoder;
 
 typedef struct {
@@ -39,14 +36,14 @@ typedef struct {
 
 ProtocolHIDEx* protocol_hid_ex_generic_alloc(void) {
     ProtocolHIDEx* protocol = malloc(sizeof(ProtocolHIDEx));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, HID_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_hid_ex_generic_free(ProtocolHIDEx* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -56,7 +53,7 @@ uint8_t* protocol_hid_ex_generic_get_data(ProtocolHIDEx* protocol) {
 };
 
 void protocol_hid_ex_generic_decoder_start(ProtocolHIDEx* protocol) {
-    memset(protocol->encoded_data, 0, HID_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static bool protocol_hid_ex_generic_can_be_decoded(const uint8_t* data) {
@@ -93,15 +90,19 @@ static void protocol_hid_ex_generic_decode(const uint8_t* from, uint8_t* to) {
     }
 }
 
-bool protocol_hid_ex_generic_decoder_feed(ProtocolHIDEx* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_hid_ex_generic_decoder_feed_bits(
+    ProtocolHIDEx* protocol,
+    bool value,
+    uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, HID_ENCODED_DATA_SIZE, value);
+            bit_lib_window_push(&protocol->decoder.window, value);
+            if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 8) != HID_PREAMBLE) {
+                continue;
+            }
+            bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
             if(protocol_hid_ex_generic_can_be_decoded(protocol->encoded_data)) {
                 protocol_hid_ex_generic_decode(protocol->encoded_data, protocol->data);
                 result = true;
@@ -210,7 +211,6 @@ const ProtocolBase protocol_hid_ex_generic = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_hid_ex_generic_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_hid_ex_generic_decoder_feed,
         },
     .encoder =
         {
@@ -220,4 +220,6 @@ const ProtocolBase protocol_hid_ex_generic = {
     .render_data = (ProtocolRenderData)protocol_hid_ex_generic_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_hid_ex_generic_render_data,
     .write_data = (ProtocolWriteData)protocol_hid_ex_generic_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_hid_ex_generic_decoder_feed_bits,
 };
\ No newline at end of file
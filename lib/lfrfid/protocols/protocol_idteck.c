@@ -34,6 +34,11 @@ typedef struct {
     uint8_t negative_encoded_data[IDTECK_ENCODED_DATA_SIZE];
     uint8_t corrupted_encoded_data[IDTECK_ENCODED_DATA_SIZE];
     uint8_t corrupted_negative_encoded_data[IDTECK_ENCODED_DATA_SIZE];
+    BitLibWindow window;
+    BitLibWindow negative_window;
+    BitLibWindow corrupted_window;
+    BitLibWindow corrupted_negative_window;
+    uint8_t window_data[4][BIT_LIB_WINDOW_DATA_SIZE(IDTECK_ENCODED_DATA_SIZE * 8)];
 
     uint8_t data[IDTECK_DECODED_DATA_SIZE];
     ProtocolIdteckEncoder encoder;
@@ -41,6 +46,15 @@ typedef struct {
 
 ProtocolIdteck* protocol_idteck_alloc(void) {
     ProtocolIdteck* protocol = malloc(sizeof(ProtocolIdteck));
+    bit_lib_window_init(&protocol->window, protocol->window_data[0], IDTECK_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->negative_window, protocol->window_data[1], IDTECK_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_window, protocol->window_data[2], IDTECK_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_negative_window,
+        protocol->window_data[3],
+        IDTECK_ENCODED_DATA_SIZE * 8);
     return protocol;
 };
 
@@ -53,10 +67,10 @@ uint8_t* protocol_idteck_get_data(ProtocolIdteck* protocol) {
 };
 
 void protocol_idteck_decoder_start(ProtocolIdteck* protocol) {
-    memset(protocol->encoded_data, 0, IDTECK_ENCODED_DATA_SIZE);
-    memset(protocol->negative_encoded_data, 0, IDTECK_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_encoded_data, 0, IDTECK_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_negative_encoded_data, 0, IDTECK_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->window);
+    bit_lib_window_reset(&protocol->negative_window);
+    bit_lib_window_reset(&protocol->corrupted_window);
+    bit_lib_window_reset(&protocol->corrupted_negative_window);
 };
 
 static bool protocol_idteck_check_preamble(uint8_t* data, size_t bit_index) {
@@ -70,7 +84,11 @@ static bool protocol_idteck_can_be_decoded(uint8_t* data) {
     return true;
 }
 
-static bool protocol_idteck_decoder_feed_internal(bool polarity, uint32_t time, uint8_t* data) {
+static bool protocol_idteck_decoder_feed_internal(
+    bool polarity,
+    uint32_t time,
+    BitLibWindow* window,
+    uint8_t* data) {
     time += (IDTECK_US_PER_BIT / 2);
 
     size_t bit_count = (time / IDTECK_US_PER_BIT);
@@ -78,7 +96,9 @@ static bool protocol_idteck_decoder_feed_internal(bool polarity, uint32_t time,
 
     if(bit_count < IDTECK_ENCODED_BIT_SIZE) {
         for(size_t i = 0; i < bit_count; i++) {
-            bit_lib_push_bit(data, IDTECK_ENCODED_DATA_SIZE, polarity);
+            bit_lib_window_push(window, polarity);
+            if(bit_lib_window_get_bits_32(window, 0, 8) != 0b01001001) continue;
+            bit_lib_window_copy(window, data);
             if(protocol_idteck_can_be_decoded(data)) {
                 result = true;
                 break;
@@ -97,7 +117,8 @@ bool protocol_idteck_decoder_feed(ProtocolIdteck* protocol, bool level, uint32_t
     bool result = false;
 
     if(duration > (IDTECK_US_PER_BIT / 2)) {
-        if(protocol_idteck_decoder_feed_internal(level, duration, protocol->encoded_data)) {
+        if(protocol_idteck_decoder_feed_internal(
+               level, duration, &protocol->window, protocol->encoded_data)) {
             protocol_idteck_decoder_save(protocol->data, protocol->encoded_data);
             FURI_LOG_D("Idteck", "Positive");
             result = true;
@@ -105,7 +126,7 @@ bool protocol_idteck_decoder_feed(ProtocolIdteck* protocol, bool level, uint32_t
         }
 
         if(protocol_idteck_decoder_feed_internal(
-               !level, duration, protocol->negative_encoded_data)) {
+               !level, duration, &protocol->negative_window, protocol->negative_encoded_data)) {
             protocol_idteck_decoder_save(protocol->data, protocol->negative_encoded_data);
             FURI_LOG_D("Idteck", "Negative");
             result = true;
@@ -124,7 +145,7 @@ bool protocol_idteck_decoder_feed(ProtocolIdteck* protocol, bool level, uint32_t
         }
 
         if(protocol_idteck_decoder_feed_internal(
-               level, duration, protocol->corrupted_encoded_data)) {
+               level, duration, &protocol->corrupted_window, protocol->corrupted_encoded_data)) {
             protocol_idteck_decoder_save(protocol->data, protocol->corrupted_encoded_data);
             FURI_LOG_D("Idteck", "Positive Corrupted");
 
@@ -133,7 +154,10 @@ bool protocol_idteck_decoder_feed(ProtocolIdteck* protocol, bool level, uint32_t
         }
 
         if(protocol_idteck_decoder_feed_internal(
-               !level, duration, protocol->corrupted_negative_encoded_data)) {
+               !level,
+               duration,
+               &protocol->corrupted_negative_window,
+               protocol->corrupted_negative_encoded_data)) {
             protocol_idteck_decoder_save(
                 protocol->data, protocol->corrupted_negative_encoded_data);
             FURI_LOG_D("Idteck", "Negative Corrupted");
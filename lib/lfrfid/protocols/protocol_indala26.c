@@ -30,6 +30,11 @@ typedef struct {
     uint8_t negative_encoded_data[INDALA26_ENCODED_DATA_SIZE];
     uint8_t corrupted_encoded_data[INDALA26_ENCODED_DATA_SIZE];
     uint8_t corrupted_negative_encoded_data[INDALA26_ENCODED_DATA_SIZE];
+    BitLibWindow window;
+    BitLibWindow negative_window;
+    BitLibWindow corrupted_window;
+    BitLibWindow corrupted_negative_window;
+    uint8_t window_data[4][BIT_LIB_WINDOW_DATA_SIZE(INDALA26_ENCODED_DATA_SIZE * 8)];
 
     uint8_t data[INDALA26_DECODED_DATA_SIZE];
     ProtocolIndalaEncoder encoder;
@@ -37,6 +42,16 @@ typedef struct {
 
 ProtocolIndala* protocol_indala26_alloc(void) {
     ProtocolIndala* protocol = malloc(sizeof(ProtocolIndala));
+    bit_lib_window_init(
+        &protocol->window, protocol->window_data[0], INDALA26_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->negative_window, protocol->window_data[1], INDALA26_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_window, protocol->window_data[2], INDALA26_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_negative_window,
+        protocol->window_data[3],
+        INDALA26_ENCODED_DATA_SIZE * 8);
     return protocol;
 };
 
@@ -49,10 +64,10 @@ uint8_t* protocol_indala26_get_data(ProtocolIndala* protocol) {
 };
 
 void protocol_indala26_decoder_start(ProtocolIndala* protocol) {
-    memset(protocol->encoded_data, 0, INDALA26_ENCODED_DATA_SIZE);
-    memset(protocol->negative_encoded_data, 0, INDALA26_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_encoded_data, 0, INDALA26_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_negative_encoded_data, 0, INDALA26_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->window);
+    bit_lib_window_reset(&protocol->negative_window);
+    bit_lib_window_reset(&protocol->corrupted_window);
+    bit_lib_window_reset(&protocol->corrupted_negative_window);
 };
 
 static bool protocol_indala26_check_preamble(uint8_t* data, size_t bit_index) {
@@ -70,7 +85,11 @@ static bool protocol_indala26_can_be_decoded(uint8_t* data) {
     return true;
 }
 
-static bool protocol_indala26_decoder_feed_internal(bool polarity, uint32_t time, uint8_t* data) {
+static bool protocol_indala26_decoder_feed_internal(
+    bool polarity,
+    uint32_t time,
+    BitLibWindow* window,
+    uint8_t* data) {
     time += (INDALA26_US_PER_BIT / 2);
 
     size_t bit_count = (time / INDALA26_US_PER_BIT);
@@ -78,7 +97,9 @@ static bool protocol_indala26_decoder_feed_internal(bool polarity, uint32_t time
 
     if(bit_count < INDALA26_ENCODED_BIT_SIZE) {
         for(size_t i = 0; i < bit_count; i++) {
-            bit_lib_push_bit(data, INDALA26_ENCODED_DATA_SIZE, polarity);
+            bit_lib_window_push(window, polarity);
+            if(bit_lib_window_get_bits_32(window, 0, 8) != 0b10100000) continue;
+            bit_lib_window_copy(window, data);
             if(protocol_indala26_can_be_decoded(data)) {
                 result = true;
                 break;
@@ -99,7 +120,8 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
     bool result = false;
 
     if(duration > (INDALA26_US_PER_BIT / 2)) {
-        if(protocol_indala26_decoder_feed_internal(level, duration, protocol->encoded_data)) {
+        if(protocol_indala26_decoder_feed_internal(
+               level, duration, &protocol->window, protocol->encoded_data)) {
             protocol_indala26_decoder_save(protocol->data, protocol->encoded_data);
             FURI_LOG_D("Indala26", "Positive");
             result = true;
@@ -107,7 +129,7 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
         }
 
         if(protocol_indala26_decoder_feed_internal(
-               !level, duration, protocol->negative_encoded_data)) {
+               !level, duration, &protocol->negative_window, protocol->negative_encoded_data)) {
             protocol_indala26_decoder_save(protocol->data, protocol->negative_encoded_data);
             FURI_LOG_D("Indala26", "Negative");
             result = true;
@@ -126,7 +148,7 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
         }
 
         if(protocol_indala26_decoder_feed_internal(
-               level, duration, protocol->corrupted_encoded_data)) {
+               level, duration, &protocol->corrupted_window, protocol->corrupted_encoded_data)) {
             protocol_indala26_decoder_save(protocol->data, protocol->corrupted_encoded_data);
             FURI_LOG_D("Indala26", "Positive Corrupted");
 
@@ -135,7 +157,10 @@ bool protocol_indala26_decoder_feed(ProtocolIndala* protocol, bool level, uint32
         }
 
         if(protocol_indala26_decoder_feed_internal(
-               !level, duration, protocol->corrupted_negative_encoded_data)) {
+               !level,
+               duration,
+               &protocol->corrupted_negative_window,
+               protocol->corrupted_negative_encoded_data)) {
             protocol_indala26_decoder_save(
                 protocol->data, protocol->corrupted_negative_encoded_data);
             FURI_LOG_D("Indala26", "Negative Corrupted");
@@ -1,13 +1,9 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
-
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
+#include "lfrfid_demods.h"
 
 #define IOPROXXSF_DECODED_DATA_SIZE (4)
 #define IOPROXXSF_ENCODED_DATA_SIZE (8)
@@ -16,7 +12,8 @@
 #define IOPROXXSF_BIT_MAX_SIZE (IOPROXXSF_BIT_SIZE * IOPROXXSF_ENCODED_DATA_SIZE)
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(IOPROXXSF_ENCODED_DATA_SIZE * 8)];
 } ProtocolIOProxXSFDecoder;
 
 typedef struct {
@@ -33,13 +30,13 @@ typedef struct {
 
 ProtocolIOProxXSF* protocol_io_prox_xsf_alloc(void) {
     ProtocolIOProxXSF* protocol = malloc(sizeof(ProtocolIOProxXSF));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 8, MAX_TIME, 6);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, IOPROXXSF_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 64);
     return protocol;
 };
 
 void protocol_io_prox_xsf_free(ProtocolIOProxXSF* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -49,7 +46,7 @@ uint8_t* protocol_io_prox_xsf_get_data(ProtocolIOProxXSF* protocol) {
 };
 
 void protocol_io_prox_xsf_decoder_start(ProtocolIOProxXSF* protocol) {
-    memset(protocol->encoded_data, 0, IOPROXXSF_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static uint8_t protocol_io_prox_xsf_compute_checksum(const uint8_t* data) {
@@ -155,15 +152,18 @@ void protocol_io_prox_xsf_decode(const uint8_t* encoded_data, uint8_t* decoded_d
     decoded_data[3] = bit_lib_get_bits(encoded_data, 45, 8);
 }
 
-bool protocol_io_prox_xsf_decoder_feed(ProtocolIOProxXSF* protocol, bool level, uint32_t duration) {
+bool protocol_io_prox_xsf_decoder_feed_bits(
+    ProtocolIOProxXSF* protocol,
+    bool value,
+    uint32_t count) {
     bool result = false;
 
-    uint32_t count;
-    bool value;
-
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     for(size_t i = 0; i < count; i++) {
-        bit_lib_push_bit(protocol->encoded_data, IOPROXXSF_ENCODED_DATA_SIZE, value);
+        bit_lib_window_push(&protocol->decoder.window, value);
+        if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 10) != 0b0000000001) {
+            continue;
+        }
+        bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
         if(protocol_io_prox_xsf_can_be_decoded(protocol->encoded_data)) {
             protocol_io_prox_xsf_decode(protocol->encoded_data, protocol->data);
             result = true;
@@ -288,7 +288,6 @@ const ProtocolBase protocol_io_prox_xsf = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_io_prox_xsf_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_io_prox_xsf_decoder_feed,
         },
     .encoder =
         {
@@ -298,4 +297,6 @@ const ProtocolBase protocol_io_prox_xsf = {
     .render_data = (ProtocolRenderData)protocol_io_prox_xsf_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_io_prox_xsf_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_io_prox_xsf_write_data,
+    .demod = &lfrfid_demod_fsk_rf64,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_io_prox_xsf_decoder_feed_bits,
 };
\ No newline at end of file
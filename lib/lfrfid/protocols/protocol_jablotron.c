@@ -28,11 +28,15 @@ typedef struct {
     bool last_level;
     size_t encoded_index;
     uint8_t encoded_data[JABLOTRON_ENCODED_BYTE_FULL_SIZE];
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(JABLOTRON_ENCODED_BYTE_FULL_SIZE * 8)];
     uint8_t data[JABLOTRON_DECODED_DATA_SIZE];
 } ProtocolJablotron;
 
 ProtocolJablotron* protocol_jablotron_alloc(void) {
     ProtocolJablotron* protocol = malloc(sizeof(ProtocolJablotron));
+    bit_lib_window_init(
+        &protocol->window, protocol->window_data, JABLOTRON_ENCODED_BYTE_FULL_SIZE * 8);
     return protocol;
 };
 
@@ -45,7 +49,7 @@ uint8_t* protocol_jablotron_get_data(ProtocolJablotron* proto) {
 };
 
 void protocol_jablotron_decoder_start(ProtocolJablotron* protocol) {
-    memset(protocol->encoded_data, 0, JABLOTRON_ENCODED_BYTE_FULL_SIZE);
+    bit_lib_window_reset(&protocol->window);
     protocol->last_short = false;
 };
 
@@ -79,6 +83,12 @@ static bool protocol_jablotron_can_be_decoded(ProtocolJablotron* protocol) {
     return true;
 }
 
+static bool protocol_jablotron_window_can_be_decoded(ProtocolJablotron* protocol) {
+    if(bit_lib_window_get_bits_32(&protocol->window, 0, 16) != 0b1111111111111111) return false;
+    bit_lib_window_copy(&protocol->window, protocol->encoded_data);
+    return protocol_jablotron_can_be_decoded(protocol);
+}
+
 void protocol_jablotron_decode(ProtocolJablotron* protocol) {
     bit_lib_copy_bits(protocol->data, 0, 40, protocol->encoded_data, 16);
 }
@@ -93,13 +103,13 @@ bool protocol_jablotron_decoder_feed(ProtocolJablotron* protocol, bool level, ui
             protocol->last_short = true;
         } else {
             pushed = true;
-            bit_lib_push_bit(protocol->encoded_data, JABLOTRON_ENCODED_BYTE_FULL_SIZE, false);
+            bit_lib_window_push(&protocol->window, false);
             protocol->last_short = false;
         }
     } else if(duration >= JABLOTRON_LONG_TIME_LOW && duration <= JABLOTRON_LONG_TIME_HIGH) {
         if(protocol->last_short == false) {
             pushed = true;
-            bit_lib_push_bit(protocol->encoded_data, JABLOTRON_ENCODED_BYTE_FULL_SIZE, true);
+            bit_lib_window_push(&protocol->window, true);
         } else {
             // reset
             protocol->last_short = false;
@@ -109,7 +119,7 @@ bool protocol_jablotron_decoder_feed(ProtocolJablotron* protocol, bool level, ui
         protocol->last_short = false;
     }
 
-    if(pushed && protocol_jablotron_can_be_decoded(protocol)) {
+    if(pushed && protocol_jablotron_window_can_be_decoded(protocol)) {
         protocol_jablotron_decode(protocol);
         return true;
     }
@@ -29,6 +29,11 @@ typedef struct {
     uint8_t negative_encoded_data[KERI_ENCODED_DATA_SIZE];
     uint8_t corrupted_encoded_data[KERI_ENCODED_DATA_SIZE];
     uint8_t corrupted_negative_encoded_data[KERI_ENCODED_DATA_SIZE];
+    BitLibWindow window;
+    BitLibWindow negative_window;
+    BitLibWindow corrupted_window;
+    BitLibWindow corrupted_negative_window;
+    uint8_t window_data[4][BIT_LIB_WINDOW_DATA_SIZE(KERI_ENCODED_DATA_SIZE * 8)];
 
     uint8_t data[KERI_DECODED_DATA_SIZE];
     ProtocolKeriEncoder encoder;
@@ -36,6 +41,15 @@ typedef struct {
 
 ProtocolKeri* protocol_keri_alloc(void) {
     ProtocolKeri* protocol = malloc(sizeof(ProtocolKeri));
+    bit_lib_window_init(&protocol->window, protocol->window_data[0], KERI_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->negative_window, protocol->window_data[1], KERI_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_window, protocol->window_data[2], KERI_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_negative_window,
+        protocol->window_data[3],
+        KERI_ENCODED_DATA_SIZE * 8);
     return protocol;
 };
 
@@ -48,10 +62,10 @@ uint8_t* protocol_keri_get_data(ProtocolKeri* protocol) {
 };
 
 void protocol_keri_decoder_start(ProtocolKeri* protocol) {
-    memset(protocol->encoded_data, 0, KERI_ENCODED_DATA_SIZE);
-    memset(protocol->negative_encoded_data, 0, KERI_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_encoded_data, 0, KERI_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_negative_encoded_data, 0, KERI_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->window);
+    bit_lib_window_reset(&protocol->negative_window);
+    bit_lib_window_reset(&protocol->corrupted_window);
+    bit_lib_window_reset(&protocol->corrupted_negative_window);
 };
 
 static bool protocol_keri_check_preamble(uint8_t* data, size_t bit_index) {
@@ -69,7 +83,11 @@ static bool protocol_keri_can_be_decoded(uint8_t* data) {
     return true;
 }
 
-static bool protocol_keri_decoder_feed_internal(bool polarity, uint32_t time, uint8_t* data) {
+static bool protocol_keri_decoder_feed_internal(
+    bool polarity,
+    uint32_t time,
+    BitLibWindow* window,
+    uint8_t* data) {
     time += (KERI_US_PER_BIT / 2);
 
     size_t bit_count = (time / KERI_US_PER_BIT);
@@ -77,7 +95,9 @@ static bool protocol_keri_decoder_feed_internal(bool polarity, uint32_t time, ui
 
     if(bit_count < KERI_ENCODED_BIT_SIZE) {
         for(size_t i = 0; i < bit_count; i++) {
-            bit_lib_push_bit(data, KERI_ENCODED_DATA_SIZE, polarity);
+            bit_lib_window_push(window, polarity);
+            if(bit_lib_window_get_bits_32(window, 0, 8) != 0b11100000) continue;
+            bit_lib_window_copy(window, data);
             if(protocol_keri_can_be_decoded(data)) {
                 result = true;
                 break;
@@ -124,13 +144,15 @@ bool protocol_keri_decoder_feed(ProtocolKeri* protocol, bool level, uint32_t dur
     bool result = false;
 
     if(duration > (KERI_US_PER_BIT / 2)) {
-        if(protocol_keri_decoder_feed_internal(level, duration, protocol->encoded_data)) {
+        if(protocol_keri_decoder_feed_internal(
+               level, duration, &protocol->window, protocol->encoded_data)) {
             protocol_keri_decoder_save(protocol->data, protocol->encoded_data);
             result = true;
             return result;
         }
 
-        if(protocol_keri_decoder_feed_internal(!level, duration, protocol->negative_encoded_data)) {
+        if(protocol_keri_decoder_feed_internal(
+               !level, duration, &protocol->negative_window, protocol->negative_encoded_data)) {
             protocol_keri_decoder_save(protocol->data, protocol->negative_encoded_data);
             result = true;
             return result;
@@ -147,7 +169,8 @@ bool protocol_keri_decoder_feed(ProtocolKeri* protocol, bool level, uint32_t dur
             }
         }
 
-        if(protocol_keri_decoder_feed_internal(level, duration, protocol->corrupted_encoded_data)) {
+        if(protocol_keri_decoder_feed_internal(
+               level, duration, &protocol->corrupted_window, protocol->corrupted_encoded_data)) {
             protocol_keri_decoder_save(protocol->data, protocol->corrupted_encoded_data);
 
             result = true;
@@ -155,7 +178,10 @@ bool protocol_keri_decoder_feed(ProtocolKeri* protocol, bool level, uint32_t dur
         }
 
         if(protocol_keri_decoder_feed_internal(
-               !level, duration, protocol->corrupted_negative_encoded_data)) {
+               !level,
+               duration,
+               &protocol->corrupted_negative_window,
+               protocol->corrupted_negative_encoded_data)) {
             protocol_keri_decoder_save(protocol->data, protocol->corrupted_negative_encoded_data);
 
             result = true;
@@ -39,6 +39,11 @@ typedef struct {
     uint8_t negative_encoded_data[NEXWATCH_ENCODED_DATA_SIZE];
     uint8_t corrupted_encoded_data[NEXWATCH_ENCODED_DATA_SIZE];
     uint8_t corrupted_negative_encoded_data[NEXWATCH_ENCODED_DATA_SIZE];
+    BitLibWindow window;
+    BitLibWindow negative_window;
+    BitLibWindow corrupted_window;
+    BitLibWindow corrupted_negative_window;
+    uint8_t window_data[4][BIT_LIB_WINDOW_DATA_SIZE(NEXWATCH_ENCODED_DATA_SIZE * 8)];
 
     uint8_t data[NEXWATCH_DECODED_DATA_SIZE];
     ProtocolNexwatchEncoder encoder;
@@ -46,6 +51,16 @@ typedef struct {
 
 ProtocolNexwatch* protocol_nexwatch_alloc(void) {
     ProtocolNexwatch* protocol = malloc(sizeof(ProtocolNexwatch));
+    bit_lib_window_init(
+        &protocol->window, protocol->window_data[0], NEXWATCH_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->negative_window, protocol->window_data[1], NEXWATCH_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_window, protocol->window_data[2], NEXWATCH_ENCODED_DATA_SIZE * 8);
+    bit_lib_window_init(
+        &protocol->corrupted_negative_window,
+        protocol->window_data[3],
+        NEXWATCH_ENCODED_DATA_SIZE * 8);
     return protocol;
 };
 
@@ -58,10 +73,10 @@ uint8_t* protocol_nexwatch_get_data(ProtocolNexwatch* protocol) {
 };
 
 void protocol_nexwatch_decoder_start(ProtocolNexwatch* protocol) {
-    memset(protocol->encoded_data, 0, NEXWATCH_ENCODED_DATA_SIZE);
-    memset(protocol->negative_encoded_data, 0, NEXWATCH_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_encoded_data, 0, NEXWATCH_ENCODED_DATA_SIZE);
-    memset(protocol->corrupted_negative_encoded_data, 0, NEXWATCH_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->window);
+    bit_lib_window_reset(&protocol->negative_window);
+    bit_lib_window_reset(&protocol->corrupted_window);
+    bit_lib_window_reset(&protocol->corrupted_negative_window);
 };
 
 static bool protocol_nexwatch_check_preamble(uint8_t* data, size_t bit_index) {
@@ -124,7 +139,11 @@ static bool protocol_nexwatch_can_be_decoded(uint8_t* data) {
     return true;
 }
 
-static bool protocol_nexwatch_decoder_feed_internal(bool polarity, uint32_t time, uint8_t* data) {
+static bool protocol_nexwatch_decoder_feed_internal(
+    bool polarity,
+    uint32_t time,
+    BitLibWindow* window,
+    uint8_t* data) {
     time += (NEXWATCH_US_PER_BIT / 2);
 
     size_t bit_count = (time / NEXWATCH_US_PER_BIT);
@@ -132,7 +151,9 @@ static bool protocol_nexwatch_decoder_feed_internal(bool polarity, uint32_t time
 
     if(bit_count < NEXWATCH_ENCODED_BIT_SIZE) {
         for(size_t i = 0; i < bit_count; i++) {
-            bit_lib_push_bit(data, NEXWATCH_ENCODED_DATA_SIZE, polarity);
+            bit_lib_window_push(window, polarity);
+            if(bit_lib_window_get_bits_32(window, 0, 8) != 0b01010110) continue;
+            bit_lib_window_copy(window, data);
             if(protocol_nexwatch_can_be_decoded(data)) {
                 result = true;
                 break;
@@ -172,14 +193,15 @@ bool protocol_nexwatch_decoder_feed(ProtocolNexwatch* protocol, bool level, uint
     bool result = false;
 
     if(duration > (NEXWATCH_US_PER_BIT / 2)) {
-        if(protocol_nexwatch_decoder_feed_internal(level, duration, protocol->encoded_data)) {
+        if(protocol_nexwatch_decoder_feed_internal(
+               level, duration, &protocol->window, protocol->encoded_data)) {
             protocol_nexwatch_decoder_save(protocol->data, protocol->encoded_data);
             result = true;
             return result;
         }
 
         if(protocol_nexwatch_decoder_feed_internal(
-               !level, duration, protocol->negative_encoded_data)) {
+               !level, duration, &protocol->negative_window, protocol->negative_encoded_data)) {
             protocol_nexwatch_decoder_save(protocol->data, protocol->negative_encoded_data);
             result = true;
             return result;
@@ -197,7 +219,7 @@ bool protocol_nexwatch_decoder_feed(ProtocolNexwatch* protocol, bool level, uint
         }
 
         if(protocol_nexwatch_decoder_feed_internal(
-               level, duration, protocol->corrupted_encoded_data)) {
+               level, duration, &protocol->corrupted_window, protocol->corrupted_encoded_data)) {
             protocol_nexwatch_decoder_save(protocol->data, protocol->corrupted_encoded_data);
 
             result = true;
@@ -205,7 +227,10 @@ bool protocol_nexwatch_decoder_feed(ProtocolNexwatch* protocol, bool level, uint
         }
 
         if(protocol_nexwatch_decoder_feed_internal(
-               !level, duration, protocol->corrupted_negative_encoded_data)) {
+               !level,
+               duration,
+               &protocol->corrupted_negative_window,
+               protocol->corrupted_negative_encoded_data)) {
             protocol_nexwatch_decoder_save(
                 protocol->data, protocol->corrupted_negative_encoded_data);
 
@@ -27,11 +27,15 @@ typedef struct {
     bool got_preamble;
     size_t encoded_index;
     uint8_t encoded_data[PAC_STANLEY_ENCODED_BYTE_FULL_SIZE];
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(PAC_STANLEY_ENCODED_BYTE_FULL_SIZE * 8)];
     uint8_t data[PAC_STANLEY_DECODED_DATA_SIZE];
 } ProtocolPACStanley;
 
 ProtocolPACStanley* protocol_pac_stanley_alloc(void) {
     ProtocolPACStanley* protocol = malloc(sizeof(ProtocolPACStanley));
+    bit_lib_window_init(
+        &protocol->window, protocol->window_data, PAC_STANLEY_ENCODED_BYTE_FULL_SIZE * 8);
     return (void*)protocol;
 }
 
@@ -85,7 +89,14 @@ static bool protocol_pac_stanley_can_be_decoded(ProtocolPACStanley* protocol) {
     return true;
 }
 
+static bool protocol_pac_stanley_window_can_be_decoded(ProtocolPACStanley* protocol) {
+    if(bit_lib_window_get_bits_32(&protocol->window, 0, 8) != 0b11111111) return false;
+    bit_lib_window_copy(&protocol->window, protocol->encoded_data);
+    return protocol_pac_stanley_can_be_decoded(protocol);
+}
+
 void protocol_pac_stanley_decoder_start(ProtocolPACStanley* protocol) {
+    bit_lib_window_reset(&protocol->window);
     memset(protocol->data, 0, PAC_STANLEY_DECODED_DATA_SIZE);
     protocol->inverted = false;
     protocol->got_preamble = false;
@@ -111,15 +122,12 @@ bool protocol_pac_stanley_decoder_feed(ProtocolPACStanley* protocol, bool level,
 
     if(pulses) {
         for(uint8_t i = 0; i < pulses; i++) {
-            bit_lib_push_bit(
-                protocol->encoded_data,
-                PAC_STANLEY_ENCODED_BYTE_FULL_SIZE,
-                level ^ protocol->inverted);
+            bit_lib_window_push(&protocol->window, level ^ protocol->inverted);
         }
         pushed = true;
     }
 
-    if(pushed && protocol_pac_stanley_can_be_decoded(protocol)) {
+    if(pushed && protocol_pac_stanley_window_can_be_decoded(protocol)) {
         protocol_pac_stanley_decode(protocol);
         return true;
     }
@@ -1,13 +1,9 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
-
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
+#include "lfrfid_demods.h"
 
 #define PARADOX_DECODED_DATA_SIZE (6)
 
@@ -17,7 +13,8 @@
 #define PARADOX_ENCODED_DATA_LAST (PARADOX_ENCODED_DATA_SIZE - 1)
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(PARADOX_ENCODED_DATA_SIZE * 8)];
 } ProtocolParadoxDecoder;
 
 typedef struct {
@@ -34,14 +31,14 @@ typedef struct {
 
 ProtocolParadox* protocol_paradox_alloc(void) {
     ProtocolParadox* protocol = malloc(sizeof(ProtocolParadox));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, PARADOX_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_paradox_free(ProtocolParadox* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -51,7 +48,7 @@ uint8_t* protocol_paradox_get_data(ProtocolParadox* protocol) {
 };
 
 void protocol_paradox_decoder_start(ProtocolParadox* protocol) {
-    memset(protocol->encoded_data, 0, PARADOX_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static bool protocol_paradox_can_be_decoded(ProtocolParadox* protocol) {
@@ -84,14 +81,15 @@ static void protocol_paradox_decode(uint8_t* encoded_data, uint8_t* decoded_data
     bit_lib_push_bit(decoded_data, PARADOX_DECODED_DATA_SIZE, 0);
 }
 
-bool protocol_paradox_decoder_feed(ProtocolParadox* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_paradox_decoder_feed_bits(ProtocolParadox* protocol, bool value, uint32_t count) {
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, PARADOX_ENCODED_DATA_SIZE, value);
+            bit_lib_window_push(&protocol->decoder.window, value);
+            if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 8) != 0b00001111) {
+                continue;
+            }
+            bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
             if(protocol_paradox_can_be_decoded(protocol)) {
                 protocol_paradox_decode(protocol->encoded_data, protocol->data);
 
@@ -227,7 +225,6 @@ const ProtocolBase protocol_paradox = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_paradox_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_paradox_decoder_feed,
         },
     .encoder =
         {
@@ -237,4 +234,6 @@ const ProtocolBase protocol_paradox = {
     .render_data = (ProtocolRenderData)protocol_paradox_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_paradox_render_brief_data,
     .write_data = (ProtocolWriteData)protocol_paradox_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_paradox_decoder_feed_bits,
 };
\ No newline at end of file
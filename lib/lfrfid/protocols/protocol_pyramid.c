@@ -1,14 +1,10 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <lfrfid/tools/fsk_demod.h>
 #include <lfrfid/tools/fsk_osc.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 #include <lfrfid/tools/bit_lib.h>
 
-#define JITTER_TIME (20)
-#define MIN_TIME (64 - JITTER_TIME)
-#define MAX_TIME (80 + JITTER_TIME)
-
 #define PYRAMID_DATA_SIZE 13
 #define PYRAMID_PREAMBLE_SIZE 3
 
@@ -19,7 +15,8 @@
 #define PYRAMID_DECODED_BIT_SIZE ((PYRAMID_ENCODED_BIT_SIZE - PYRAMID_PREAMBLE_SIZE * 8) / 2)
 
 typedef struct {
-    FSKDemod* fsk_demod;
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(PYRAMID_ENCODED_DATA_SIZE * 8)];
 } ProtocolPyramidDecoder;
 
 typedef struct {
@@ -37,14 +34,14 @@ typedef struct {
 
 ProtocolPyramid* protocol_pyramid_alloc(void) {
     ProtocolPyramid* protocol = malloc(sizeof(ProtocolPyramid));
-    protocol->decoder.fsk_demod = fsk_demod_alloc(MIN_TIME, 6, MAX_TIME, 5);
+    bit_lib_window_init(
+        &protocol->decoder.window, protocol->decoder.window_data, PYRAMID_ENCODED_DATA_SIZE * 8);
     protocol->encoder.fsk_osc = fsk_osc_alloc(8, 10, 50);
 
     return protocol;
 };
 
 void protocol_pyramid_free(ProtocolPyramid* protocol) {
-    fsk_demod_free(protocol->decoder.fsk_demod);
     fsk_osc_free(protocol->encoder.fsk_osc);
     free(protocol);
 };
@@ -54,7 +51,7 @@ uint8_t* protocol_pyramid_get_data(ProtocolPyramid* protocol) {
 };
 
 void protocol_pyramid_decoder_start(ProtocolPyramid* protocol) {
-    memset(protocol->encoded_data, 0, PYRAMID_ENCODED_DATA_SIZE);
+    bit_lib_window_reset(&protocol->decoder.window);
 };
 
 static bool protocol_pyramid_can_be_decoded(uint8_t* data) {
@@ -105,15 +102,17 @@ static void protocol_pyramid_decode(ProtocolPyramid* protocol) {
     bit_lib_copy_bits(protocol->data, 16, 16, protocol->encoded_data, 81 + 8);
 }
 
-bool protocol_pyramid_decoder_feed(ProtocolPyramid* protocol, bool level, uint32_t duration) {
-    bool value;
-    uint32_t count;
+bool protocol_pyramid_decoder_feed_bits(ProtocolPyramid* protocol, bool value, uint32_t count) {
     bool result = false;
 
-    fsk_demod_feed(protocol->decoder.fsk_demod, level, duration, &value, &count);
     if(count > 0) {
         for(size_t i = 0; i < count; i++) {
-            bit_lib_push_bit(protocol->encoded_data, PYRAMID_ENCODED_DATA_SIZE, value);
+            bit_lib_window_push(&protocol->decoder.window, value);
+            if(bit_lib_window_get_bits_32(&protocol->decoder.window, 0, 24) !=
+               0b000000000000000100000001) {
+                continue;
+            }
+            bit_lib_window_copy(&protocol->decoder.window, protocol->encoded_data);
             if(protocol_pyramid_can_be_decoded(protocol->encoded_data)) {
                 protocol_pyramid_decode(protocol);
                 result = true;
@@ -269,7 +268,6 @@ const ProtocolBase protocol_pyramid = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_pyramid_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_pyramid_decoder_feed,
         },
     .encoder =
         {
@@ -279,4 +277,6 @@ const ProtocolBase protocol_pyramid = {
     .render_data = (ProtocolRenderData)protocol_pyramid_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_pyramid_render_data,
     .write_data = (ProtocolWriteData)protocol_pyramid_write_data,
+    .demod = &lfrfid_demod_fsk_rf50,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_pyramid_decoder_feed_bits,
 };
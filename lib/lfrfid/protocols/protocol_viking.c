@@ -1,8 +1,8 @@
 #include <furi.h>
 #include <toolbox/protocols/protocol.h>
-#include <toolbox/manchester_decoder.h>
 #include <lfrfid/tools/bit_lib.h>
 #include "lfrfid_protocols.h"
+#include "lfrfid_demods.h"
 
 #define VIKING_CLOCK_PER_BIT (32)
 
@@ -13,27 +13,19 @@
 #define VIKING_ENCODED_BYTE_FULL_SIZE (VIKING_ENCODED_BYTE_SIZE + VIKING_PREAMBLE_BYTE_SIZE)
 #define VIKING_DECODED_DATA_SIZE 4
 
-#define VIKING_READ_SHORT_TIME (128)
-#define VIKING_READ_LONG_TIME (256)
-#define VIKING_READ_JITTER_TIME (60)
-
-#define VIKING_READ_SHORT_TIME_LOW (VIKING_READ_SHORT_TIME - VIKING_READ_JITTER_TIME)
-#define VIKING_READ_SHORT_TIME_HIGH (VIKING_READ_SHORT_TIME + VIKING_READ_JITTER_TIME)
-#define VIKING_READ_LONG_TIME_LOW (VIKING_READ_LONG_TIME - VIKING_READ_JITTER_TIME)
-#define VIKING_READ_LONG_TIME_HIGH (VIKING_READ_LONG_TIME + VIKING_READ_JITTER_TIME)
-
 typedef struct {
     uint8_t data[VIKING_DECODED_DATA_SIZE];
     uint8_t encoded_data[VIKING_ENCODED_BYTE_FULL_SIZE];
+    BitLibWindow window;
+    uint8_t window_data[BIT_LIB_WINDOW_DATA_SIZE(VIKING_ENCODED_BYTE_FULL_SIZE * 8)];
 
     uint8_t encoded_data_index;
     bool encoded_polarity;
-
-    ManchesterState decoder_manchester_state;
 } ProtocolViking;
 
 ProtocolViking* protocol_viking_alloc(void) {
     ProtocolViking* proto = malloc(sizeof(ProtocolViking));
+    bit_lib_window_init(&proto->window, proto->window_data, VIKING_ENCODED_BYTE_FULL_SIZE * 8);
     return (void*)proto;
 };
 
@@ -73,47 +65,26 @@ static bool protocol_viking_can_be_decoded(ProtocolViking* protocol) {
     return true;
 }
 
+static bool protocol_viking_window_can_be_decoded(ProtocolViking* protocol) {
+    if(bit_lib_window_get_bits_32(&protocol->window, 0, 16) != 0b1111001000000000) return false;
+    bit_lib_window_copy(&protocol->window, protocol->encoded_data);
+    return protocol_viking_can_be_decoded(protocol);
+}
+
 void protocol_viking_decoder_start(ProtocolViking* protocol) {
-    memset(protocol->encoded_data, 0, VIKING_ENCODED_BYTE_FULL_SIZE);
-    manchester_advance(
-        protocol->decoder_manchester_state,
-        ManchesterEventReset,
-        &protocol->decoder_manchester_state,
-        NULL);
+    bit_lib_window_reset(&protocol->window);
 };
 
-bool protocol_viking_decoder_feed(ProtocolViking* protocol, bool level, uint32_t duration) {
+bool protocol_viking_decoder_feed_bits(ProtocolViking* protocol, bool value, uint32_t count) {
+    // Manchester demod yields a single bit per pulse
+    UNUSED(count);
     bool result = false;
 
-    ManchesterEvent event = ManchesterEventReset;
-
-    if(duration > VIKING_READ_SHORT_TIME_LOW && duration < VIKING_READ_SHORT_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventShortHigh;
-        } else {
-            event = ManchesterEventShortLow;
-        }
-    } else if(duration > VIKING_READ_LONG_TIME_LOW && duration < VIKING_READ_LONG_TIME_HIGH) {
-        if(!level) {
-            event = ManchesterEventLongHigh;
-        } else {
-            event = ManchesterEventLongLow;
-        }
-    }
-
-    if(event != ManchesterEventReset) {
-        bool data;
-        bool data_ok = manchester_advance(
-            protocol->decoder_manchester_state, event, &protocol->decoder_manchester_state, &data);
+    bit_lib_window_push(&protocol->window, value);
 
-        if(data_ok) {
-            bit_lib_push_bit(protocol->encoded_data, VIKING_ENCODED_BYTE_FULL_SIZE, data);
-
-            if(protocol_viking_can_be_decoded(protocol)) {
-                protocol_viking_decode(protocol);
-                result = true;
-            }
-        }
+    if(protocol_viking_window_can_be_decoded(protocol)) {
+        protocol_viking_decode(protocol);
+        result = true;
     }
 
     return result;
@@ -192,7 +163,6 @@ const ProtocolBase protocol_viking = {
     .decoder =
         {
             .start = (ProtocolDecoderStart)protocol_viking_decoder_start,
-            .feed = (ProtocolDecoderFeed)protocol_viking_decoder_feed,
         },
     .encoder =
         {
@@ -202,4 +172,6 @@ const ProtocolBase protocol_viking = {
     .render_data = (ProtocolRenderData)protocol_viking_render_data,
     .render_brief_data = (ProtocolRenderData)protocol_viking_render_data,
     .write_data = (ProtocolWriteData)protocol_viking_write_data,
+    .demod = &lfrfid_demod_manchester_rf32,
+    .feed_bits = (ProtocolDecoderFeedBits)protocol_viking_decoder_feed_bits,
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "bit_lib.h"
 #include <core/check.h>
 #include <stdio.h>
+#include <string.h>
 
 void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit) {
     size_t last_index = data_size - 1;
@@ -11,6 +12,52 @@ void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit) {
     data[last_index] = (data[last_index] << 1) | bit;
 }
 
+void bit_lib_window_init(BitLibWindow* window, uint8_t* data, size_t size) {
+    furi_check(size % 8 == 0);
+    window->data = data;
+    window->size = size;
+    bit_lib_window_reset(window);
+}
+
+void bit_lib_window_reset(BitLibWindow* window) {
+    memset(window->data, 0, BIT_LIB_WINDOW_DATA_SIZE(window->size));
+    window->head = 0;
+}
+
+void bit_lib_window_push(BitLibWindow* window, bool bit) {
+    // Window size is a multiple of 8, so both copies share the mask
+    uint8_t* first = &window->data[window->head / 8];
+    uint8_t* second = first + window->size / 8;
+    const uint8_t mask = 0x80 >> (window->head % 8);
+
+    if(bit) {
+        *first |= mask;
+        *second |= mask;
+    } else {
+        *first &= ~mask;
+        *second &= ~mask;
+    }
+
+    if(++window->head == window->size) {
+        window->head = 0;
+    }
+}
+
+uint32_t bit_lib_window_get_bits_32(const BitLibWindow* window, size_t position, uint8_t length) {
+    furi_assert(position + length <= window->size);
+    return bit_lib_get_bits_32(window->data, window->head + position, length);
+}
+
+void bit_lib_window_copy(const BitLibWindow* window, uint8_t* data) {
+    const uint8_t* source = &window->data[window->head / 8];
+    const uint8_t shift = window->head % 8;
+
+    // Buffer has a spare byte, so the byte after the window can always be read
+    for(size_t i = 0; i < window->size / 8; ++i) {
+        data[i] = (source[i] << shift) | (source[i + 1] >> (8 - shift));
+    }
+}
+
 void bit_lib_set_bit(uint8_t* data, size_t position, bool bit) {
     if(bit) {
         data[position / 8] |= 1UL << (7 - (position % 8));
@@ -41,6 +41,60 @@ typedef enum {
  */
 void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit);
 
+/** @brief Sliding window over the last bits of a bit stream.
+ *
+ * O(1) replacement for bit_lib_push_bit() in protocol decoders. Every bit is stored twice,
+ * at the head and one window size further, so the window is always a contiguous bit range
+ * that starts at the head. Use bit_lib_window_copy() to get the same byte array that
+ * bit_lib_push_bit() would produce.
+ */
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t head;
+} BitLibWindow;
+
+/** @brief Size of the buffer for a window.
+ *  @param size window size in bits
+ */
+#define BIT_LIB_WINDOW_DATA_SIZE(size) ((size) / 4 + 1)
+
+/** @brief Initialize a window with zero bits.
+ *  @param window window to initialize
+ *  @param data buffer of BIT_LIB_WINDOW_DATA_SIZE(size) bytes
+ *  @param size window size in bits, multiple of 8
+ */
+void bit_lib_window_init(BitLibWindow* window, uint8_t* data, size_t size);
+
+/** @brief Fill a window with zero bits.
+ *  @param window window to reset
+ */
+void bit_lib_window_reset(BitLibWindow* window);
+
+/** @brief Push a bit into a window, the oldest bit is dropped.
+ *  @param window window to push bit into
+ *  @param bit bit to push
+ */
+void bit_lib_window_push(BitLibWindow* window, bool bit);
+
+/** @brief Get bits of a window, as uint32_t.
+ *
+ * Cheap enough to call on every pushed bit: decoders compare the preamble with it and only
+ * copy the window out for the full check when the preamble is in place.
+ *
+ *  @param window window to get the bits from
+ *  @param position position of the first bit, 0 is the oldest bit
+ *  @param length length of the bits, up to 32
+ *  @return The bits.
+ */
+uint32_t bit_lib_window_get_bits_32(const BitLibWindow* window, size_t position, uint8_t length);
+
+/** @brief Copy a window into a byte array, oldest bit first.
+ *  @param window window to copy
+ *  @param data array of window size / 8 bytes
+ */
+void bit_lib_window_copy(const BitLibWindow* window, uint8_t* data);
+
 /** @brief Set a bit in a byte array.
  *  @param data array to set bit in
  *  @param position The position of the bit to set.
@@ -1,18 +1,73 @@
 #include "mf_classic_dict.h"
 
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/crc32_calc.h>
 #include <lib/flipper_format/flipper_format.h>
+#include <lib/nfc/protocols/nfc_util.h>
 
 #define MF_CLASSIC_DICT_FLIPPER_PATH EXT_PATH("nfc/assets/mf_classic_dict.nfc")
 #define MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
 #define MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
 
+#define MF_CLASSIC_DICT_FLIPPER_INDEX_PATH EXT_PATH("nfc/assets/mf_classic_dict.idx")
+#define MF_CLASSIC_DICT_USER_INDEX_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.idx")
+#define MF_CLASSIC_DICT_UNIT_TEST_INDEX_PATH EXT_PATH("unit_tests/mf_classic_dict.idx")
+
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
 
+#define MF_CLASSIC_DICT_INDEX_MAGIC (0x4443464DU)
+#define MF_CLASSIC_DICT_INDEX_VERSION (3U)
+#define MF_CLASSIC_DICT_INDEX_MAX_KEYS (UINT16_MAX)
+#define MF_CLASSIC_DICT_INDEX_CRC_BUFFER_SIZE (512U)
+#define MF_CLASSIC_DICT_INDEX_SAMPLE_SIZE (512U)
+#define MF_CLASSIC_DICT_INDEX_RUN_SIZE (1024U)
+#define MF_CLASSIC_DICT_INDEX_MERGE_SIZE (16U)
+#define MF_CLASSIC_DICT_INDEX_OUT_SIZE (64U)
+
+/*
+ * Index sidecar layout:
+ * - MfClassicDictIndexHeader
+ * - total_keys of uint64_t keys in file order, for direct index reads
+ * - total_keys of uint64_t (key << 16 | index) records sorted ascending, for binary search
+ * Sidecar is checked against the text dictionary on open by its size and CRC32 of its head and
+ * tail. CRC32 of the whole text is taken when the sidecar is built and kept up to date on adds.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t total_keys;
+    uint32_t source_size;
+    uint32_t source_sample_crc;
+    uint32_t source_crc;
+} MfClassicDictIndexHeader;
+
+typedef struct {
+    uint64_t buffer[MF_CLASSIC_DICT_INDEX_MERGE_SIZE];
+    uint32_t next;
+    uint32_t end;
+    uint8_t pos;
+    uint8_t fill;
+} MfClassicDictIndexRun;
+
+// Dictionaries are scanned front to back, read ahead halves the number of storage requests
+static const BufferedFileStreamConfig mf_classic_dict_stream_config = {
+    .block_size = 512,
+    .block_count = 4,
+    .read_ahead = true,
+};
+
 struct MfClassicDict {
     Stream* stream;
+    Stream* index_stream;
+    const char* index_path;
+    bool indexed;
+    // Sidecar no longer matches the text and is rebuilt on the next indexed access
+    bool index_stale;
+    uint32_t source_size;
+    uint32_t source_sample_crc;
+    uint32_t source_crc;
     uint32_t total_keys;
 };
 
@@ -34,38 +89,421 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     return dict_present;
 }
 
+static void mf_classic_dict_int_to_str(uint8_t* key_int, FuriString* key_str) {
+    furi_string_reset(key_str);
+    for(size_t i = 0; i < 6; i++) {
+        furi_string_cat_printf(key_str, "%02X", key_int[i]);
+    }
+}
+
+static void mf_classic_dict_str_to_int(FuriString* key_str, uint64_t* key_int) {
+    uint8_t key_byte_tmp;
+
+    *key_int = 0ULL;
+    for(uint8_t i = 0; i < 12; i += 2) {
+        args_char_to_hex(
+            furi_string_get_char(key_str, i), furi_string_get_char(key_str, i + 1), &key_byte_tmp);
+        *key_int |= (uint64_t)key_byte_tmp << (8 * (5 - i / 2));
+    }
+}
+
+// Cheap check on open, edits that keep the size and miss both ends are not detected
+static bool mf_classic_dict_index_sample(MfClassicDict* dict, uint32_t* size, uint32_t* crc) {
+    uint8_t* buffer = malloc(MF_CLASSIC_DICT_INDEX_SAMPLE_SIZE);
+
+    bool success = false;
+    do {
+        *size = stream_size(dict->stream);
+        size_t sample = MIN(*size, MF_CLASSIC_DICT_INDEX_SAMPLE_SIZE);
+
+        if(!stream_rewind(dict->stream)) break;
+        if(stream_read(dict->stream, buffer, sample) != sample) break;
+        *crc = crc32_calc_buffer(0, buffer, sample);
+
+        if(!stream_seek(dict->stream, -(int32_t)sample, StreamOffsetFromEnd)) break;
+        if(stream_read(dict->stream, buffer, sample) != sample) break;
+        *crc = crc32_calc_buffer(*crc, buffer, sample);
+
+        success = stream_rewind(dict->stream);
+    } while(false);
+
+    free(buffer);
+    return success;
+}
+
+static bool mf_classic_dict_index_fingerprint(MfClassicDict* dict) {
+    uint8_t* buffer = malloc(MF_CLASSIC_DICT_INDEX_CRC_BUFFER_SIZE);
+    dict->source_size = stream_size(dict->stream);
+    dict->source_crc = 0;
+
+    bool success = false;
+    do {
+        if(!stream_rewind(dict->stream)) break;
+        size_t left = dict->source_size;
+        while(left) {
+            size_t chunk = MIN(left, MF_CLASSIC_DICT_INDEX_CRC_BUFFER_SIZE);
+            if(stream_read(dict->stream, buffer, chunk) != chunk) break;
+            dict->source_crc = crc32_calc_buffer(dict->source_crc, buffer, chunk);
+            left -= chunk;
+        }
+        if(left) break;
+        success = mf_classic_dict_index_sample(dict, &dict->source_size, &dict->source_sample_crc);
+    } while(false);
+
+    free(buffer);
+    return success;
+}
+
+static bool mf_classic_dict_index_write_header(MfClassicDict* dict) {
+    MfClassicDictIndexHeader header = {
+        .magic = MF_CLASSIC_DICT_INDEX_MAGIC,
+        .version = MF_CLASSIC_DICT_INDEX_VERSION,
+        .total_keys = dict->total_keys,
+        .source_size = dict->source_size,
+        .source_sample_crc = dict->source_sample_crc,
+        .source_crc = dict->source_crc,
+    };
+
+    return stream_rewind(dict->index_stream) &&
+           (stream_write(dict->index_stream, (uint8_t*)&header, sizeof(header)) ==
+            sizeof(header));
+}
+
+static bool mf_classic_dict_index_load(MfClassicDict* dict) {
+    MfClassicDictIndexHeader header = {};
+
+    bool success = false;
+    do {
+        if(!stream_rewind(dict->index_stream)) break;
+        if(stream_read(dict->index_stream, (uint8_t*)&header, sizeof(header)) != sizeof(header))
+            break;
+        if(header.magic != MF_CLASSIC_DICT_INDEX_MAGIC) break;
+        if(header.version != MF_CLASSIC_DICT_INDEX_VERSION) break;
+        if(stream_size(dict->index_stream) !=
+           sizeof(header) + (size_t)header.total_keys * 2 * sizeof(uint64_t))
+            break;
+        if(!mf_classic_dict_index_sample(dict, &dict->source_size, &dict->source_sample_crc))
+            break;
+        if(header.source_size != dict->source_size ||
+           header.source_sample_crc != dict->source_sample_crc)
+            break;
+        dict->source_crc = header.source_crc;
+        dict->total_keys = header.total_keys;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+static int mf_classic_dict_index_record_cmp(const void* a, const void* b) {
+    uint64_t record_a = *(const uint64_t*)a;
+    uint64_t record_b = *(const uint64_t*)b;
+    return (record_a > record_b) - (record_a < record_b);
+}
+
+static bool mf_classic_dict_index_write_run(Stream* stream, uint64_t* run, size_t count) {
+    qsort(run, count, sizeof(uint64_t), mf_classic_dict_index_record_cmp);
+    return stream_write(stream, (uint8_t*)run, count * sizeof(uint64_t)) ==
+           count * sizeof(uint64_t);
+}
+
+static bool mf_classic_dict_index_merge(Stream* stream, Stream* run_stream, uint32_t total_keys) {
+    size_t run_count = (total_keys + MF_CLASSIC_DICT_INDEX_RUN_SIZE - 1) /
+                       MF_CLASSIC_DICT_INDEX_RUN_SIZE;
+    MfClassicDictIndexRun* runs = malloc(sizeof(MfClassicDictIndexRun) * run_count);
+    uint64_t* out = malloc(sizeof(uint64_t) * MF_CLASSIC_DICT_INDEX_OUT_SIZE);
+    size_t out_fill = 0;
+
+    for(size_t i = 0; i < run_count; i++) {
+        runs[i].next = i * MF_CLASSIC_DICT_INDEX_RUN_SIZE;
+        runs[i].end = MIN(runs[i].next + MF_CLASSIC_DICT_INDEX_RUN_SIZE, total_keys);
+        runs[i].pos = 0;
+        runs[i].fill = 0;
+    }
+
+    bool success = true;
+    for(uint32_t written = 0; success && (written < total_keys); written++) {
+        MfClassicDictIndexRun* best = NULL;
+        for(size_t i = 0; i < run_count; i++) {
+            MfClassicDictIndexRun* run = &runs[i];
+            if((run->pos == run->fill) && (run->next < run->end)) {
+                run->fill = MIN(run->end - run->next, MF_CLASSIC_DICT_INDEX_MERGE_SIZE);
+                run->pos = 0;
+                size_t size = run->fill * sizeof(uint64_t);
+                if(!stream_seek(run_stream, run->next * sizeof(uint64_t), StreamOffsetFromStart) ||
+                   stream_read(run_stream, (uint8_t*)run->buffer, size) != size) {
+                    success = false;
+                    break;
+                }
+                run->next += run->fill;
+            }
+            if(run->pos == run->fill) continue;
+            if(!best || run->buffer[run->pos] < best->buffer[best->pos]) best = run;
+        }
+        if(!success || !best) {
+            success = false;
+            break;
+        }
+
+        out[out_fill++] = best->buffer[best->pos++];
+        if((out_fill == MF_CLASSIC_DICT_INDEX_OUT_SIZE) || (written + 1 == total_keys)) {
+            size_t size = out_fill * sizeof(uint64_t);
+            success = (stream_write(stream, (uint8_t*)out, size) == size);
+            out_fill = 0;
+        }
+    }
+
+    free(out);
+    free(runs);
+    return success;
+}
+
+static bool mf_classic_dict_index_build(MfClassicDict* dict) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* run_stream = file_stream_alloc(storage);
+    FuriString* run_path = furi_string_alloc_printf("%s.tmp", dict->index_path);
+    FuriString* next_line = furi_string_alloc();
+    uint64_t* run = malloc(sizeof(uint64_t) * MF_CLASSIC_DICT_INDEX_RUN_SIZE);
+    size_t run_fill = 0;
+    uint32_t total_keys = 0;
+
+    bool success = false;
+    do {
+        if(!file_stream_open(
+               run_stream, furi_string_get_cstr(run_path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        // Header is written last, once the sidecar is complete
+        MfClassicDictIndexHeader header = {};
+        stream_clean(dict->index_stream);
+        if(stream_write(dict->index_stream, (uint8_t*)&header, sizeof(header)) != sizeof(header))
+            break;
+
+        // Keys in file order go straight to the sidecar, sorted runs to the scratch file
+        if(!stream_rewind(dict->stream)) break;
+        bool keys_written = true;
+        while(keys_written && stream_read_line(dict->stream, next_line)) {
+            if(furi_string_get_char(next_line, 0) == '#') continue;
+            if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
+            if(total_keys == MF_CLASSIC_DICT_INDEX_MAX_KEYS) {
+                FURI_LOG_W(TAG, "Too many keys to index");
+                keys_written = false;
+                break;
+            }
+
+            uint64_t key = 0;
+            furi_string_left(next_line, 12);
+            mf_classic_dict_str_to_int(next_line, &key);
+            keys_written =
+                (stream_write(dict->index_stream, (uint8_t*)&key, sizeof(key)) == sizeof(key));
+
+            run[run_fill++] = (key << 16) | total_keys++;
+            if(keys_written && (run_fill == MF_CLASSIC_DICT_INDEX_RUN_SIZE)) {
+                keys_written = mf_classic_dict_index_write_run(run_stream, run, run_fill);
+                run_fill = 0;
+            }
+        }
+        if(!keys_written) break;
+        if(run_fill && !mf_classic_dict_index_write_run(run_stream, run, run_fill)) break;
+
+        free(run);
+        run = NULL;
+        if(!mf_classic_dict_index_merge(dict->index_stream, run_stream, total_keys)) break;
+
+        dict->total_keys = total_keys;
+        if(!mf_classic_dict_index_fingerprint(dict)) break;
+        if(!mf_classic_dict_index_write_header(dict)) break;
+
+        FURI_LOG_I(TAG, "Built index with %lu keys", total_keys);
+        success = true;
+    } while(false);
+
+    if(run) free(run);
+    furi_string_free(next_line);
+    file_stream_close(run_stream);
+    stream_free(run_stream);
+    storage_simply_remove(storage, furi_string_get_cstr(run_path));
+    furi_string_free(run_path);
+    furi_record_close(RECORD_STORAGE);
+    stream_rewind(dict->stream);
+
+    return success;
+}
+
+static bool mf_classic_dict_index_open(MfClassicDict* dict) {
+    if(!file_stream_open(
+           dict->index_stream, dict->index_path, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
+        file_stream_close(dict->index_stream);
+        return false;
+    }
+
+    dict->indexed = mf_classic_dict_index_load(dict) || mf_classic_dict_index_build(dict);
+    if(!dict->indexed) {
+        file_stream_close(dict->index_stream);
+        dict->total_keys = 0;
+    }
+
+    return dict->indexed;
+}
+
+static void mf_classic_dict_index_drop(MfClassicDict* dict) {
+    FURI_LOG_W(TAG, "Index update failed, falling back to text lookups");
+    file_stream_close(dict->index_stream);
+    dict->indexed = false;
+    dict->index_stale = false;
+}
+
+// Deletes only mark the sidecar stale, a batch of them costs a single rebuild
+static bool mf_classic_dict_index_ready(MfClassicDict* dict) {
+    if(dict->index_stale) {
+        uint32_t total_keys = dict->total_keys;
+        dict->index_stale = false;
+        dict->indexed = mf_classic_dict_index_build(dict);
+        if(!dict->indexed) {
+            mf_classic_dict_index_drop(dict);
+            dict->total_keys = total_keys;
+        }
+    }
+    return dict->indexed;
+}
+
+static size_t mf_classic_dict_index_key_offset(MfClassicDict* dict, uint32_t index) {
+    UNUSED(dict);
+    return sizeof(MfClassicDictIndexHeader) + index * sizeof(uint64_t);
+}
+
+static size_t mf_classic_dict_index_record_offset(MfClassicDict* dict, uint32_t position) {
+    return sizeof(MfClassicDictIndexHeader) +
+           (dict->total_keys + position) * sizeof(uint64_t);
+}
+
+static bool mf_classic_dict_index_read(MfClassicDict* dict, size_t offset, uint64_t* value) {
+    return stream_seek(dict->index_stream, offset, StreamOffsetFromStart) &&
+           (stream_read(dict->index_stream, (uint8_t*)value, sizeof(uint64_t)) ==
+            sizeof(uint64_t));
+}
+
+/** Find position of the first sorted record not less than value */
+static bool
+    mf_classic_dict_index_lower_bound(MfClassicDict* dict, uint64_t value, uint32_t* position) {
+    uint32_t low = 0;
+    uint32_t high = dict->total_keys;
+    uint64_t record = 0;
+
+    while(low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if(!mf_classic_dict_index_read(
+               dict, mf_classic_dict_index_record_offset(dict, middle), &record))
+            return false;
+        if(record < value) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    *position = low;
+    return true;
+}
+
+static bool mf_classic_dict_index_find(MfClassicDict* dict, uint64_t key, uint32_t* target) {
+    uint32_t position = 0;
+    uint64_t record = 0;
+
+    bool key_found = false;
+    do {
+        if(!mf_classic_dict_index_lower_bound(dict, key << 16, &position)) break;
+        if(position >= dict->total_keys) break;
+        if(!mf_classic_dict_index_read(
+               dict, mf_classic_dict_index_record_offset(dict, position), &record))
+            break;
+        if((record >> 16) != key) break;
+        *target = record & 0xFFFF;
+        key_found = true;
+    } while(false);
+
+    return key_found;
+}
+
+static bool mf_classic_dict_index_add(MfClassicDict* dict, uint64_t key, FuriString* line) {
+    uint32_t index = dict->total_keys;
+    uint64_t record = (key << 16) | index;
+    uint32_t position = 0;
+
+    bool success = false;
+    do {
+        if(index >= MF_CLASSIC_DICT_INDEX_MAX_KEYS) break;
+        if(!mf_classic_dict_index_lower_bound(dict, record, &position)) break;
+        // Append key to file order section, shifting sorted section by one entry
+        if(!stream_seek(
+               dict->index_stream,
+               mf_classic_dict_index_key_offset(dict, index),
+               StreamOffsetFromStart))
+            break;
+        if(!stream_insert(dict->index_stream, (uint8_t*)&key, sizeof(key))) break;
+        dict->total_keys++;
+        if(!stream_seek(
+               dict->index_stream,
+               mf_classic_dict_index_record_offset(dict, position),
+               StreamOffsetFromStart))
+            break;
+        if(!stream_insert(dict->index_stream, (uint8_t*)&record, sizeof(record))) break;
+        // Key line was appended to the text, extend the checksum instead of reading it again
+        dict->source_size += furi_string_size(line);
+        dict->source_crc = crc32_calc_buffer(
+            dict->source_crc, furi_string_get_cstr(line), furi_string_size(line));
+        // Tail moved, sampling it again is still cheap
+        uint32_t source_size = 0;
+        if(!mf_classic_dict_index_sample(dict, &source_size, &dict->source_sample_crc)) break;
+        if(source_size != dict->source_size) break;
+        success = mf_classic_dict_index_write_header(dict);
+    } while(false);
+
+    return success;
+}
+
 MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     MfClassicDict* dict = malloc(sizeof(MfClassicDict));
     Storage* storage = furi_record_open(RECORD_STORAGE);
     dict->stream = buffered_file_stream_alloc(storage);
+    dict->index_stream = file_stream_alloc(storage);
     furi_record_close(RECORD_STORAGE);
 
     bool dict_loaded = false;
     do {
         if(dict_type == MfClassicDictTypeSystem) {
-            if(!buffered_file_stream_open(
+            if(!buffered_file_stream_open_ex(
                    dict->stream,
                    MF_CLASSIC_DICT_FLIPPER_PATH,
                    FSAM_READ_WRITE,
-                   FSOM_OPEN_EXISTING)) {
+                   FSOM_OPEN_EXISTING,
+                   &mf_classic_dict_stream_config)) {
                 buffered_file_stream_close(dict->stream);
                 break;
             }
+            dict->index_path = MF_CLASSIC_DICT_FLIPPER_INDEX_PATH;
         } else if(dict_type == MfClassicDictTypeUser) {
-            if(!buffered_file_stream_open(
-                   dict->stream, MF_CLASSIC_DICT_USER_PATH, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
+            if(!buffered_file_stream_open_ex(
+                   dict->stream,
+                   MF_CLASSIC_DICT_USER_PATH,
+                   FSAM_READ_WRITE,
+                   FSOM_OPEN_ALWAYS,
+                   &mf_classic_dict_stream_config)) {
                 buffered_file_stream_close(dict->stream);
                 break;
             }
+            dict->index_path = MF_CLASSIC_DICT_USER_INDEX_PATH;
         } else if(dict_type == MfClassicDictTypeUnitTest) {
-            if(!buffered_file_stream_open(
+            if(!buffered_file_stream_open_ex(
                    dict->stream,
                    MF_CLASSIC_DICT_UNIT_TEST_PATH,
                    FSAM_READ_WRITE,
-                   FSOM_OPEN_ALWAYS)) {
+                   FSOM_OPEN_ALWAYS,
+                   &mf_classic_dict_stream_config)) {
                 buffered_file_stream_close(dict->stream);
                 break;
             }
+            dict->index_path = MF_CLASSIC_DICT_UNIT_TEST_INDEX_PATH;
         }
 
         // Check for new line ending
@@ -80,6 +518,13 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
             if(!stream_rewind(dict->stream)) break;
         }
 
+        // Load or build index sidecar, fall back to counting keys in text
+        if(mf_classic_dict_index_open(dict)) {
+            dict_loaded = true;
+            FURI_LOG_I(TAG, "Loaded indexed dictionary with %lu keys", dict->total_keys);
+            break;
+        }
+
         // Read total amount of keys
         FuriString* next_line;
         next_line = furi_string_alloc();
@@ -106,6 +551,7 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
 
     if(!dict_loaded) {
         buffered_file_stream_close(dict->stream);
+        stream_free(dict->index_stream);
         free(dict);
         dict = NULL;
     }
@@ -119,27 +565,11 @@ void mf_classic_dict_free(MfClassicDict* dict) {
 
     buffered_file_stream_close(dict->stream);
     stream_free(dict->stream);
+    if(dict->indexed || dict->index_stale) file_stream_close(dict->index_stream);
+    stream_free(dict->index_stream);
     free(dict);
 }
 
-static void mf_classic_dict_int_to_str(uint8_t* key_int, FuriString* key_str) {
-    furi_string_reset(key_str);
-    for(size_t i = 0; i < 6; i++) {
-        furi_string_cat_printf(key_str, "%02X", key_int[i]);
-    }
-}
-
-static void mf_classic_dict_str_to_int(FuriString* key_str, uint64_t* key_int) {
-    uint8_t key_byte_tmp;
-
-    *key_int = 0ULL;
-    for(uint8_t i = 0; i < 12; i += 2) {
-        args_char_to_hex(
-            furi_string_get_char(key_str, i), furi_string_get_char(key_str, i + 1), &key_byte_tmp);
-        *key_int |= (uint64_t)key_byte_tmp << (8 * (5 - i / 2));
-    }
-}
-
 uint32_t mf_classic_dict_get_total_keys(MfClassicDict* dict) {
     furi_assert(dict);
 
@@ -188,6 +618,11 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(mf_classic_dict_index_ready(dict)) {
+        uint32_t target = 0;
+        return mf_classic_dict_find_index_str(dict, key, &target);
+    }
+
     FuriString* next_line;
     next_line = furi_string_alloc();
 
@@ -207,6 +642,11 @@ bool mf_classic_dict_is_key_present_str(MfClassicDict* dict, FuriString* key) {
 }
 
 bool mf_classic_dict_is_key_present(MfClassicDict* dict, uint8_t* key) {
+    if(mf_classic_dict_index_ready(dict)) {
+        uint32_t target = 0;
+        return mf_classic_dict_find_index(dict, key, &target);
+    }
+
     FuriString* temp_key;
 
     temp_key = furi_string_alloc();
@@ -220,13 +660,19 @@ bool mf_classic_dict_add_key_str(MfClassicDict* dict, FuriString* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    uint64_t key_int = 0;
+    if(dict->indexed) mf_classic_dict_str_to_int(key, &key_int);
     furi_string_cat_printf(key, "\n");
 
     bool key_added = false;
     do {
         if(!stream_seek(dict->stream, 0, StreamOffsetFromEnd)) break;
         if(!stream_insert_string(dict->stream, key)) break;
-        dict->total_keys++;
+        uint32_t total_keys = dict->total_keys + 1;
+        if(dict->indexed && !mf_classic_dict_index_add(dict, key_int, key)) {
+            mf_classic_dict_index_drop(dict);
+        }
+        dict->total_keys = total_keys;
         key_added = true;
     } while(false);
 
@@ -251,6 +697,19 @@ bool mf_classic_dict_get_key_at_index_str(MfClassicDict* dict, FuriString* key,
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(mf_classic_dict_index_ready(dict)) {
+        uint64_t key_int = 0;
+        uint8_t key_bytes[6];
+        furi_string_reset(key);
+        if(target >= dict->total_keys) return false;
+        if(!mf_classic_dict_index_read(
+               dict, mf_classic_dict_index_key_offset(dict, target), &key_int))
+            return false;
+        nfc_util_num2bytes(key_int, sizeof(key_bytes), key_bytes);
+        mf_classic_dict_int_to_str(key_bytes, key);
+        return true;
+    }
+
     FuriString* next_line;
     uint32_t index = 0;
     next_line = furi_string_alloc();
@@ -274,6 +733,12 @@ bool mf_classic_dict_get_key_at_index(MfClassicDict* dict, uint64_t* key, uint32
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(mf_classic_dict_index_ready(dict)) {
+        if(target >= dict->total_keys) return false;
+        return mf_classic_dict_index_read(
+            dict, mf_classic_dict_index_key_offset(dict, target), key);
+    }
+
     FuriString* temp_key;
     temp_key = furi_string_alloc();
     bool key_found = mf_classic_dict_get_key_at_index_str(dict, temp_key, target);
@@ -288,6 +753,13 @@ bool mf_classic_dict_find_index_str(MfClassicDict* dict, FuriString* key, uint32
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(mf_classic_dict_index_ready(dict)) {
+        uint64_t key_int = 0;
+        if(furi_string_size(key) != NFC_MF_CLASSIC_KEY_LEN - 1) return false;
+        mf_classic_dict_str_to_int(key, &key_int);
+        return mf_classic_dict_index_find(dict, key_int, target);
+    }
+
     FuriString* next_line;
     next_line = furi_string_alloc();
 
@@ -312,6 +784,10 @@ bool mf_classic_dict_find_index(MfClassicDict* dict, uint8_t* key, uint32_t* tar
     furi_assert(dict);
     furi_assert(dict->stream);
 
+    if(mf_classic_dict_index_ready(dict)) {
+        return mf_classic_dict_index_find(dict, nfc_util_bytes2num(key, 6), target);
+    }
+
     FuriString* temp_key;
     temp_key = furi_string_alloc();
     mf_classic_dict_int_to_str(key, temp_key);
@@ -342,6 +818,12 @@ bool mf_classic_dict_delete_index(MfClassicDict* dict, uint32_t target) {
         key_removed = true;
     }
 
+    // Indices of all following keys shift, sidecar is rebuilt when it is needed again
+    if(key_removed && dict->indexed) {
+        dict->indexed = false;
+        dict->index_stale = true;
+    }
+
     stream_rewind(dict->stream);
 
     furi_string_free(next_line);
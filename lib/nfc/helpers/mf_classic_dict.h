@@ -21,6 +21,9 @@ typedef struct MfClassicDict MfClassicDict;
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type);
 
 /** Allocate MfClassicDict instance
+ *
+ * Keys are indexed in a binary sidecar next to the dictionary, built on first
+ * load and rebuilt when the dictionary changes outside of this API.
  *
  * @param[in]  dict_type  The dictionary type
  *
@@ -62,7 +65,7 @@ bool mf_classic_dict_get_next_key_str(MfClassicDict* dict, FuriString* key);
  *
  * @param      dict    MfClassicDict instance
  * @param[out] key     Pointer to the uint64_t key
- * @param[in]  target  Target offset from current position
+ * @param[in]  target  Target key index
  *
  * @return     true on success
  */
@@ -72,7 +75,7 @@ bool mf_classic_dict_get_key_at_index(MfClassicDict* dict, uint64_t* key, uint32
  *
  * @param      dict    MfClassicDict instance
  * @param[out] key     Found key destination buffer
- * @param[in]  target  Target offset from current position
+ * @param[in]  target  Target key index
  *
  * @return     true on success
  */
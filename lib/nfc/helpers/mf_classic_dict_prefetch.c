@@ -0,0 +1,84 @@
+#include "mf_classic_dict_prefetch.h"
+
+#include <furi.h>
+
+#define TAG "MfClassicDictPrefetch"
+
+#define MF_CLASSIC_DICT_PREFETCH_DEPTH (64U)
+#define MF_CLASSIC_DICT_PREFETCH_STACK_SIZE (2048U)
+#define MF_CLASSIC_DICT_PREFETCH_TIMEOUT_MS (50U)
+
+struct MfClassicDictPrefetch {
+    MfClassicDict* dict;
+    FuriMessageQueue* queue;
+    FuriThread* thread;
+    volatile bool running;
+    volatile bool done;
+};
+
+static int32_t mf_classic_dict_prefetch_thread(void* context) {
+    MfClassicDictPrefetch* instance = context;
+    uint64_t key = 0;
+    uint32_t keys_read = 0;
+
+    while(instance->running && mf_classic_dict_get_next_key(instance->dict, &key)) {
+        while(instance->running) {
+            if(furi_message_queue_put(
+                   instance->queue, &key, furi_ms_to_ticks(MF_CLASSIC_DICT_PREFETCH_TIMEOUT_MS)) ==
+               FuriStatusOk) {
+                keys_read++;
+                break;
+            }
+        }
+    }
+    instance->done = true;
+    FURI_LOG_D(TAG, "Reader done, %lu keys", keys_read);
+
+    return 0;
+}
+
+MfClassicDictPrefetch* mf_classic_dict_prefetch_alloc(MfClassicDict* dict) {
+    furi_assert(dict);
+
+    MfClassicDictPrefetch* instance = malloc(sizeof(MfClassicDictPrefetch));
+    instance->dict = dict;
+    instance->queue = furi_message_queue_alloc(MF_CLASSIC_DICT_PREFETCH_DEPTH, sizeof(uint64_t));
+    instance->thread = furi_thread_alloc_ex(
+        "MfClassicDictPrefetch",
+        MF_CLASSIC_DICT_PREFETCH_STACK_SIZE,
+        mf_classic_dict_prefetch_thread,
+        instance);
+
+    mf_classic_dict_rewind(dict);
+    instance->running = true;
+    furi_thread_start(instance->thread);
+
+    return instance;
+}
+
+void mf_classic_dict_prefetch_free(MfClassicDictPrefetch* instance) {
+    furi_assert(instance);
+
+    instance->running = false;
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    furi_message_queue_free(instance->queue);
+    free(instance);
+}
+
+bool mf_classic_dict_prefetch_get_next_key(MfClassicDictPrefetch* instance, uint64_t* key) {
+    furi_assert(instance);
+    furi_assert(key);
+
+    while(true) {
+        if(furi_message_queue_get(
+               instance->queue, key, furi_ms_to_ticks(MF_CLASSIC_DICT_PREFETCH_TIMEOUT_MS)) ==
+           FuriStatusOk) {
+            return true;
+        }
+        // Reader publishes done only after its last put
+        if(instance->done && !furi_message_queue_get_count(instance->queue)) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "mf_classic_dict.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MfClassicDictPrefetch MfClassicDictPrefetch;
+
+/** Allocate MfClassicDictPrefetch instance
+ *
+ * Rewinds dictionary and starts a reader thread that keeps a ring of parsed
+ * keys filled, so the caller is not stalled by storage access. Dictionary must
+ * not be used by anyone else until the instance is freed.
+ *
+ * @param      dict  MfClassicDict instance
+ *
+ * @return     MfClassicDictPrefetch instance
+ */
+MfClassicDictPrefetch* mf_classic_dict_prefetch_alloc(MfClassicDict* dict);
+
+/** Stop reader thread and free MfClassicDictPrefetch instance
+ *
+ * @param      instance  MfClassicDictPrefetch instance
+ */
+void mf_classic_dict_prefetch_free(MfClassicDictPrefetch* instance);
+
+/** Get next key from the ring, waiting for the reader if it is empty
+ *
+ * @param      instance  MfClassicDictPrefetch instance
+ * @param[out] key       Pointer to the uint64_t key
+ *
+ * @return     true on success, false when dictionary is exhausted
+ */
+bool mf_classic_dict_prefetch_get_next_key(MfClassicDictPrefetch* instance, uint64_t* key);
+
+#ifdef __cplusplus
+}
+#endif
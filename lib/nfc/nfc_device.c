@@ -1687,6 +1687,7 @@ bool nfc_device_save_shadow(NfcDevice* dev, const char* path) {
 static bool nfc_device_load_data(NfcDevice* dev, FuriString* path, bool show_dialog) {
     bool parsed = false;
     FlipperFormat* file = flipper_format_file_alloc(dev->storage);
+    flipper_format_set_index_mode(file, true);
     FuriHalNfcDevData* data = &dev->dev_data.nfc_data;
     uint32_t data_cnt = 0;
     FuriString* temp_str;
@@ -56,9 +56,15 @@ typedef struct {
     uint16_t size;
 } NfcReaderRequestData;
 
+typedef enum {
+    NfcMfClassicDictAttackModeSector, /**< Try every key on a sector before moving to the next */
+    NfcMfClassicDictAttackModeKey, /**< Try every key on all remaining sectors, single dict pass */
+} NfcMfClassicDictAttackMode;
+
 typedef struct {
     MfClassicDict* dict;
     uint8_t current_sector;
+    NfcMfClassicDictAttackMode mode;
 } NfcMfClassicDictAttackData;
 
 typedef enum {
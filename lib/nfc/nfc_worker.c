@@ -1097,30 +1097,154 @@ static void nfc_worker_mf_classic_key_attack(
     nfc_worker->callback(NfcWorkerEventKeyAttackStop, nfc_worker->context);
 }
 
-void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
-    furi_assert(nfc_worker);
-    furi_assert(nfc_worker->callback);
+static bool nfc_worker_mf_classic_wait_card(
+    NfcWorker* nfc_worker,
+    bool* card_found_notified,
+    bool* card_removed_notified) {
+    while(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
+        furi_hal_nfc_sleep();
+        if(furi_hal_nfc_activate_nfca(200, NULL)) {
+            if(!*card_found_notified) {
+                nfc_worker->callback(NfcWorkerEventCardDetected, nfc_worker->context);
+                *card_found_notified = true;
+                *card_removed_notified = false;
+            }
+            return true;
+        }
+        if(!*card_removed_notified) {
+            nfc_worker->callback(NfcWorkerEventNoCardDetected, nfc_worker->context);
+            *card_removed_notified = true;
+            *card_found_notified = false;
+        }
+    }
+    return false;
+}
 
+// Activates the card for a single authentication, card_lost is set if it does not respond
+static bool nfc_worker_mf_classic_auth_key(
+    FuriHalNfcTxRxContext* tx_rx,
+    uint8_t block_num,
+    uint64_t key,
+    MfClassicKey key_type,
+    bool* card_lost) {
+    uint32_t cuid = 0;
+    if(!furi_hal_nfc_activate_nfca(200, &cuid)) {
+        *card_lost = true;
+        return false;
+    }
+    return mf_classic_authenticate_skip_activate(tx_rx, block_num, key, key_type, true, cuid);
+}
+
+// Returns false if the card was lost before both keys of the sector were tried
+static bool nfc_worker_mf_classic_try_sector_key(
+    NfcWorker* nfc_worker,
+    FuriHalNfcTxRxContext* tx_rx,
+    size_t sector,
+    uint64_t key) {
+    MfClassicData* data = &nfc_worker->dev_data->mf_classic_data;
+    uint8_t block_num = mf_classic_get_sector_trailer_block_num_by_sector(sector);
+    bool card_lost = false;
+
+    if(!mf_classic_is_key_found(data, sector, MfClassicKeyA) &&
+       nfc_worker_mf_classic_auth_key(tx_rx, block_num, key, MfClassicKeyA, &card_lost)) {
+        mf_classic_set_key_found(data, sector, MfClassicKeyA, key);
+        FURI_LOG_D(TAG, "Key A found for sector %d: %012llX", sector, key);
+        nfc_worker->callback(NfcWorkerEventFoundKeyA, nfc_worker->context);
+
+        uint64_t found_key;
+        if(nfc_worker_mf_get_b_key_from_sector_trailer(tx_rx, sector, key, &found_key)) {
+            FURI_LOG_D(TAG, "Found B key via reading sector %d", sector);
+            mf_classic_set_key_found(data, sector, MfClassicKeyB, found_key);
+            nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
+        }
+    }
+    if(card_lost) return false;
+
+    if(!mf_classic_is_key_found(data, sector, MfClassicKeyB) &&
+       nfc_worker_mf_classic_auth_key(tx_rx, block_num, key, MfClassicKeyB, &card_lost)) {
+        mf_classic_set_key_found(data, sector, MfClassicKeyB, key);
+        FURI_LOG_D(TAG, "Key B found for sector %d: %012llX", sector, key);
+        nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
+    }
+    return !card_lost;
+}
+
+static void nfc_worker_mf_classic_dict_attack_by_key(
+    NfcWorker* nfc_worker,
+    MfClassicDict* dict,
+    FuriHalNfcTxRxContext* tx_rx) {
     MfClassicData* data = &nfc_worker->dev_data->mf_classic_data;
     NfcMfClassicDictAttackData* dict_attack_data =
         &nfc_worker->dev_data->mf_classic_dict_attack_data;
     uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
+    uint64_t sectors_all = (1ULL << total_sectors) - 1;
+    uint64_t sectors_done = 0;
     uint64_t key = 0;
-    uint64_t prev_key = 0;
-    FuriHalNfcTxRxContext tx_rx = {};
+    uint16_t key_index = 0;
     bool card_found_notified = true;
     bool card_removed_notified = false;
 
-    // Load dictionary
-    MfClassicDict* dict = dict_attack_data->dict;
-    if(!dict) {
-        FURI_LOG_E(TAG, "Dictionary not found");
-        nfc_worker->callback(NfcWorkerEventNoDictFound, nfc_worker->context);
-        return;
+    // Sectors with both keys known are not attacked
+    for(size_t i = 0; i < total_sectors; i++) {
+        if(mf_classic_is_sector_read(data, i) ||
+           (mf_classic_is_key_found(data, i, MfClassicKeyA) &&
+            mf_classic_is_key_found(data, i, MfClassicKeyB))) {
+            sectors_done |= 1ULL << i;
+        }
     }
 
-    FURI_LOG_D(
-        TAG, "Start Dictionary attack, Key Count %lu", mf_classic_dict_get_total_keys(dict));
+    // Single dictionary pass, each key is tried on all remaining sectors
+    MfClassicDictPrefetch* prefetch = mf_classic_dict_prefetch_alloc(dict);
+    while((sectors_done != sectors_all) &&
+          mf_classic_dict_prefetch_get_next_key(prefetch, &key)) {
+        if(++key_index % NFC_DICT_KEY_BATCH_SIZE == 0) {
+            nfc_worker->callback(NfcWorkerEventNewDictKeyBatch, nfc_worker->context);
+        }
+        if(!nfc_worker_mf_classic_wait_card(
+               nfc_worker, &card_found_notified, &card_removed_notified))
+            break;
+
+        for(size_t i = 0; i < total_sectors; i++) {
+            if(sectors_done & (1ULL << i)) continue;
+            while(!nfc_worker_mf_classic_try_sector_key(nfc_worker, tx_rx, i, key)) {
+                // Card was lost, the sector is retried with the same key once it is back
+                if(!nfc_worker_mf_classic_wait_card(
+                       nfc_worker, &card_found_notified, &card_removed_notified))
+                    break;
+            }
+            if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
+               mf_classic_is_key_found(data, i, MfClassicKeyB)) {
+                mf_classic_read_sector(tx_rx, data, i);
+                sectors_done |= 1ULL << i;
+                // Reported per completed sector, the rest of the progress goes with key batches
+                dict_attack_data->current_sector = i;
+                nfc_worker->callback(NfcWorkerEventNewSector, nfc_worker->context);
+            }
+            if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
+        }
+        if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
+    }
+    mf_classic_dict_prefetch_free(prefetch);
+
+    // Read what is accessible with a single known key
+    for(size_t i = 0; i < total_sectors; i++) {
+        if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
+        if(sectors_done & (1ULL << i)) continue;
+        mf_classic_read_sector(tx_rx, data, i);
+    }
+}
+
+static void nfc_worker_mf_classic_dict_attack_by_sector(
+    NfcWorker* nfc_worker,
+    MfClassicDict* dict,
+    FuriHalNfcTxRxContext* tx_rx) {
+    MfClassicData* data = &nfc_worker->dev_data->mf_classic_data;
+    uint32_t total_sectors = mf_classic_get_total_sectors_num(data->type);
+    uint64_t key = 0;
+    uint64_t prev_key = 0;
+    bool card_found_notified = true;
+    bool card_removed_notified = false;
+
     for(size_t i = 0; i < total_sectors; i++) {
         FURI_LOG_I(TAG, "Sector %d", i);
         nfc_worker->callback(NfcWorkerEventNewSector, nfc_worker->context);
@@ -1130,7 +1254,8 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
            mf_classic_is_key_found(data, i, MfClassicKeyB))
             continue;
         uint16_t key_index = 0;
-        while(mf_classic_dict_get_next_key(dict, &key)) {
+        MfClassicDictPrefetch* prefetch = mf_classic_dict_prefetch_alloc(dict);
+        while(mf_classic_dict_prefetch_get_next_key(prefetch, &key)) {
             FURI_LOG_T(TAG, "Key %d", key_index);
             if(++key_index % NFC_DICT_KEY_BATCH_SIZE == 0) {
                 nfc_worker->callback(NfcWorkerEventNewDictKeyBatch, nfc_worker->context);
@@ -1143,20 +1268,20 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                     nfc_worker->callback(NfcWorkerEventCardDetected, nfc_worker->context);
                     card_found_notified = true;
                     card_removed_notified = false;
-                    nfc_worker_mf_classic_key_attack(nfc_worker, prev_key, &tx_rx, i);
+                    nfc_worker_mf_classic_key_attack(nfc_worker, prev_key, tx_rx, i);
                     deactivated = true;
                 }
                 FURI_LOG_D(TAG, "Try to auth to sector %d with key %012llX", i, key);
                 if(!mf_classic_is_key_found(data, i, MfClassicKeyA)) {
                     if(mf_classic_authenticate_skip_activate(
-                           &tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
+                           tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
                         mf_classic_set_key_found(data, i, MfClassicKeyA, key);
                         FURI_LOG_D(TAG, "Key A found: %012llX", key);
                         nfc_worker->callback(NfcWorkerEventFoundKeyA, nfc_worker->context);
 
                         uint64_t found_key;
                         if(nfc_worker_mf_get_b_key_from_sector_trailer(
-                               &tx_rx, i, key, &found_key)) {
+                               tx_rx, i, key, &found_key)) {
                             FURI_LOG_D(TAG, "Found B key via reading sector %d", i);
                             mf_classic_set_key_found(data, i, MfClassicKeyB, found_key);
 
@@ -1164,10 +1289,10 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                                 nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
                             }
 
-                            nfc_worker_mf_classic_key_attack(nfc_worker, found_key, &tx_rx, i + 1);
+                            nfc_worker_mf_classic_key_attack(nfc_worker, found_key, tx_rx, i + 1);
                             break;
                         }
-                        nfc_worker_mf_classic_key_attack(nfc_worker, key, &tx_rx, i + 1);
+                        nfc_worker_mf_classic_key_attack(nfc_worker, key, tx_rx, i + 1);
                     }
                     furi_hal_nfc_sleep();
                     deactivated = true;
@@ -1182,7 +1307,7 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                     if(mf_classic_is_key_found(data, i, MfClassicKeyA) &&
                        memcmp(sec_trailer->key_a, current_key, 6) == 0) {
                         if(!mf_classic_authenticate_skip_activate(
-                               &tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
+                               tx_rx, block_num, key, MfClassicKeyA, !deactivated, cuid)) {
                             mf_classic_set_key_not_found(data, i, MfClassicKeyA);
                             FURI_LOG_D(TAG, "Key %dA not found in attack", i);
                         }
@@ -1192,11 +1317,11 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                 }
                 if(!mf_classic_is_key_found(data, i, MfClassicKeyB)) {
                     if(mf_classic_authenticate_skip_activate(
-                           &tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
+                           tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
                         FURI_LOG_D(TAG, "Key B found: %012llX", key);
                         mf_classic_set_key_found(data, i, MfClassicKeyB, key);
                         nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
-                        nfc_worker_mf_classic_key_attack(nfc_worker, key, &tx_rx, i + 1);
+                        nfc_worker_mf_classic_key_attack(nfc_worker, key, tx_rx, i + 1);
                     }
                     deactivated = true; //-V1048
                 } else {
@@ -1210,7 +1335,7 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                     if(mf_classic_is_key_found(data, i, MfClassicKeyB) &&
                        memcmp(sec_trailer->key_b, current_key, 6) == 0) {
                         if(!mf_classic_authenticate_skip_activate(
-                               &tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
+                               tx_rx, block_num, key, MfClassicKeyB, !deactivated, cuid)) { //-V547
                             mf_classic_set_key_not_found(data, i, MfClassicKeyB);
                             FURI_LOG_D(TAG, "Key %dB not found in attack", i);
                         }
@@ -1232,9 +1357,34 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
             }
             prev_key = key;
         }
+        mf_classic_dict_prefetch_free(prefetch);
         if(nfc_worker->state != NfcWorkerStateMfClassicDictAttack) break;
-        mf_classic_read_sector(&tx_rx, data, i);
-        mf_classic_dict_rewind(dict);
+        mf_classic_read_sector(tx_rx, data, i);
+    }
+}
+
+void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
+    furi_assert(nfc_worker);
+    furi_assert(nfc_worker->callback);
+
+    NfcMfClassicDictAttackData* dict_attack_data =
+        &nfc_worker->dev_data->mf_classic_dict_attack_data;
+    FuriHalNfcTxRxContext tx_rx = {};
+
+    // Load dictionary
+    MfClassicDict* dict = dict_attack_data->dict;
+    if(!dict) {
+        FURI_LOG_E(TAG, "Dictionary not found");
+        nfc_worker->callback(NfcWorkerEventNoDictFound, nfc_worker->context);
+        return;
+    }
+
+    FURI_LOG_D(
+        TAG, "Start Dictionary attack, Key Count %lu", mf_classic_dict_get_total_keys(dict));
+    if(dict_attack_data->mode == NfcMfClassicDictAttackModeKey) {
+        nfc_worker_mf_classic_dict_attack_by_key(nfc_worker, dict, &tx_rx);
+    } else {
+        nfc_worker_mf_classic_dict_attack_by_sector(nfc_worker, dict, &tx_rx);
     }
     if(nfc_worker->state == NfcWorkerStateMfClassicDictAttack) {
         nfc_worker->callback(NfcWorkerEventSuccess, nfc_worker->context);
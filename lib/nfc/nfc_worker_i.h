@@ -17,6 +17,7 @@
 #include <lib/nfc/protocols/nfcv.h>
 #include <lib/nfc/protocols/slix.h>
 #include <lib/nfc/helpers/reader_analyzer.h>
+#include <lib/nfc/helpers/mf_classic_dict_prefetch.h>
 
 struct NfcWorker {
     FuriThread* thread;
@@ -10,6 +10,7 @@
 #define LF_POLY_EVEN (0x870804)
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
+#define PARITY(x) ((uint32_t)__builtin_parity(x))
 
 void crypto1_reset(Crypto1* crypto1) {
     furi_assert(crypto1);
@@ -27,43 +28,125 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
+// Filter function split into partial 5-bit indices for bits 0-7, 8-15 and 16-19
+static const uint8_t crypto1_filter_lut_low[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+};
+
+static const uint8_t crypto1_filter_lut_mid[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+};
+
+static const uint8_t crypto1_filter_lut_high[16] = {
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01, 0x01,
+};
+
 uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
-    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    uint32_t out = crypto1_filter_lut_low[in & 0xff];
+    out |= crypto1_filter_lut_mid[in >> 8 & 0xff];
+    out |= crypto1_filter_lut_high[in >> 16 & 0xf];
     return FURI_BIT(0xEC57E80A, out);
 }
 
+static inline uint32_t crypto1_step(uint32_t* odd, uint32_t* even, uint32_t in, int is_encrypted) {
+    uint32_t out = crypto1_filter(*odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= in;
+    feed ^= LF_POLY_ODD & *odd;
+    feed ^= LF_POLY_EVEN & *even;
+    uint32_t tmp = *even << 1 | PARITY(feed);
+    *even = *odd;
+    *odd = tmp;
+    return out;
+}
+
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = crypto1_filter(crypto1->odd);
-    uint32_t feed = out & (!!is_encrypted);
-    feed ^= !!in;
-    feed ^= LF_POLY_ODD & crypto1->odd;
-    feed ^= LF_POLY_EVEN & crypto1->even;
-    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+    return crypto1_step(&crypto1->odd, &crypto1->even, !!in, is_encrypted);
+}
+
+/*
+ * Feedback taps never reach the two newest bits of either register half, so
+ * four consecutive feedback bits depend on the old state only. Without
+ * encrypted feedback a nibble is produced with four parities and the state
+ * advanced in one go.
+ */
+static inline uint8_t crypto1_nibble(uint32_t* odd, uint32_t* even, uint8_t in) {
+    uint32_t o = *odd;
+    uint32_t e = *even;
 
-    FURI_SWAP(crypto1->odd, crypto1->even);
+    uint32_t fb0 = FURI_BIT(in, 0) ^ PARITY((o & LF_POLY_ODD) ^ (e & LF_POLY_EVEN));
+    uint32_t fb1 = FURI_BIT(in, 1) ^ PARITY((e & (LF_POLY_ODD >> 1)) ^ (o & LF_POLY_EVEN));
+    uint32_t fb2 = FURI_BIT(in, 2) ^ PARITY((o & (LF_POLY_ODD >> 1)) ^ (e & (LF_POLY_EVEN >> 1)));
+    uint32_t fb3 = FURI_BIT(in, 3) ^ PARITY((e & (LF_POLY_ODD >> 2)) ^ (o & (LF_POLY_EVEN >> 1)));
+
+    uint8_t out = crypto1_filter(o);
+    out |= crypto1_filter(e << 1 | fb0) << 1;
+    out |= crypto1_filter(o << 1 | fb1) << 2;
+    out |= crypto1_filter(e << 2 | fb0 << 1 | fb2) << 3;
+
+    *odd = o << 2 | fb1 << 1 | fb3;
+    *even = e << 2 | fb0 << 1 | fb2;
     return out;
 }
 
-uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
-    furi_assert(crypto1);
+static inline uint8_t
+    crypto1_byte_fast(uint32_t* odd, uint32_t* even, uint8_t in, int is_encrypted) {
     uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    if(is_encrypted) {
+        for(uint8_t i = 0; i < 8; i++) {
+            out |= crypto1_step(odd, even, FURI_BIT(in, i), 1) << i;
+        }
+    } else {
+        out = crypto1_nibble(odd, even, in & 0xf);
+        out |= crypto1_nibble(odd, even, in >> 4) << 4;
     }
     return out;
 }
 
+uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    furi_assert(crypto1);
+    return crypto1_byte_fast(&crypto1->odd, &crypto1->even, in, is_encrypted);
+}
+
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    // Word is clocked in byte order MSB first, bits of each byte LSB first
+    for(int8_t shift = 24; shift >= 0; shift -= 8) {
+        out |= (uint32_t)crypto1_byte_fast(
+                   &crypto1->odd, &crypto1->even, in >> shift & 0xff, is_encrypted)
+               << shift;
     }
     return out;
 }
@@ -75,6 +158,102 @@ uint32_t prng_successor(uint32_t x, uint32_t n) {
     return SWAPENDIAN(x);
 }
 
+#define CRYPTO1_BATCH_HEAD_START (CRYPTO1_BATCH_LFSR_SIZE - 48)
+
+// LFSR bits feeding back, odd register taps at 2n and even register taps at 2n + 1
+static const uint8_t crypto1_batch_taps[] =
+    {4, 5, 6, 8, 12, 18, 20, 22, 23, 28, 30, 32, 33, 35, 37, 38, 42, 47};
+
+// Filter truth tables 0xD938, 0xF22C and 0xEC57E80A in gate form, first argument is the MSB
+static inline uint32_t crypto1_batch_fa(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return ((a | b) ^ (a & d)) ^ (c & ((a ^ b) | d));
+}
+
+static inline uint32_t crypto1_batch_fb(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return ((a & b) | c) ^ ((a ^ b) & (c | d));
+}
+
+static inline uint32_t
+    crypto1_batch_fc(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e) {
+    return (a | ((b | e) & (d ^ e))) ^ ((a ^ (b & d)) & ((c ^ d) | (b & e)));
+}
+
+// Odd register bit n is LFSR bit 2n, even register bit n is LFSR bit 2n + 1
+static inline uint32_t crypto1_batch_filter(const uint32_t* x) {
+    return crypto1_batch_fc(
+        crypto1_batch_fa(x[38], x[36], x[34], x[32]),
+        crypto1_batch_fb(x[30], x[28], x[26], x[24]),
+        crypto1_batch_fb(x[22], x[20], x[18], x[16]),
+        crypto1_batch_fa(x[14], x[12], x[10], x[8]),
+        crypto1_batch_fb(x[6], x[4], x[2], x[0]));
+}
+
+static inline uint32_t crypto1_batch_step(Crypto1Batch* batch, uint32_t in, uint32_t encrypted) {
+    if(batch->head == 0) {
+        memmove(&batch->lfsr[CRYPTO1_BATCH_HEAD_START], batch->lfsr, 48 * sizeof(uint32_t));
+        batch->head = CRYPTO1_BATCH_HEAD_START;
+    }
+
+    const uint32_t* x = &batch->lfsr[batch->head];
+    uint32_t out = crypto1_batch_filter(x);
+    uint32_t feed = in ^ (out & encrypted);
+    for(size_t i = 0; i < COUNT_OF(crypto1_batch_taps); i++) {
+        feed ^= x[crypto1_batch_taps[i]];
+    }
+    batch->lfsr[--batch->head] = feed;
+    return out;
+}
+
+void crypto1_batch_init(Crypto1Batch* batch, const uint64_t* keys, uint8_t count) {
+    furi_assert(batch);
+    furi_assert(keys);
+    furi_assert(count <= CRYPTO1_BATCH_SIZE);
+
+    batch->head = CRYPTO1_BATCH_HEAD_START;
+    for(uint8_t bit = 0; bit < 48; bit++) {
+        uint32_t word = 0;
+        for(uint8_t i = 0; i < count; i++) {
+            word |= (uint32_t)FURI_BIT(keys[i], bit ^ 7) << i;
+        }
+        batch->lfsr[batch->head + bit] = word;
+    }
+}
+
+void crypto1_batch_word(Crypto1Batch* batch, uint32_t in, int is_encrypted, uint32_t* out) {
+    furi_assert(batch);
+
+    uint32_t encrypted = is_encrypted ? UINT32_MAX : 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        uint32_t ks = crypto1_batch_step(batch, BEBIT(in, i) ? UINT32_MAX : 0, encrypted);
+        if(out) out[24 ^ i] = ks;
+    }
+}
+
+uint32_t crypto1_batch_check_auth(
+    const uint64_t* keys,
+    uint8_t count,
+    uint32_t cuid,
+    uint32_t nt,
+    uint32_t nr_enc,
+    uint32_t ar_enc) {
+    Crypto1Batch batch;
+    uint32_t keystream[32];
+
+    crypto1_batch_init(&batch, keys, count);
+    crypto1_batch_word(&batch, nt ^ cuid, 0, NULL);
+    crypto1_batch_word(&batch, nr_enc, 1, NULL);
+    crypto1_batch_word(&batch, 0, 0, keystream);
+
+    uint32_t ar = ar_enc ^ prng_successor(nt, 32);
+    uint32_t mismatch = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        mismatch |= keystream[i] ^ (FURI_BIT(ar, i) ? UINT32_MAX : 0);
+    }
+
+    uint32_t lanes = (count == CRYPTO1_BATCH_SIZE) ? UINT32_MAX : ((1UL << count) - 1);
+    return ~mismatch & lanes;
+}
+
 void crypto1_decrypt(
     Crypto1* crypto,
     uint8_t* encrypted_data,
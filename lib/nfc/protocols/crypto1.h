@@ -7,11 +7,24 @@
 extern "C" {
 #endif
 
+#define CRYPTO1_BATCH_SIZE (32U)
+#define CRYPTO1_BATCH_LFSR_SIZE (128U)
+
 typedef struct {
     uint32_t odd;
     uint32_t even;
 } Crypto1;
 
+/** Bitsliced Crypto1 state for CRYPTO1_BATCH_SIZE keys at once
+ *
+ * Bit i of every word belongs to key i. The 48 bit LFSR is a window sliding
+ * down the buffer, so a clock is a single store.
+ */
+typedef struct {
+    uint32_t lfsr[CRYPTO1_BATCH_LFSR_SIZE];
+    uint8_t head;
+} Crypto1Batch;
+
 void crypto1_reset(Crypto1* crypto1);
 
 void crypto1_init(Crypto1* crypto1, uint64_t key);
@@ -26,6 +39,43 @@ uint32_t crypto1_filter(uint32_t in);
 
 uint32_t prng_successor(uint32_t x, uint32_t n);
 
+/** Load up to CRYPTO1_BATCH_SIZE keys into bitsliced state
+ *
+ * @param      batch  Crypto1Batch instance
+ * @param[in]  keys   keys array
+ * @param[in]  count  keys count
+ */
+void crypto1_batch_init(Crypto1Batch* batch, const uint64_t* keys, uint8_t count);
+
+/** Clock the same word into all keys, same bit order as crypto1_word
+ *
+ * @param      batch         Crypto1Batch instance
+ * @param[in]  in            input word
+ * @param[in]  is_encrypted  feed keystream back, as in crypto1_word
+ * @param[out] out           32 bitsliced keystream words, bit n of the word in out[n].
+ *                           Can be NULL.
+ */
+void crypto1_batch_word(Crypto1Batch* batch, uint32_t in, int is_encrypted, uint32_t* out);
+
+/** Check candidate keys against a sniffed authentication
+ *
+ * @param[in]  keys    keys array
+ * @param[in]  count   keys count, up to CRYPTO1_BATCH_SIZE
+ * @param[in]  cuid    card uid
+ * @param[in]  nt      tag nonce
+ * @param[in]  nr_enc  encrypted reader nonce
+ * @param[in]  ar_enc  encrypted reader answer
+ *
+ * @return     mask of keys matching the authentication, bit i for keys[i]
+ */
+uint32_t crypto1_batch_check_auth(
+    const uint64_t* keys,
+    uint8_t count,
+    uint32_t cuid,
+    uint32_t nt,
+    uint32_t nr_enc,
+    uint32_t ar_enc);
+
 void crypto1_decrypt(
     Crypto1* crypto,
     uint8_t* encrypted_data,
@@ -25,3 +25,13 @@ uint8_t subghz_protocol_blocks_get_hash_data(SubGhzBlockDecoder* decoder, size_t
     }
     return hash;
 }
+
+void subghz_protocol_blocks_set_start_window(
+    SubGhzProtocolStartWindow* window,
+    bool level,
+    uint32_t center,
+    uint32_t tolerance) {
+    window->level = level;
+    window->duration_min = (center >= tolerance) ? (center - tolerance + 1) : 0;
+    window->duration_max = (tolerance > 0) ? (center + tolerance - 1) : 0;
+}
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "../types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,6 +44,20 @@ void subghz_protocol_blocks_add_to_128_bit(
  */
 uint8_t subghz_protocol_blocks_get_hash_data(SubGhzBlockDecoder* decoder, size_t len);
 
+/**
+ * Fill the start window of a decoder from its reset step check.
+ * Matches `DURATION_DIFF(duration, center) < tolerance` on the given level.
+ * @param window Pointer to a SubGhzProtocolStartWindow instance
+ * @param level Signal level of the start pulse
+ * @param center Expected start pulse duration, us
+ * @param tolerance Allowed deviation from center, us
+ */
+void subghz_protocol_blocks_set_start_window(
+    SubGhzProtocolStartWindow* window,
+    bool level,
+    uint32_t center,
+    uint32_t tolerance);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
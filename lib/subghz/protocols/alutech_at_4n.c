@@ -58,6 +58,7 @@ const SubGhzProtocolDecoder subghz_protocol_alutech_at_4n_decoder = {
     .serialize = subghz_protocol_decoder_alutech_at_4n_serialize,
     .deserialize = subghz_protocol_decoder_alutech_at_4n_deserialize,
     .get_string = subghz_protocol_decoder_alutech_at_4n_get_string,
+    .get_start_window = subghz_protocol_decoder_alutech_at_4n_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_alutech_at_4n_encoder = {
@@ -597,6 +598,19 @@ void subghz_protocol_decoder_alutech_at_4n_feed(void* context, bool level, uint3
     }
 }
 
+bool subghz_protocol_decoder_alutech_at_4n_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderAlutech_at_4n* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_alutech_at_4n_const.te_short,
+        subghz_protocol_alutech_at_4n_const.te_delta);
+    return instance->decoder.parser_step == Alutech_at_4nDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
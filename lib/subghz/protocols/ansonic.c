@@ -53,6 +53,7 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .serialize = subghz_protocol_decoder_ansonic_serialize,
     .deserialize = subghz_protocol_decoder_ansonic_deserialize,
     .get_string = subghz_protocol_decoder_ansonic_get_string,
+    .get_start_window = subghz_protocol_decoder_ansonic_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
@@ -279,6 +280,19 @@ void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t du
     }
 }
 
+bool subghz_protocol_decoder_ansonic_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderAnsonic* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_ansonic_const.te_short * 35,
+        subghz_protocol_ansonic_const.te_delta * 35);
+    return instance->decoder.parser_step == AnsonicDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
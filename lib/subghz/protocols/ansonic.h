@@ -73,6 +73,16 @@ void subghz_protocol_decoder_ansonic_reset(void* context);
  */
 void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Get the window of pulses that can start a new packet.
+ * @param context Pointer to a SubGhzProtocolDecoderAnsonic instance
+ * @param window Pointer to a SubGhzProtocolStartWindow instance
+ * @return true if decoder waits for the start of a packet
+ */
+bool subghz_protocol_decoder_ansonic_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window);
+
 /**
  * Getting the hash sum of the last randomly received parcel.
  * @param context Pointer to a SubGhzProtocolDecoderAnsonic instance
@@ -63,6 +63,7 @@ const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .serialize = subghz_protocol_decoder_bett_serialize,
     .deserialize = subghz_protocol_decoder_bett_deserialize,
     .get_string = subghz_protocol_decoder_bett_get_string,
+    .get_start_window = subghz_protocol_decoder_bett_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_bett_encoder = {
@@ -289,6 +290,19 @@ void subghz_protocol_decoder_bett_feed(void* context, bool level, uint32_t durat
     }
 }
 
+bool subghz_protocol_decoder_bett_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderBETT* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_bett_const.te_short * 44,
+        subghz_protocol_bett_const.te_delta * 15);
+    return instance->decoder.parser_step == BETTDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_bett_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderBETT* instance = context;
@@ -59,6 +59,7 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .serialize = subghz_protocol_decoder_came_serialize,
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
+    .get_start_window = subghz_protocol_decoder_came_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -310,6 +311,19 @@ void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t durat
     }
 }
 
+bool subghz_protocol_decoder_came_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCame* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_came_const.te_short * 56,
+        subghz_protocol_came_const.te_delta * 47);
+    return instance->decoder.parser_step == CameDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_came_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
@@ -50,6 +50,7 @@ const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
     .serialize = subghz_protocol_decoder_came_atomo_serialize,
     .deserialize = subghz_protocol_decoder_came_atomo_deserialize,
     .get_string = subghz_protocol_decoder_came_atomo_get_string,
+    .get_start_window = subghz_protocol_decoder_came_atomo_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_atomo_encoder = {
@@ -463,6 +464,19 @@ void subghz_protocol_decoder_came_atomo_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_came_atomo_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCameAtomo* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_came_atomo_const.te_long * 60,
+        subghz_protocol_came_atomo_const.te_delta * 40);
+    return instance->decoder.parser_step == CameAtomoDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -81,6 +81,7 @@ const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .serialize = subghz_protocol_decoder_came_twee_serialize,
     .deserialize = subghz_protocol_decoder_came_twee_deserialize,
     .get_string = subghz_protocol_decoder_came_twee_get_string,
+    .get_start_window = subghz_protocol_decoder_came_twee_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_twee_encoder = {
@@ -409,6 +410,19 @@ void subghz_protocol_decoder_came_twee_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_came_twee_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCameTwee* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_came_twee_const.te_long * 51,
+        subghz_protocol_came_twee_const.te_delta * 20);
+    return instance->decoder.parser_step == CameTweeDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_came_twee_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCameTwee* instance = context;
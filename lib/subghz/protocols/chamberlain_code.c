@@ -77,6 +77,7 @@ const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .serialize = subghz_protocol_decoder_chamb_code_serialize,
     .deserialize = subghz_protocol_decoder_chamb_code_deserialize,
     .get_string = subghz_protocol_decoder_chamb_code_get_string,
+    .get_start_window = subghz_protocol_decoder_chamb_code_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder = {
@@ -422,6 +423,19 @@ void subghz_protocol_decoder_chamb_code_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_chamb_code_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderChamb_Code* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_chamb_code_const.te_short * 39,
+        subghz_protocol_chamb_code_const.te_delta * 20);
+    return instance->decoder.parser_step == Chamb_CodeDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_chamb_code_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderChamb_Code* instance = context;
@@ -62,6 +62,7 @@ const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
     .serialize = subghz_protocol_decoder_clemsa_serialize,
     .deserialize = subghz_protocol_decoder_clemsa_deserialize,
     .get_string = subghz_protocol_decoder_clemsa_get_string,
+    .get_start_window = subghz_protocol_decoder_clemsa_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_clemsa_encoder = {
@@ -301,6 +302,19 @@ void subghz_protocol_decoder_clemsa_feed(void* context, bool level, uint32_t dur
     }
 }
 
+bool subghz_protocol_decoder_clemsa_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderClemsa* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_clemsa_const.te_short * 51,
+        subghz_protocol_clemsa_const.te_delta * 25);
+    return instance->decoder.parser_step == ClemsaDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -54,6 +54,7 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .serialize = subghz_protocol_decoder_doitrand_serialize,
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
+    .get_start_window = subghz_protocol_decoder_doitrand_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -276,6 +277,19 @@ void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t d
     }
 }
 
+bool subghz_protocol_decoder_doitrand_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDoitrand* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_doitrand_const.te_short * 62,
+        subghz_protocol_doitrand_const.te_delta * 30);
+    return instance->decoder.parser_step == DoitrandDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -48,6 +48,7 @@ const SubGhzProtocolDecoder subghz_protocol_dooya_decoder = {
     .serialize = subghz_protocol_decoder_dooya_serialize,
     .deserialize = subghz_protocol_decoder_dooya_deserialize,
     .get_string = subghz_protocol_decoder_dooya_get_string,
+    .get_start_window = subghz_protocol_decoder_dooya_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_dooya_encoder = {
@@ -304,6 +305,19 @@ void subghz_protocol_decoder_dooya_feed(void* context, bool level, uint32_t dura
     }
 }
 
+bool subghz_protocol_decoder_dooya_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDooya* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_dooya_const.te_long * 12,
+        subghz_protocol_dooya_const.te_delta * 20);
+    return instance->decoder.parser_step == DooyaDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -69,6 +69,7 @@ const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
     .serialize = subghz_protocol_decoder_faac_slh_serialize,
     .deserialize = subghz_protocol_decoder_faac_slh_deserialize,
     .get_string = subghz_protocol_decoder_faac_slh_get_string,
+    .get_start_window = subghz_protocol_decoder_faac_slh_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_faac_slh_encoder = {
@@ -483,6 +484,19 @@ void subghz_protocol_decoder_faac_slh_feed(void* context, bool level, uint32_t d
     }
 }
 
+bool subghz_protocol_decoder_faac_slh_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderFaacSLH* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_faac_slh_const.te_long * 2,
+        subghz_protocol_faac_slh_const.te_delta * 3);
+    return instance->decoder.parser_step == FaacSLHDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
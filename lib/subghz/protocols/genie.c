@@ -83,6 +83,7 @@ const SubGhzProtocolDecoder subghz_protocol_genie_decoder = {
     .serialize = subghz_protocol_decoder_genie_serialize,
     .deserialize = subghz_protocol_decoder_genie_deserialize,
     .get_string = subghz_protocol_decoder_genie_get_string,
+    .get_start_window = subghz_protocol_decoder_genie_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_genie_encoder = {
@@ -634,6 +635,16 @@ void subghz_protocol_decoder_genie_feed(void* context, bool level, uint32_t dura
     }
 }
 
+bool subghz_protocol_decoder_genie_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderGenie* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window, true, subghz_protocol_genie_const.te_short, subghz_protocol_genie_const.te_delta);
+    return instance->decoder.parser_step == GenieDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_genie_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderGenie* instance = context;
@@ -57,6 +57,7 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .serialize = subghz_protocol_decoder_holtek_serialize,
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
+    .get_start_window = subghz_protocol_decoder_holtek_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -288,6 +289,19 @@ void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t dur
     }
 }
 
+bool subghz_protocol_decoder_holtek_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_holtek_const.te_short * 36,
+        subghz_protocol_holtek_const.te_delta * 36);
+    return instance->decoder.parser_step == HoltekDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -64,6 +64,7 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
     .serialize = subghz_protocol_decoder_holtek_th12x_serialize,
     .deserialize = subghz_protocol_decoder_holtek_th12x_deserialize,
     .get_string = subghz_protocol_decoder_holtek_th12x_get_string,
+    .get_start_window = subghz_protocol_decoder_holtek_th12x_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder = {
@@ -313,6 +314,19 @@ void subghz_protocol_decoder_holtek_th12x_feed(void* context, bool level, uint32
     }
 }
 
+bool subghz_protocol_decoder_holtek_th12x_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek_HT12X* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_holtek_th12x_const.te_short * 36,
+        subghz_protocol_holtek_th12x_const.te_delta * 36);
+    return instance->decoder.parser_step == Holtek_HT12XDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -58,6 +58,7 @@ const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
     .serialize = subghz_protocol_decoder_honeywell_wdb_serialize,
     .deserialize = subghz_protocol_decoder_honeywell_wdb_deserialize,
     .get_string = subghz_protocol_decoder_honeywell_wdb_get_string,
+    .get_start_window = subghz_protocol_decoder_honeywell_wdb_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_honeywell_wdb_encoder = {
@@ -278,6 +279,19 @@ void subghz_protocol_decoder_honeywell_wdb_feed(void* context, bool level, uint3
     }
 }
 
+bool subghz_protocol_decoder_honeywell_wdb_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoneywell_WDB* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_honeywell_wdb_const.te_short * 3,
+        subghz_protocol_honeywell_wdb_const.te_delta);
+    return instance->decoder.parser_step == Honeywell_WDBDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzProtocolDecoderHoneywell_WDB* instance
@@ -51,6 +51,7 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .serialize = subghz_protocol_decoder_hormann_serialize,
     .deserialize = subghz_protocol_decoder_hormann_deserialize,
     .get_string = subghz_protocol_decoder_hormann_get_string,
+    .get_start_window = subghz_protocol_decoder_hormann_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_hormann_encoder = {
@@ -280,6 +281,19 @@ void subghz_protocol_decoder_hormann_feed(void* context, bool level, uint32_t du
     }
 }
 
+bool subghz_protocol_decoder_hormann_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHormann* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_hormann_const.te_short * 24,
+        subghz_protocol_hormann_const.te_delta * 24);
+    return instance->decoder.parser_step == HormannDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
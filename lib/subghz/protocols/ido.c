@@ -47,6 +47,7 @@ const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
     .deserialize = subghz_protocol_decoder_ido_deserialize,
     .serialize = subghz_protocol_decoder_ido_serialize,
     .get_string = subghz_protocol_decoder_ido_get_string,
+    .get_start_window = subghz_protocol_decoder_ido_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ido_encoder = {
@@ -160,6 +161,19 @@ void subghz_protocol_decoder_ido_feed(void* context, bool level, uint32_t durati
     }
 }
 
+bool subghz_protocol_decoder_ido_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderIDo* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_ido_const.te_short * 10,
+        subghz_protocol_ido_const.te_delta * 5);
+    return instance->decoder.parser_step == IDoDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -65,6 +65,7 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .serialize = subghz_protocol_decoder_keeloq_serialize,
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
+    .get_start_window = subghz_protocol_decoder_keeloq_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -678,6 +679,19 @@ void subghz_protocol_decoder_keeloq_feed(void* context, bool level, uint32_t dur
     }
 }
 
+bool subghz_protocol_decoder_keeloq_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKeeloq* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_keeloq_const.te_short,
+        subghz_protocol_keeloq_const.te_delta);
+    return instance->decoder.parser_step == KeeloqDecoderStepReset;
+}
+
 /**
  * Validation of decrypt data.
  * @param instance Pointer to a SubGhzBlockGeneric instance
@@ -727,6 +741,161 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+#define KEELOQ_LEARNING_MIRRORED 0x80u
+
+typedef struct {
+    uint8_t learning;
+    uint8_t kl_type;
+} SubGhzKeeloqLearningStep;
+
+// Learning types tried for keys of unknown type, in order, with kl_type reported on match
+static const SubGhzKeeloqLearningStep subghz_protocol_keeloq_unknown_learning[] = {
+    {KEELOQ_LEARNING_SIMPLE, 1},
+    {KEELOQ_LEARNING_SIMPLE | KEELOQ_LEARNING_MIRRORED, 1},
+    {KEELOQ_LEARNING_NORMAL, 2},
+    {KEELOQ_LEARNING_NORMAL | KEELOQ_LEARNING_MIRRORED, 2},
+    {KEELOQ_LEARNING_SECURE, 3},
+    {KEELOQ_LEARNING_SECURE | KEELOQ_LEARNING_MIRRORED, 3},
+    {KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, 4},
+    {KEELOQ_LEARNING_MAGIC_XOR_TYPE_1 | KEELOQ_LEARNING_MIRRORED, 4},
+};
+
+/** 
+ * Derive the key used to decrypt hop part
+ * @param learning Learning type, KEELOQ_LEARNING_MIRRORED reverses byte order of the key
+ * @param key Manufacture key
+ * @param fix Fix part of the parcel
+ * @param seed Seed
+ * @return derived key
+ */
+static uint64_t subghz_protocol_keeloq_derive_key(
+    uint8_t learning,
+    uint64_t key,
+    uint32_t fix,
+    uint32_t seed) {
+    if(learning & KEELOQ_LEARNING_MIRRORED) {
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+        key = man_rev;
+    }
+
+    switch(learning & ~KEELOQ_LEARNING_MIRRORED) {
+    case KEELOQ_LEARNING_NORMAL:
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KEELOQ_LEARNING_SECURE:
+        return subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    default:
+        // Simple Learning
+        return key;
+    }
+}
+
+/** 
+ * Decrypt hop part with derived key and validate it
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param hop Hop encrypted part of the parcel
+ * @param btn Button number
+ * @param end_serial Decrypted low part of the serial
+ * @param man Derived key
+ * @param centurion Use Centurion discriminator check
+ * @return true on successful check
+ */
+static inline bool subghz_protocol_keeloq_check_man(
+    SubGhzBlockGeneric* instance,
+    uint32_t hop,
+    uint8_t btn,
+    uint16_t end_serial,
+    uint64_t man,
+    bool centurion) {
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    if(centurion) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    }
+    return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+}
+
+static inline bool subghz_protocol_keeloq_is_centurion(const SubGhzKey* manufacture_code) {
+    return (manufacture_code->type == KEELOQ_LEARNING_NORMAL) &&
+           (strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0);
+}
+
+/** 
+ * Try all learning types of one manufacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param manufacture_code Manufacture key
+ * @param match Filled with the learning type and derived key on success
+ * @return true on match
+ */
+static bool subghz_protocol_keeloq_check_manufacture_code(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    const SubGhzKey* manufacture_code,
+    SubGhzKeystoreCacheEntry* match) {
+    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
+    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
+    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint8_t btn = (uint8_t)(fix >> 28);
+    uint64_t man;
+
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+    case KEELOQ_LEARNING_NORMAL:
+    case KEELOQ_LEARNING_SECURE:
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man = subghz_protocol_keeloq_derive_key(
+            manufacture_code->type, manufacture_code->key, fix, instance->seed);
+        if(subghz_protocol_keeloq_check_man(
+               instance,
+               hop,
+               btn,
+               end_serial,
+               man,
+               subghz_protocol_keeloq_is_centurion(manufacture_code))) {
+            match->learning = manufacture_code->type;
+            match->kl_type = 0;
+            match->man = man;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        for(size_t i = 0; i < COUNT_OF(subghz_protocol_keeloq_unknown_learning); i++) {
+            const SubGhzKeeloqLearningStep* step = &subghz_protocol_keeloq_unknown_learning[i];
+            man = subghz_protocol_keeloq_derive_key(
+                step->learning, manufacture_code->key, fix, instance->seed);
+            if(subghz_protocol_keeloq_check_man(instance, hop, btn, end_serial, man, false)) {
+                match->learning = step->learning;
+                match->kl_type = step->kl_type;
+                match->man = man;
+                return true;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -742,14 +911,8 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t hop,
     SubGhzKeystore* keystore,
     const char** manufacture_name) {
-    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
-    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
-    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
-
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -763,186 +926,66 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
 
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    size_t keys_count = SubGhzKeyArray_size(*keys);
+    uint32_t serial = fix & 0x0FFFFFFF;
+    const SubGhzKey* manufacture_code = NULL;
+    SubGhzKeystoreCacheEntry match = {
+        .serial = serial,
+        .seed = instance->seed,
+    };
+
+    // Known remote: repeat the key derivation that matched last time
+    SubGhzKeystoreCacheEntry* cached =
+        subghz_keystore_cache_find(keystore, serial, instance->seed);
+    if(cached && (cached->key_index < keys_count)) {
+        manufacture_code = SubGhzKeyArray_cget(*keys, cached->key_index);
+        if((mf_not_set ||
+            (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+           subghz_protocol_keeloq_check_man(
+               instance,
+               hop,
+               btn,
+               end_serial,
+               cached->man,
+               subghz_protocol_keeloq_is_centurion(manufacture_code))) {
+            match = *cached;
+        } else {
+            manufacture_code = NULL;
+        }
+    }
 
-                    break;
-                }
+    // Unknown remote: keys of the learning type that matched last are tried first,
+    // until something has matched all keys are tried in keystore order in a single pass
+    const bool prefer_learning = (keystore->last_learning != KEELOQ_LEARNING_UNKNOWN);
+    const uint8_t passes = prefer_learning ? 2 : 1;
+    for(uint8_t pass = 0; (pass < passes) && !manufacture_code; pass++) {
+        for(size_t i = 0; i < keys_count; i++) {
+            const SubGhzKey* candidate = SubGhzKeyArray_cget(*keys, i);
+            if(prefer_learning && ((candidate->type == keystore->last_learning) != (pass == 0))) {
+                continue;
+            }
+            if(!mf_not_set && (strcmp(furi_string_get_cstr(candidate->name), mfname) != 0)) {
+                continue;
+            }
+            if(subghz_protocol_keeloq_check_manufacture_code(
+                   instance, fix, hop, candidate, &match)) {
+                match.key_index = i;
+                subghz_keystore_cache_put(keystore, &match);
+                keystore->last_learning = candidate->type;
+                manufacture_code = candidate;
+                break;
             }
         }
+    }
+
+    if(manufacture_code) {
+        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+        keystore->mfname = *manufacture_name;
+        if(match.kl_type) keystore->kl_type = match.kl_type;
+        return 1;
+    }
 
     *manufacture_name = "Unknown";
     keystore->mfname = "Unknown";
@@ -49,6 +49,7 @@ const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
     .serialize = subghz_protocol_decoder_kia_serialize,
     .deserialize = subghz_protocol_decoder_kia_deserialize,
     .get_string = subghz_protocol_decoder_kia_get_string,
+    .get_start_window = subghz_protocol_decoder_kia_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_kia_encoder = {
@@ -190,6 +191,16 @@ void subghz_protocol_decoder_kia_feed(void* context, bool level, uint32_t durati
     }
 }
 
+bool subghz_protocol_decoder_kia_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKIA* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window, true, subghz_protocol_kia_const.te_short, subghz_protocol_kia_const.te_delta);
+    return instance->decoder.parser_step == KIADecoderStepReset;
+}
+
 uint8_t subghz_protocol_kia_crc8(uint8_t* data, size_t len) {
     uint8_t crc = 0x08;
     size_t i, j;
@@ -54,6 +54,7 @@ const SubGhzProtocolDecoder subghz_protocol_kinggates_stylo_4k_decoder = {
     .serialize = subghz_protocol_decoder_kinggates_stylo_4k_serialize,
     .deserialize = subghz_protocol_decoder_kinggates_stylo_4k_deserialize,
     .get_string = subghz_protocol_decoder_kinggates_stylo_4k_get_string,
+    .get_start_window = subghz_protocol_decoder_kinggates_stylo_4k_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_kinggates_stylo_4k_encoder = {
@@ -444,6 +445,19 @@ void subghz_protocol_decoder_kinggates_stylo_4k_feed(void* context, bool level,
     }
 }
 
+bool subghz_protocol_decoder_kinggates_stylo_4k_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderKingGates_stylo_4k* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_kinggates_stylo_4k_const.te_short,
+        subghz_protocol_kinggates_stylo_4k_const.te_delta);
+    return instance->decoder.parser_step == KingGates_stylo_4kDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -53,6 +53,7 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .serialize = subghz_protocol_decoder_linear_serialize,
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
+    .get_start_window = subghz_protocol_decoder_linear_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -293,6 +294,19 @@ void subghz_protocol_decoder_linear_feed(void* context, bool level, uint32_t dur
     }
 }
 
+bool subghz_protocol_decoder_linear_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinear* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_linear_const.te_short * 42,
+        subghz_protocol_linear_const.te_delta * 20);
+    return instance->decoder.parser_step == LinearDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_linear_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderLinear* instance = context;
@@ -54,6 +54,7 @@ const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
     .serialize = subghz_protocol_decoder_linear_delta3_serialize,
     .deserialize = subghz_protocol_decoder_linear_delta3_deserialize,
     .get_string = subghz_protocol_decoder_linear_delta3_get_string,
+    .get_start_window = subghz_protocol_decoder_linear_delta3_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder = {
@@ -304,6 +305,19 @@ void subghz_protocol_decoder_linear_delta3_feed(void* context, bool level, uint3
     }
 }
 
+bool subghz_protocol_decoder_linear_delta3_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinearDelta3* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_linear_delta3_const.te_short * 70,
+        subghz_protocol_linear_delta3_const.te_delta * 24);
+    return instance->decoder.parser_step == LinearDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_linear_delta3_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderLinearDelta3* instance = context;
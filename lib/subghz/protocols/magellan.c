@@ -49,6 +49,7 @@ const SubGhzProtocolDecoder subghz_protocol_magellan_decoder = {
     .serialize = subghz_protocol_decoder_magellan_serialize,
     .deserialize = subghz_protocol_decoder_magellan_deserialize,
     .get_string = subghz_protocol_decoder_magellan_get_string,
+    .get_start_window = subghz_protocol_decoder_magellan_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_magellan_encoder = {
@@ -347,6 +348,19 @@ void subghz_protocol_decoder_magellan_feed(void* context, bool level, uint32_t d
     }
 }
 
+bool subghz_protocol_decoder_magellan_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMagellan* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_magellan_const.te_short,
+        subghz_protocol_magellan_const.te_delta);
+    return instance->decoder.parser_step == MagellanDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -49,6 +49,7 @@ const SubGhzProtocolDecoder subghz_protocol_marantec_decoder = {
     .serialize = subghz_protocol_decoder_marantec_serialize,
     .deserialize = subghz_protocol_decoder_marantec_deserialize,
     .get_string = subghz_protocol_decoder_marantec_get_string,
+    .get_start_window = subghz_protocol_decoder_marantec_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_marantec_encoder = {
@@ -336,6 +337,19 @@ void subghz_protocol_decoder_marantec_feed(void* context, bool level, volatile u
     }
 }
 
+bool subghz_protocol_decoder_marantec_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMarantec* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_marantec_const.te_long * 5,
+        subghz_protocol_marantec_const.te_delta * 8);
+    return instance->decoder.parser_step == MarantecDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_marantec_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderMarantec* instance = context;
@@ -61,6 +61,7 @@ const SubGhzProtocolDecoder subghz_protocol_mastercode_decoder = {
     .serialize = subghz_protocol_decoder_mastercode_serialize,
     .deserialize = subghz_protocol_decoder_mastercode_deserialize,
     .get_string = subghz_protocol_decoder_mastercode_get_string,
+    .get_start_window = subghz_protocol_decoder_mastercode_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_mastercode_encoder = {
@@ -304,6 +305,19 @@ void subghz_protocol_decoder_mastercode_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_mastercode_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMastercode* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_mastercode_const.te_short * 15,
+        subghz_protocol_mastercode_const.te_delta * 15);
+    return instance->decoder.parser_step == MastercodeDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
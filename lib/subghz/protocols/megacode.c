@@ -59,6 +59,7 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .serialize = subghz_protocol_decoder_megacode_serialize,
     .deserialize = subghz_protocol_decoder_megacode_deserialize,
     .get_string = subghz_protocol_decoder_megacode_get_string,
+    .get_start_window = subghz_protocol_decoder_megacode_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_megacode_encoder = {
@@ -323,6 +324,19 @@ void subghz_protocol_decoder_megacode_feed(void* context, bool level, uint32_t d
     }
 }
 
+bool subghz_protocol_decoder_megacode_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderMegaCode* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_megacode_const.te_short * 13,
+        subghz_protocol_megacode_const.te_delta * 17);
+    return instance->decoder.parser_step == MegaCodeDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
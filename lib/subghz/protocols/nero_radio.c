@@ -49,6 +49,7 @@ const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
     .serialize = subghz_protocol_decoder_nero_radio_serialize,
     .deserialize = subghz_protocol_decoder_nero_radio_deserialize,
     .get_string = subghz_protocol_decoder_nero_radio_get_string,
+    .get_start_window = subghz_protocol_decoder_nero_radio_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_radio_encoder = {
@@ -350,6 +351,19 @@ void subghz_protocol_decoder_nero_radio_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_nero_radio_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNeroRadio* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_nero_radio_const.te_short,
+        subghz_protocol_nero_radio_const.te_delta);
+    return instance->decoder.parser_step == NeroRadioDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_nero_radio_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNeroRadio* instance = context;
@@ -48,6 +48,7 @@ const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .serialize = subghz_protocol_decoder_nero_sketch_serialize,
     .deserialize = subghz_protocol_decoder_nero_sketch_deserialize,
     .get_string = subghz_protocol_decoder_nero_sketch_get_string,
+    .get_start_window = subghz_protocol_decoder_nero_sketch_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_sketch_encoder = {
@@ -321,6 +322,19 @@ void subghz_protocol_decoder_nero_sketch_feed(void* context, bool level, uint32_
     }
 }
 
+bool subghz_protocol_decoder_nero_sketch_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNeroSketch* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_nero_sketch_const.te_short,
+        subghz_protocol_nero_sketch_const.te_delta);
+    return instance->decoder.parser_step == NeroSketchDecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_nero_sketch_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNeroSketch* instance = context;
@@ -57,6 +57,7 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .serialize = subghz_protocol_decoder_princeton_serialize,
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
+    .get_start_window = subghz_protocol_decoder_princeton_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -294,6 +295,19 @@ void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_princeton_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPrinceton* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_princeton_const.te_short * 36,
+        subghz_protocol_princeton_const.te_delta * 36);
+    return instance->decoder.parser_step == PrincetonDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
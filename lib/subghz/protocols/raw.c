@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_packed.h"
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
@@ -33,6 +34,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool packed;
+    SubGhzRawPackedWriter* packed_writer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -61,6 +64,7 @@ const SubGhzProtocolDecoder subghz_protocol_raw_decoder = {
     .serialize = NULL,
     .deserialize = subghz_protocol_decoder_raw_deserialize,
     .get_string = subghz_protocol_decoder_raw_get_string,
+    .feed_batch = subghz_protocol_decoder_raw_feed_batch,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_raw_encoder = {
@@ -158,6 +162,16 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->packed) {
+            Stream* stream = flipper_format_get_raw_stream(instance->flipper_file);
+            if(!subghz_raw_packed_write_marker(stream, SUBGHZ_RAW_PACKED_BLOCK_SIZE)) {
+                FURI_LOG_E(TAG, "Unable to add %s", SUBGHZ_RAW_PACKED_KEY);
+                break;
+            }
+            instance->packed_writer =
+                subghz_raw_packed_writer_alloc(stream, SUBGHZ_RAW_PACKED_BLOCK_SIZE);
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -175,7 +189,19 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
     furi_assert(instance);
 
     bool is_write = false;
-    if(instance->file_is_open == RAWFileIsOpenWrite) {
+    if(instance->file_is_open == RAWFileIsOpenWrite && instance->packed_writer) {
+        SubGhzRawPackedWriter* writer = instance->packed_writer;
+        is_write = true;
+        for(size_t i = 0; i < instance->ind_write && is_write; i++) {
+            is_write = subghz_raw_packed_writer_add(writer, instance->upload_raw[i]);
+        }
+        if(is_write) {
+            instance->sample_write += instance->ind_write;
+            instance->ind_write = 0;
+        } else {
+            FURI_LOG_E(TAG, "Unable to add packed data");
+        }
+    } else if(instance->file_is_open == RAWFileIsOpenWrite) {
         if(!flipper_format_write_int32(
                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
@@ -193,6 +219,13 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
 
     if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
         subghz_protocol_raw_save_to_file_write(instance);
+    if(instance->packed_writer) {
+        if(!subghz_raw_packed_writer_flush(instance->packed_writer)) {
+            FURI_LOG_E(TAG, "Unable to add packed data");
+        }
+        subghz_raw_packed_writer_free(instance->packed_writer);
+        instance->packed_writer = NULL;
+    }
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
@@ -204,6 +237,13 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     instance->file_is_open = RAWFileIsOpenClose;
 }
 
+void subghz_protocol_raw_save_to_file_set_packed(
+    SubGhzProtocolDecoderRAW* instance,
+    bool packed) {
+    furi_assert(instance);
+    instance->packed = packed;
+}
+
 void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance, bool pause) {
     furi_assert(instance);
 
@@ -261,6 +301,19 @@ void subghz_protocol_decoder_raw_feed(void* context, bool level, uint32_t durati
     }
 }
 
+void subghz_protocol_decoder_raw_feed_batch(
+    void* context,
+    const LevelDuration* pulses,
+    size_t count) {
+    furi_assert(context);
+    for(size_t i = 0; i < count; i++) {
+        subghz_protocol_decoder_raw_feed(
+            context,
+            level_duration_get_level(pulses[i]),
+            level_duration_get_duration(pulses[i]));
+    }
+}
+
 SubGhzProtocolStatus
     subghz_protocol_decoder_raw_deserialize(void* context, FlipperFormat* flipper_format) {
     furi_assert(context);
@@ -316,6 +369,13 @@ void subghz_protocol_raw_file_encoder_worker_set_callback_end(
         instance->file_worker_encoder, callback_end, context_end);
 }
 
+uint32_t subghz_protocol_raw_file_encoder_worker_get_underrun_count(
+    SubGhzProtocolEncoderRAW* instance) {
+    furi_assert(instance);
+    if(!instance->is_running) return 0;
+    return subghz_file_encoder_worker_get_underrun_count(instance->file_worker_encoder);
+}
+
 static bool subghz_protocol_encoder_raw_worker_init(SubGhzProtocolEncoderRAW* instance) {
     furi_assert(instance);
 
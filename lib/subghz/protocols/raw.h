@@ -29,6 +29,14 @@ bool subghz_protocol_raw_save_to_file_init(
     const char* dev_name,
     SubGhzRadioPreset* preset);
 
+/**
+ * Store samples in the packed binary format instead of text "RAW_Data" lines.
+ * Applies to the next subghz_protocol_raw_save_to_file_init call.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param packed Write packed data
+ */
+void subghz_protocol_raw_save_to_file_set_packed(SubGhzProtocolDecoderRAW* instance, bool packed);
+
 /**
  * Stop writing file to flash
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -69,6 +77,17 @@ void subghz_protocol_decoder_raw_reset(void* context);
  */
 void subghz_protocol_decoder_raw_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Parse a span of levels and durations received from the air.
+ * @param context Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param pulses Array of LevelDuration
+ * @param count Number of elements in pulses
+ */
+void subghz_protocol_decoder_raw_feed_batch(
+    void* context,
+    const LevelDuration* pulses,
+    size_t count);
+
 /**
  * Deserialize data SubGhzProtocolDecoderRAW.
  * @param context Pointer to a SubGhzProtocolDecoderRAW instance
@@ -122,6 +141,14 @@ void subghz_protocol_raw_file_encoder_worker_set_callback_end(
     SubGhzProtocolEncoderRAWCallbackEnd callback_end,
     void* context_end);
 
+/**
+ * Get the number of underruns of the running file transfer.
+ * @param instance Pointer to a SubGhzProtocolEncoderRAW instance
+ * @return uint32_t underrun count, 0 if the transfer is not running
+ */
+uint32_t subghz_protocol_raw_file_encoder_worker_get_underrun_count(
+    SubGhzProtocolEncoderRAW* instance);
+
 /**
  * File generation for RAW work.
  * @param flipper_format Pointer to a FlipperFormat instance
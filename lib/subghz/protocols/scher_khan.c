@@ -55,6 +55,7 @@ const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
     .serialize = subghz_protocol_decoder_scher_khan_serialize,
     .deserialize = subghz_protocol_decoder_scher_khan_deserialize,
     .get_string = subghz_protocol_decoder_scher_khan_get_string,
+    .get_start_window = subghz_protocol_decoder_scher_khan_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_scher_khan_encoder = {
@@ -202,6 +203,19 @@ void subghz_protocol_decoder_scher_khan_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_scher_khan_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderScherKhan* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_scher_khan_const.te_short * 2,
+        subghz_protocol_scher_khan_const.te_delta);
+    return instance->decoder.parser_step == ScherKhanDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
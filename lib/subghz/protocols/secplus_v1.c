@@ -70,6 +70,7 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v1_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v1_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v1_get_string,
+    .get_start_window = subghz_protocol_decoder_secplus_v1_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v1_encoder = {
@@ -510,6 +511,19 @@ void subghz_protocol_decoder_secplus_v1_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_secplus_v1_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSecPlus_v1* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_secplus_v1_const.te_short * 120,
+        subghz_protocol_secplus_v1_const.te_delta * 120);
+    return instance->decoder.parser_step == SecPlus_v1DecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_secplus_v1_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderSecPlus_v1* instance = context;
@@ -64,6 +64,7 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v2_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v2_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v2_get_string,
+    .get_start_window = subghz_protocol_decoder_secplus_v2_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v2_encoder = {
@@ -771,6 +772,19 @@ void subghz_protocol_decoder_secplus_v2_feed(void* context, bool level, uint32_t
     }
 }
 
+bool subghz_protocol_decoder_secplus_v2_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSecPlus_v2* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_secplus_v2_const.te_long * 130,
+        subghz_protocol_secplus_v2_const.te_delta * 100);
+    return instance->decoder.parser_step == SecPlus_v2DecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_secplus_v2_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderSecPlus_v2* instance = context;
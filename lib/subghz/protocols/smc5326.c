@@ -72,6 +72,7 @@ const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
     .serialize = subghz_protocol_decoder_smc5326_serialize,
     .deserialize = subghz_protocol_decoder_smc5326_deserialize,
     .get_string = subghz_protocol_decoder_smc5326_get_string,
+    .get_start_window = subghz_protocol_decoder_smc5326_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder = {
@@ -308,6 +309,19 @@ void subghz_protocol_decoder_smc5326_feed(void* context, bool level, uint32_t du
     }
 }
 
+bool subghz_protocol_decoder_smc5326_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSMC5326* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        false,
+        subghz_protocol_smc5326_const.te_short * 24,
+        subghz_protocol_smc5326_const.te_delta * 12);
+    return instance->decoder.parser_step == SMC5326DecoderStepReset;
+}
+
 uint8_t subghz_protocol_decoder_smc5326_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderSMC5326* instance = context;
@@ -53,6 +53,7 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
     .serialize = subghz_protocol_decoder_somfy_keytis_serialize,
     .deserialize = subghz_protocol_decoder_somfy_keytis_deserialize,
     .get_string = subghz_protocol_decoder_somfy_keytis_get_string,
+    .get_start_window = subghz_protocol_decoder_somfy_keytis_get_start_window,
 };
 
 const SubGhzProtocol subghz_protocol_somfy_keytis = {
@@ -588,6 +589,19 @@ void subghz_protocol_decoder_somfy_keytis_feed(void* context, bool level, uint32
     }
 }
 
+bool subghz_protocol_decoder_somfy_keytis_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSomfyKeytis* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_somfy_keytis_const.te_short * 4,
+        subghz_protocol_somfy_keytis_const.te_delta * 4);
+    return instance->decoder.parser_step == SomfyKeytisDecoderStepReset;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
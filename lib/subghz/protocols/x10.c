@@ -75,6 +75,7 @@ const SubGhzProtocolDecoder subghz_protocol_x10_decoder = {
     .serialize = subghz_protocol_decoder_x10_serialize,
     .deserialize = subghz_protocol_decoder_x10_deserialize,
     .get_string = subghz_protocol_decoder_x10_get_string,
+    .get_start_window = subghz_protocol_decoder_x10_get_start_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_x10_encoder = {
@@ -201,6 +202,19 @@ void subghz_protocol_decoder_x10_feed(void* context, bool level, uint32_t durati
     }
 }
 
+bool subghz_protocol_decoder_x10_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window) {
+    furi_assert(context);
+    SubGhzProtocolDecoderX10* instance = context;
+    subghz_protocol_blocks_set_start_window(
+        window,
+        true,
+        subghz_protocol_x10_const.te_short * 16,
+        subghz_protocol_x10_const.te_delta * 7);
+    return instance->decoder.parser_step == X10DecoderStepReset;
+}
+
 /** 
  * Set the serial and btn values based on the data and data_count_bit.
  * @param instance Pointer to a SubGhzBlockGeneric* instance
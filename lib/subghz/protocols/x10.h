@@ -38,6 +38,16 @@ void subghz_protocol_decoder_x10_reset(void* context);
  */
 void subghz_protocol_decoder_x10_feed(void* context, bool level, uint32_t duration);
 
+/**
+ * Get the window of pulses that can start a new packet.
+ * @param context Pointer to a SubGhzProtocolDecoderX10 instance
+ * @param window Pointer to a SubGhzProtocolStartWindow instance
+ * @return true if decoder waits for the start of a packet
+ */
+bool subghz_protocol_decoder_x10_get_start_window(
+    void* context,
+    SubGhzProtocolStartWindow* window);
+
 /**
  * Validates if the current data is valid.
  * 
@@ -5,8 +5,25 @@
 
 #include <m-array.h>
 
+/*
+ * Timing index
+ *
+ * Every pulse is looked up in a table of duration buckets, one table per level.
+ * Bucket holds a bitmask of decoders whose start window overlaps it.
+ * Decoders that are in the middle of a packet are tracked in the busy mask and see
+ * every pulse, decoders without start window are always busy.
+ *
+ * Buckets are log-linear: 4 buckets per octave, so the bucket of a duration
+ * is monotonic and a window always maps to a contiguous bucket range.
+ */
+#define SUBGHZ_RECEIVER_BUCKET_OCTAVE_MAX (17U)
+#define SUBGHZ_RECEIVER_BUCKET_COUNT ((SUBGHZ_RECEIVER_BUCKET_OCTAVE_MAX + 1) * 4)
+#define SUBGHZ_RECEIVER_MASK_BITS (32U)
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    SubGhzProtocolStartWindow window;
+    uint32_t feed_count;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -16,10 +33,90 @@ struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
 
+    size_t mask_words;
+    uint32_t* index;
+    uint32_t* active;
+    uint32_t* busy;
+    uint32_t* ungated;
+    uint32_t* batched;
+    uint32_t pulse_count;
+
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static inline size_t subghz_receiver_get_bucket(uint32_t duration) {
+    if(duration < 4) return duration;
+
+    size_t octave = 31 - __builtin_clz(duration);
+    if(octave > SUBGHZ_RECEIVER_BUCKET_OCTAVE_MAX) return SUBGHZ_RECEIVER_BUCKET_COUNT - 1;
+
+    return octave * 4 + ((duration >> (octave - 2)) & 0x3);
+}
+
+static inline uint32_t*
+    subghz_receiver_get_index(SubGhzReceiver* instance, bool level, size_t bucket) {
+    return &instance->index
+                [((level ? 1 : 0) * SUBGHZ_RECEIVER_BUCKET_COUNT + bucket) * instance->mask_words];
+}
+
+static void subghz_receiver_update_state(SubGhzReceiver* instance, size_t slot_index) {
+    SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, slot_index);
+    const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+    size_t word = slot_index / SUBGHZ_RECEIVER_MASK_BITS;
+    uint32_t bit = 1UL << (slot_index % SUBGHZ_RECEIVER_MASK_BITS);
+
+    if(decoder->get_start_window && decoder->get_start_window(slot->base, &slot->window)) {
+        instance->busy[word] &= ~bit;
+    } else {
+        instance->busy[word] |= bit;
+    }
+}
+
+static void subghz_receiver_build_index(SubGhzReceiver* instance) {
+    size_t slot_count = SubGhzReceiverSlotArray_size(instance->slots);
+    instance->mask_words =
+        (slot_count + SUBGHZ_RECEIVER_MASK_BITS - 1) / SUBGHZ_RECEIVER_MASK_BITS;
+    if(!instance->mask_words) instance->mask_words = 1;
+
+    instance->index =
+        malloc(sizeof(uint32_t) * instance->mask_words * SUBGHZ_RECEIVER_BUCKET_COUNT * 2);
+    instance->active = malloc(sizeof(uint32_t) * instance->mask_words);
+    instance->busy = malloc(sizeof(uint32_t) * instance->mask_words);
+    instance->ungated = malloc(sizeof(uint32_t) * instance->mask_words);
+    instance->batched = malloc(sizeof(uint32_t) * instance->mask_words);
+    memset(
+        instance->index,
+        0,
+        sizeof(uint32_t) * instance->mask_words * SUBGHZ_RECEIVER_BUCKET_COUNT * 2);
+    memset(instance->active, 0, sizeof(uint32_t) * instance->mask_words);
+    memset(instance->busy, 0, sizeof(uint32_t) * instance->mask_words);
+    memset(instance->ungated, 0, sizeof(uint32_t) * instance->mask_words);
+    memset(instance->batched, 0, sizeof(uint32_t) * instance->mask_words);
+
+    for(size_t i = 0; i < slot_count; i++) {
+        SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, i);
+        size_t word = i / SUBGHZ_RECEIVER_MASK_BITS;
+        uint32_t bit = 1UL << (i % SUBGHZ_RECEIVER_MASK_BITS);
+
+        subghz_receiver_update_state(instance, i);
+        if(!slot->base->protocol->decoder->get_start_window) {
+            instance->ungated[word] |= bit;
+            // Decoder sees every pulse anyway, let it take the whole span in batch mode
+            if(slot->base->protocol->decoder->feed_batch) instance->batched[word] |= bit;
+            continue;
+        }
+
+        // Start window is a protocol constant, only idle state changes over time
+        if(slot->window.duration_min > slot->window.duration_max) continue;
+        size_t bucket_first = subghz_receiver_get_bucket(slot->window.duration_min);
+        size_t bucket_last = subghz_receiver_get_bucket(slot->window.duration_max);
+        for(size_t bucket = bucket_first; bucket <= bucket_last; bucket++) {
+            subghz_receiver_get_index(instance, slot->window.level, bucket)[word] |= bit;
+        }
+    }
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -33,9 +130,13 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->feed_count = 0;
         }
     }
 
+    subghz_receiver_build_index(instance);
+    instance->pulse_count = 0;
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -55,19 +156,97 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
 
+    free(instance->index);
+    free(instance->active);
+    free(instance->busy);
+    free(instance->ungated);
+    free(instance->batched);
+
     free(instance);
 }
 
+static inline void subghz_receiver_feed_slot(
+    SubGhzReceiver* instance,
+    size_t slot_index,
+    bool level,
+    uint32_t duration) {
+    SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, slot_index);
+    const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+    size_t word = slot_index / SUBGHZ_RECEIVER_MASK_BITS;
+    uint32_t bit = 1UL << (slot_index % SUBGHZ_RECEIVER_MASK_BITS);
+
+    if(!(instance->busy[word] & bit)) {
+        // Idle decoder: bucket is coarse, check the exact start window
+        if((slot->window.level != level) || (duration < slot->window.duration_min) ||
+           (duration > slot->window.duration_max)) {
+            return;
+        }
+    }
+
+    decoder->feed(slot->base, level, duration);
+    slot->feed_count++;
+
+    if(!(instance->ungated[word] & bit)) {
+        subghz_receiver_update_state(instance, slot_index);
+    }
+}
+
+static inline void subghz_receiver_dispatch(
+    SubGhzReceiver* instance,
+    bool level,
+    uint32_t duration,
+    const uint32_t* exclude) {
+    const uint32_t* candidates =
+        subghz_receiver_get_index(instance, level, subghz_receiver_get_bucket(duration));
+
+    for(size_t word = 0; word < instance->mask_words; word++) {
+        uint32_t mask = (instance->busy[word] | candidates[word]) & instance->active[word];
+        if(exclude) mask &= ~exclude[word];
+        while(mask) {
+            size_t bit = __builtin_ctz(mask);
+            mask &= mask - 1;
+            subghz_receiver_feed_slot(
+                instance, word * SUBGHZ_RECEIVER_MASK_BITS + bit, level, duration);
+        }
+    }
+}
+
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
     furi_assert(instance);
     furi_assert(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
+    instance->pulse_count++;
+    subghz_receiver_dispatch(instance, level, duration, NULL);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(instance->slots);
+    furi_assert(pulses);
+
+    instance->pulse_count += count;
+    for(size_t i = 0; i < count; i++) {
+        subghz_receiver_dispatch(
+            instance,
+            level_duration_get_level(pulses[i]),
+            level_duration_get_duration(pulses[i]),
+            instance->batched);
+    }
+
+    for(size_t word = 0; word < instance->mask_words; word++) {
+        uint32_t mask = instance->batched[word] & instance->active[word];
+        while(mask) {
+            size_t bit = __builtin_ctz(mask);
+            mask &= mask - 1;
+            SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(
+                instance->slots, word * SUBGHZ_RECEIVER_MASK_BITS + bit);
+            slot->base->protocol->decoder->feed_batch(slot->base, pulses, count);
+            slot->feed_count += count;
         }
+    }
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -78,6 +257,10 @@ void subghz_receiver_reset(SubGhzReceiver* instance) {
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             slot->base->protocol->decoder->reset(slot->base);
         }
+
+    for(size_t i = 0; i < SubGhzReceiverSlotArray_size(instance->slots); i++) {
+        subghz_receiver_update_state(instance, i);
+    }
 }
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
@@ -106,6 +289,15 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_assert(instance);
     instance->filter = filter;
+
+    memset(instance->active, 0, sizeof(uint32_t) * instance->mask_words);
+    for(size_t i = 0; i < SubGhzReceiverSlotArray_size(instance->slots); i++) {
+        SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(instance->slots, i);
+        if((slot->base->protocol->flag & filter) != 0) {
+            instance->active[i / SUBGHZ_RECEIVER_MASK_BITS] |=
+                1UL << (i % SUBGHZ_RECEIVER_MASK_BITS);
+        }
+    }
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -122,3 +314,32 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
         }
     return result;
 }
+
+uint32_t subghz_receiver_get_pulse_count(SubGhzReceiver* instance) {
+    furi_assert(instance);
+    return instance->pulse_count;
+}
+
+uint32_t subghz_receiver_get_feed_count(SubGhzReceiver* instance, const char* decoder_name) {
+    furi_assert(instance);
+    uint32_t result = 0;
+
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
+                result = slot->feed_count;
+                break;
+            }
+        }
+    return result;
+}
+
+void subghz_receiver_reset_feed_count(SubGhzReceiver* instance) {
+    furi_assert(instance);
+
+    instance->pulse_count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            slot->feed_count = 0;
+        }
+}
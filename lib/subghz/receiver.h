@@ -35,6 +35,20 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a span of levels and durations received from the air.
+ * Decoders implementing feed_batch and listening to every pulse get the whole span
+ * at once, the rest are fed pulse by pulse.
+ * Relative order of decoders within a span is not preserved.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param pulses Array of LevelDuration
+ * @param count Number of elements in pulses
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* pulses,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -68,6 +82,28 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
 SubGhzProtocolDecoderBase*
     subghz_receiver_search_decoder_base_by_name(SubGhzReceiver* instance, const char* decoder_name);
 
+/**
+ * Get the number of pulses passed to subghz_receiver_decode since the last statistics reset.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return Pulse count
+ */
+uint32_t subghz_receiver_get_pulse_count(SubGhzReceiver* instance);
+
+/**
+ * Get the number of pulses actually delivered to a decoder since the last statistics reset.
+ * Decoders waiting for a packet only get pulses that match their start window.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param decoder_name Receiver name
+ * @return Feed count, 0 if decoder is not found
+ */
+uint32_t subghz_receiver_get_feed_count(SubGhzReceiver* instance, const char* decoder_name);
+
+/**
+ * Reset pulse and feed statistics.
+ * @param instance Pointer to a SubGhzReceiver instance
+ */
+void subghz_receiver_reset_feed_count(SubGhzReceiver* instance);
+
 #ifdef __cplusplus
 }
 #endif
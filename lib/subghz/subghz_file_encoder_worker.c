@@ -4,22 +4,65 @@
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
+#include "subghz_raw_packed.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+// Pulses in each half of the double buffer
+#define SUBGHZ_FILE_ENCODER_BUFFER_SIZE 1024
+// Bytes of text read from the file at once
+#define SUBGHZ_FILE_ENCODER_READ_SIZE 256
+#define SUBGHZ_FILE_ENCODER_DURATION_MAX 1000000
+#define SUBGHZ_FILE_ENCODER_DURATION_OVERFLOW 100
+
+#define SUBGHZ_FILE_ENCODER_KEY "RAW_Data:"
+
+typedef enum {
+    SubGhzFileEncoderWorkerEventBufferFree = (1 << 0),
+    SubGhzFileEncoderWorkerEventStop = (1 << 1),
+} SubGhzFileEncoderWorkerEvent;
+
+typedef struct {
+    LevelDuration data[SUBGHZ_FILE_ENCODER_BUFFER_SIZE];
+    size_t count;
+    // Set by the worker thread when the buffer is filled, cleared by the consumer when drained
+    volatile bool ready;
+} SubGhzFileEncoderWorkerBuffer;
+
+typedef struct {
+    bool is_value;
+    // Matched characters of the key while is_value is false
+    size_t key_index;
+    uint32_t value;
+    bool has_digits;
+    bool is_negative;
+    // Rest of the token is not a number
+    bool skip;
+} SubGhzFileEncoderWorkerParser;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    SubGhzFileEncoderWorkerBuffer* buffer;
+
+    // Producer side, worker thread only
+    size_t write_buffer;
+    size_t write_index;
+    SubGhzFileEncoderWorkerParser parser;
+
+    // Consumer side, TX interrupt
+    size_t read_buffer;
+    size_t read_index;
+    bool is_started;
+    volatile uint32_t underrun_count;
 
     Storage* storage;
     FlipperFormat* flipper_format;
 
     volatile bool worker_running;
     volatile bool worker_stopping;
+    volatile size_t file_offset;
+    size_t file_size;
     bool level;
-    bool is_storage_slow;
     FuriString* str_data;
     FuriString* file_path;
     const SubGhzDevice* device;
@@ -38,94 +81,185 @@ void subghz_file_encoder_worker_callback_end(
     instance->context_end = context_end;
 }
 
-void subghz_file_encoder_worker_add_level_duration(
+/** Hand the filled buffer over to the consumer and wait until the other one is drained
+ * 
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return false if the worker was stopped while waiting
+ */
+static bool subghz_file_encoder_worker_publish(SubGhzFileEncoderWorker* instance) {
+    if(!instance->write_index) return true;
+
+    SubGhzFileEncoderWorkerBuffer* buffer = &instance->buffer[instance->write_buffer];
+    buffer->count = instance->write_index;
+    // Pulses must be in memory before the consumer sees the flag
+    __DMB();
+    buffer->ready = true;
+
+    instance->write_buffer ^= 1;
+    instance->write_index = 0;
+
+    while(instance->buffer[instance->write_buffer].ready) {
+        if(!instance->worker_running) return false;
+        furi_thread_flags_wait(
+            SubGhzFileEncoderWorkerEventBufferFree | SubGhzFileEncoderWorkerEventStop,
+            FuriFlagWaitAny,
+            FuriWaitForever);
+    }
+
+    return true;
+}
+
+static bool subghz_file_encoder_worker_push(
+    SubGhzFileEncoderWorker* instance,
+    LevelDuration level_duration) {
+    SubGhzFileEncoderWorkerBuffer* buffer = &instance->buffer[instance->write_buffer];
+    buffer->data[instance->write_index++] = level_duration;
+
+    if(instance->write_index < SUBGHZ_FILE_ENCODER_BUFFER_SIZE) return true;
+    return subghz_file_encoder_worker_publish(instance);
+}
+
+// Terminate the data, so that the consumer stops
+static void subghz_file_encoder_worker_finish(SubGhzFileEncoderWorker* instance) {
+    if(subghz_file_encoder_worker_push(instance, level_duration_reset())) {
+        subghz_file_encoder_worker_publish(instance);
+    }
+}
+
+static bool subghz_file_encoder_worker_add_level_duration(
     SubGhzFileEncoderWorker* instance,
     int32_t duration) {
-    bool res = true;
-    if(duration < 0 && !instance->level) {
-        res = false;
-    } else if(duration > 0 && instance->level) {
-        res = false;
+    if(duration > SUBGHZ_FILE_ENCODER_DURATION_MAX) {
+        duration = SUBGHZ_FILE_ENCODER_DURATION_OVERFLOW;
+    } else if(duration < -SUBGHZ_FILE_ENCODER_DURATION_MAX) {
+        duration = -SUBGHZ_FILE_ENCODER_DURATION_OVERFLOW;
     }
 
-    if(res) {
-        instance->level = !instance->level;
-        furi_stream_buffer_send(instance->stream, &duration, sizeof(int32_t), 100);
-    } else {
+    if(duration == 0 || (duration < 0) != instance->level) {
         FURI_LOG_E(TAG, "Invalid level in the stream");
+        return true;
     }
+
+    instance->level = !instance->level;
+    return subghz_file_encoder_worker_push(
+        instance, level_duration_make(duration > 0, (duration > 0) ? duration : -duration));
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    char* str1;
-    int32_t temp_ds = 0;
-    bool res = false;
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for a key in the line
-    str1 = strstr(strStart, "RAW_Data: ");
-
-    if(str1 != NULL) {
-        // Skip key
-        str1 = strchr(str1, ' ');
-
-        // Check that there is still an element in the line
-        while(strchr(str1, ' ') != NULL) {
-            str1 = strchr(str1, ' ');
-
-            // Skip space
-            str1 += 1;
-            //
-            temp_ds = atoi(str1);
-            if((temp_ds < -1000000) || (temp_ds > 1000000)) {
-                if(temp_ds > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
-                }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", atoi(str1));
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, temp_ds);
+static bool subghz_file_encoder_worker_parser_end_value(SubGhzFileEncoderWorker* instance) {
+    SubGhzFileEncoderWorkerParser* parser = &instance->parser;
+    bool res = true;
+
+    if(parser->has_digits) {
+        // Value stops growing past the maximum, so it fits
+        int32_t duration = parser->value;
+        res = subghz_file_encoder_worker_add_level_duration(
+            instance, parser->is_negative ? -duration : duration);
+    }
+
+    parser->value = 0;
+    parser->has_digits = false;
+    parser->is_negative = false;
+    parser->skip = false;
+    return res;
+}
+
+/** Parse a chunk of text
+ * 
+ * Line sample: "RAW_Data: 2, -2, 1, -1...". Values are converted in place, without splitting
+ * the text into lines first, so a chunk may end in the middle of a line or a value.
+ * 
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param data text
+ * @param size text size
+ * @return Number of consumed bytes, less than size if the data is over or the worker was stopped
+ */
+static size_t subghz_file_encoder_worker_parse(
+    SubGhzFileEncoderWorker* instance,
+    const uint8_t* data,
+    size_t size) {
+    SubGhzFileEncoderWorkerParser* parser = &instance->parser;
+    const size_t key_size = strlen(SUBGHZ_FILE_ENCODER_KEY);
+
+    for(size_t i = 0; i < size; i++) {
+        const char c = data[i];
+
+        if(!parser->is_value) {
+            if(c == SUBGHZ_FILE_ENCODER_KEY[parser->key_index]) {
+                parser->key_index++;
+                parser->is_value = (parser->key_index == key_size);
+            } else if(parser->key_index || (c != ' ' && c != '\t' && c != '\r' && c != '\n')) {
+                // Not a data line, nothing to transmit after it
+                return i;
             }
+        } else if(c >= '0' && c <= '9') {
+            if(!parser->skip && parser->value <= SUBGHZ_FILE_ENCODER_DURATION_MAX) {
+                parser->value = parser->value * 10 + (c - '0');
+            }
+            parser->has_digits = true;
+        } else if(c == '-' && !parser->has_digits && !parser->is_negative) {
+            parser->is_negative = true;
+        } else if(c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            if(!subghz_file_encoder_worker_parser_end_value(instance)) return i;
+            if(c == '\n') {
+                parser->is_value = false;
+                parser->key_index = 0;
+            }
+        } else {
+            // Separators and trailing garbage end the number
+            parser->skip = true;
         }
-        res = true;
     }
-    return res;
+
+    return size;
 }
 
 void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
-    UNUSED(output);
-    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
-    size_t total_size = stream_size(stream);
-    size_t current_offset = stream_tell(stream);
-    size_t buffer_avail = furi_stream_buffer_bytes_available(instance->stream);
+    furi_assert(instance);
+    size_t progress = 0;
+    if(instance->file_size) {
+        progress = 100 * instance->file_offset / instance->file_size;
+    }
 
-    furi_string_printf(output, "%03u%%", 100 * (current_offset - buffer_avail) / total_size);
+    furi_string_printf(output, "%03u%%", progress);
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     furi_assert(context);
     SubGhzFileEncoderWorker* instance = context;
-    int32_t duration;
-    int ret = furi_stream_buffer_receive(instance->stream, &duration, sizeof(int32_t), 0);
-    if(ret == sizeof(int32_t)) {
-        LevelDuration level_duration = {.level = LEVEL_DURATION_RESET};
-        if(duration < 0) {
-            level_duration = level_duration_make(false, -duration);
-        } else if(duration > 0) {
-            level_duration = level_duration_make(true, duration);
-        } else if(duration == 0) { //-V547
-            level_duration = level_duration_reset();
-            FURI_LOG_I(TAG, "Stop transmission");
-            instance->worker_stopping = true;
+    SubGhzFileEncoderWorkerBuffer* buffer = &instance->buffer[instance->read_buffer];
+
+    if(!buffer->ready) {
+        if(instance->is_started && !instance->worker_stopping) {
+            instance->underrun_count++;
         }
-        return level_duration;
-    } else {
-        instance->is_storage_slow = true;
         return level_duration_wait();
     }
+
+    LevelDuration level_duration = buffer->data[instance->read_index++];
+    instance->is_started = true;
+
+    if(instance->read_index >= buffer->count) {
+        instance->read_index = 0;
+        instance->read_buffer ^= 1;
+        __DMB();
+        buffer->ready = false;
+        furi_thread_flags_set(
+            furi_thread_get_id(instance->thread), SubGhzFileEncoderWorkerEventBufferFree);
+    }
+
+    if(level_duration_is_reset(level_duration)) {
+        FURI_LOG_I(TAG, "Stop transmission");
+        instance->worker_stopping = true;
+    }
+
+    return level_duration;
+}
+
+uint32_t subghz_file_encoder_worker_get_underrun_count(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    return instance->underrun_count;
 }
 
 /** Worker thread
@@ -137,8 +271,8 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
-    instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+    SubGhzRawPackedReader* reader = NULL;
     do {
         if(!flipper_format_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
@@ -153,42 +287,60 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
             break;
         }
 
-        //skip the end of the previous line "\n"
-        stream_seek(stream, 1, StreamOffsetFromCurrent);
+        instance->file_size = stream_size(stream);
+        instance->file_offset = stream_tell(stream);
+        size_t block_size;
+        if(subghz_raw_packed_read_marker(stream, &block_size)) {
+            reader = subghz_raw_packed_reader_alloc(stream, block_size);
+        }
         res = true;
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
-    while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
+    if(res && reader) {
+        int32_t duration;
+        while(instance->worker_running) {
+            if(!subghz_raw_packed_reader_read(reader, &duration)) {
+                subghz_file_encoder_worker_finish(instance);
+                break;
+            }
+            if(!subghz_file_encoder_worker_add_level_duration(instance, duration)) break;
+            instance->file_offset = subghz_raw_packed_reader_tell(reader);
+        }
+    } else if(res) {
+        uint8_t data[SUBGHZ_FILE_ENCODER_READ_SIZE];
+        while(instance->worker_running) {
+            size_t data_size = stream_read(stream, data, SUBGHZ_FILE_ENCODER_READ_SIZE);
+            size_t parsed_size = subghz_file_encoder_worker_parse(instance, data, data_size);
+            instance->file_offset += parsed_size;
+
+            if(parsed_size < SUBGHZ_FILE_ENCODER_READ_SIZE) {
+                if(instance->worker_running && parsed_size == data_size) {
+                    // Last line may have no line break
+                    subghz_file_encoder_worker_parser_end_value(instance);
                 }
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                subghz_file_encoder_worker_finish(instance);
                 break;
             }
-        } else {
-            furi_delay_ms(1);
         }
     }
-    //waiting for the end of the transfer
-    if(instance->is_storage_slow) {
-        FURI_LOG_E(TAG, "Storage is slow");
+
+    if(reader) {
+        subghz_raw_packed_reader_free(reader);
     }
 
     FURI_LOG_I(TAG, "End read file");
+    //waiting for the end of the transfer
     while(instance->device && !subghz_devices_is_async_complete_tx(instance->device) &&
           instance->worker_running) {
         furi_delay_ms(5);
     }
 
+    if(instance->underrun_count) {
+        FURI_LOG_E(TAG, "Storage is slow, %lu underruns", instance->underrun_count);
+    }
+
     FURI_LOG_I(TAG, "End transmission");
     while(instance->worker_running) {
         if(instance->worker_stopping) {
@@ -207,7 +359,7 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
 
     instance->thread =
         furi_thread_alloc_ex("SubGhzFEWorker", 2048, subghz_file_encoder_worker_thread, instance);
-    instance->stream = furi_stream_buffer_alloc(sizeof(int32_t) * 2048, sizeof(int32_t));
+    instance->buffer = malloc(sizeof(SubGhzFileEncoderWorkerBuffer) * 2);
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
@@ -223,7 +375,7 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc() {
 void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    free(instance->buffer);
     furi_thread_free(instance->thread);
 
     furi_string_free(instance->str_data);
@@ -242,7 +394,19 @@ bool subghz_file_encoder_worker_start(
     furi_assert(instance);
     furi_assert(!instance->worker_running);
 
-    furi_stream_buffer_reset(instance->stream);
+    instance->buffer[0].ready = false;
+    instance->buffer[1].ready = false;
+    instance->write_buffer = 0;
+    instance->write_index = 0;
+    memset(&instance->parser, 0, sizeof(SubGhzFileEncoderWorkerParser));
+    instance->read_buffer = 0;
+    instance->read_index = 0;
+    instance->is_started = false;
+    instance->underrun_count = 0;
+    instance->file_offset = 0;
+    instance->file_size = 0;
+    instance->level = false;
+
     furi_string_set(instance->file_path, file_path);
     if(radio_device_name) {
         instance->device = subghz_devices_get_by_name(radio_device_name);
@@ -258,6 +422,7 @@ void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance->worker_running);
 
     instance->worker_running = false;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzFileEncoderWorkerEventStop);
     furi_thread_join(instance->thread);
 }
 
@@ -48,8 +48,16 @@ void subghz_file_encoder_worker_get_text_progress(
  */
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context);
 
+/**
+ * Get the number of times the consumer found no parsed data during the transmission.
+ * Non-zero value means that the file was not read fast enough for the pulse rate.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return uint32_t underrun count
+ */
+uint32_t subghz_file_encoder_worker_get_underrun_count(SubGhzFileEncoderWorker* instance);
+
 /** 
- * Start SubGhzFileEncoderWorker.
+ * Start SubGhzFileEncoderWorker. Both text and packed RAW files are played.
  * @param instance Pointer to a SubGhzFileEncoderWorker instance
  * @param file_path File path
  * @param radio_device_name Radio device name
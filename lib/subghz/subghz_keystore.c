@@ -33,6 +33,7 @@ SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeyArray_init(instance->data);
 
     subghz_keystore_reset_kl(instance);
+    subghz_keystore_cache_reset(instance);
 
     return instance;
 }
@@ -57,11 +58,48 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
     free(instance);
 }
 
+SubGhzKeystoreCacheEntry*
+    subghz_keystore_cache_find(SubGhzKeystore* instance, uint32_t serial, uint32_t seed) {
+    furi_assert(instance);
+
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_CACHE_SIZE; i++) {
+        SubGhzKeystoreCacheEntry* entry = &instance->cache[i];
+        if(entry->valid && (entry->serial == serial) && (entry->seed == seed)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void subghz_keystore_cache_put(SubGhzKeystore* instance, const SubGhzKeystoreCacheEntry* entry) {
+    furi_assert(instance);
+    furi_assert(entry);
+
+    SubGhzKeystoreCacheEntry* slot =
+        subghz_keystore_cache_find(instance, entry->serial, entry->seed);
+    if(!slot) {
+        slot = &instance->cache[instance->cache_next];
+        instance->cache_next = (instance->cache_next + 1) % SUBGHZ_KEYSTORE_CACHE_SIZE;
+    }
+    *slot = *entry;
+    slot->valid = true;
+}
+
+void subghz_keystore_cache_reset(SubGhzKeystore* instance) {
+    furi_assert(instance);
+
+    memset(instance->cache, 0, sizeof(instance->cache));
+    instance->cache_next = 0;
+    instance->last_learning = 0;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
     uint64_t key,
     uint16_t type) {
+    // Key indexes in cache are only valid for the array they were taken from
+    subghz_keystore_cache_reset(instance);
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
     manufacture_code->name = furi_string_alloc_set(name);
     manufacture_code->key = key;
@@ -2,8 +2,49 @@
 
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_CACHE_SIZE (8U)
+
+/** Manufacture key that matched a remote, remembered by serial */
+typedef struct {
+    bool valid;
+    uint32_t serial;
+    uint32_t seed;
+    size_t key_index;
+    uint64_t man;
+    uint8_t learning;
+    uint8_t kl_type;
+} SubGhzKeystoreCacheEntry;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
     const char* mfname;
     uint8_t kl_type;
+
+    SubGhzKeystoreCacheEntry cache[SUBGHZ_KEYSTORE_CACHE_SIZE];
+    size_t cache_next;
+    // Learning type of the last match, 0 (KEELOQ_LEARNING_UNKNOWN) until a remote matched
+    uint16_t last_learning;
 };
+
+/**
+ * Find manufacture key that matched the remote before.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Remote serial
+ * @param seed Remote seed
+ * @return SubGhzKeystoreCacheEntry* or NULL if remote is not known
+ */
+SubGhzKeystoreCacheEntry*
+    subghz_keystore_cache_find(SubGhzKeystore* instance, uint32_t serial, uint32_t seed);
+
+/**
+ * Remember manufacture key that matched the remote, oldest entry is replaced.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param entry Entry to store
+ */
+void subghz_keystore_cache_put(SubGhzKeystore* instance, const SubGhzKeystoreCacheEntry* entry);
+
+/**
+ * Forget all remembered remotes.
+ * @param instance Pointer to a SubGhzKeystore instance
+ */
+void subghz_keystore_cache_reset(SubGhzKeystore* instance);
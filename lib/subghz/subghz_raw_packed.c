@@ -0,0 +1,389 @@
+#include "subghz_raw_packed.h"
+
+#include <furi.h>
+#include <toolbox/varint.h>
+#include <toolbox/crc32_calc.h>
+#include <flipper_format/flipper_format_stream.h>
+
+#define TAG "SubGhzRawPacked"
+
+#define SUBGHZ_RAW_PACKED_BLOCK_SIZE_MAX 4096U
+#define SUBGHZ_RAW_PACKED_VARINT_SIZE_MAX 5U
+#define SUBGHZ_RAW_PACKED_DURATION_MAX 0x3FFFFFFFUL
+
+#define SUBGHZ_RAW_TEXT_KEY "RAW_Data"
+// Values per text line, same as written by the RAW decoder
+#define SUBGHZ_RAW_TEXT_LINE_SIZE 512U
+
+typedef struct {
+    // CRC32 of the rest of the header and the data
+    uint32_t crc;
+    uint16_t pulse_count;
+    uint16_t data_size;
+    uint8_t level;
+    uint8_t reserved[3];
+} SubGhzRawPackedBlockHeader;
+
+#define SUBGHZ_RAW_PACKED_HEADER_SIZE sizeof(SubGhzRawPackedBlockHeader)
+#define SUBGHZ_RAW_PACKED_CRC_OFFSET sizeof(uint32_t)
+
+struct SubGhzRawPackedWriter {
+    Stream* stream;
+    uint8_t* block;
+    size_t block_size;
+
+    uint16_t pulse_count;
+    size_t data_size;
+    bool first_level;
+    bool level;
+    // Previous duration of each level
+    uint32_t previous[2];
+};
+
+struct SubGhzRawPackedReader {
+    Stream* stream;
+    uint8_t* block;
+    size_t block_size;
+    size_t start;
+
+    // Index of the next block to load
+    size_t block_index;
+    size_t error_count;
+
+    uint16_t pulse_left;
+    size_t data_size;
+    size_t data_offset;
+    bool level;
+    uint32_t previous[2];
+};
+
+static uint32_t subghz_raw_packed_block_crc(const uint8_t* block, size_t data_size) {
+    return crc32_calc_buffer(
+        0,
+        block + SUBGHZ_RAW_PACKED_CRC_OFFSET,
+        SUBGHZ_RAW_PACKED_HEADER_SIZE - SUBGHZ_RAW_PACKED_CRC_OFFSET + data_size);
+}
+
+static bool subghz_raw_packed_block_size_is_valid(size_t block_size) {
+    return block_size >= SUBGHZ_RAW_PACKED_HEADER_SIZE + SUBGHZ_RAW_PACKED_VARINT_SIZE_MAX &&
+           block_size <= SUBGHZ_RAW_PACKED_BLOCK_SIZE_MAX;
+}
+
+bool subghz_raw_packed_write_marker(Stream* stream, size_t block_size) {
+    furi_assert(stream);
+    furi_assert(subghz_raw_packed_block_size_is_valid(block_size));
+    return stream_write_format(stream, "%s: %zu\n", SUBGHZ_RAW_PACKED_KEY, block_size) > 0;
+}
+
+bool subghz_raw_packed_read_marker(Stream* stream, size_t* block_size) {
+    furi_assert(stream);
+    furi_assert(block_size);
+
+    const size_t position = stream_tell(stream);
+    const size_t key_size = strlen(SUBGHZ_RAW_PACKED_KEY);
+    char buffer[32];
+    const size_t size = stream_read(stream, (uint8_t*)buffer, sizeof(buffer));
+
+    size_t i = 0;
+    size_t value = 0;
+    bool found = false;
+
+    do {
+        // Line break of the previous line
+        while(i < size && (buffer[i] == '\r' || buffer[i] == '\n')) i++;
+
+        if(size - i <= key_size || memcmp(&buffer[i], SUBGHZ_RAW_PACKED_KEY, key_size) != 0) {
+            break;
+        }
+        i += key_size;
+        if(buffer[i++] != ':') break;
+        while(i < size && buffer[i] == ' ') i++;
+
+        const size_t value_start = i;
+        while(i < size && buffer[i] >= '0' && buffer[i] <= '9' &&
+              value <= SUBGHZ_RAW_PACKED_BLOCK_SIZE_MAX) {
+            value = value * 10 + (buffer[i++] - '0');
+        }
+        if(i == value_start || !subghz_raw_packed_block_size_is_valid(value)) break;
+
+        while(i < size && buffer[i] == '\r') i++;
+        if(i == size || buffer[i++] != '\n') break;
+
+        found = true;
+    } while(false);
+
+    if(found) {
+        *block_size = value;
+        return stream_seek(stream, position + i, StreamOffsetFromStart);
+    }
+
+    stream_seek(stream, position, StreamOffsetFromStart);
+    return false;
+}
+
+SubGhzRawPackedWriter* subghz_raw_packed_writer_alloc(Stream* stream, size_t block_size) {
+    furi_assert(stream);
+    furi_assert(subghz_raw_packed_block_size_is_valid(block_size));
+
+    SubGhzRawPackedWriter* instance = malloc(sizeof(SubGhzRawPackedWriter));
+    instance->stream = stream;
+    instance->block = malloc(block_size);
+    instance->block_size = block_size;
+    return instance;
+}
+
+void subghz_raw_packed_writer_free(SubGhzRawPackedWriter* instance) {
+    furi_assert(instance);
+    free(instance->block);
+    free(instance);
+}
+
+bool subghz_raw_packed_writer_flush(SubGhzRawPackedWriter* instance) {
+    furi_assert(instance);
+    if(!instance->pulse_count) return true;
+
+    SubGhzRawPackedBlockHeader header = {
+        .pulse_count = instance->pulse_count,
+        .data_size = instance->data_size,
+        .level = instance->first_level,
+    };
+    memcpy(instance->block, &header, SUBGHZ_RAW_PACKED_HEADER_SIZE);
+    header.crc = subghz_raw_packed_block_crc(instance->block, instance->data_size);
+    memcpy(instance->block, &header.crc, sizeof(header.crc));
+
+    // Blocks have fixed size, so that they can be found without reading the whole file
+    const size_t used_size = SUBGHZ_RAW_PACKED_HEADER_SIZE + instance->data_size;
+    memset(instance->block + used_size, 0, instance->block_size - used_size);
+
+    instance->pulse_count = 0;
+    instance->data_size = 0;
+    instance->previous[0] = 0;
+    instance->previous[1] = 0;
+
+    return stream_write(instance->stream, instance->block, instance->block_size) ==
+           instance->block_size;
+}
+
+bool subghz_raw_packed_writer_add(SubGhzRawPackedWriter* instance, int32_t duration) {
+    furi_assert(instance);
+    if(duration == 0) return true;
+
+    const bool level = duration > 0;
+    uint32_t value = level ? (uint32_t)duration : -(uint32_t)duration;
+    value = MIN(value, SUBGHZ_RAW_PACKED_DURATION_MAX);
+
+    const size_t data_capacity = instance->block_size - SUBGHZ_RAW_PACKED_HEADER_SIZE;
+    if(instance->pulse_count &&
+       (level == instance->level || instance->pulse_count == UINT16_MAX ||
+        instance->data_size + SUBGHZ_RAW_PACKED_VARINT_SIZE_MAX > data_capacity)) {
+        if(!subghz_raw_packed_writer_flush(instance)) return false;
+    }
+
+    if(!instance->pulse_count) {
+        instance->first_level = level;
+    }
+
+    // Pulses of a repeated signal have nearly the same durations, so differences are short
+    const int32_t delta = (int32_t)(value - instance->previous[level]);
+    instance->previous[level] = value;
+    instance->data_size += varint_int32_pack(
+        delta, instance->block + SUBGHZ_RAW_PACKED_HEADER_SIZE + instance->data_size);
+    instance->pulse_count++;
+    instance->level = level;
+
+    return true;
+}
+
+SubGhzRawPackedReader* subghz_raw_packed_reader_alloc(Stream* stream, size_t block_size) {
+    furi_assert(stream);
+    furi_assert(subghz_raw_packed_block_size_is_valid(block_size));
+
+    SubGhzRawPackedReader* instance = malloc(sizeof(SubGhzRawPackedReader));
+    instance->stream = stream;
+    instance->block = malloc(block_size);
+    instance->block_size = block_size;
+    instance->start = stream_tell(stream);
+    return instance;
+}
+
+void subghz_raw_packed_reader_free(SubGhzRawPackedReader* instance) {
+    furi_assert(instance);
+    free(instance->block);
+    free(instance);
+}
+
+static bool subghz_raw_packed_reader_load(SubGhzRawPackedReader* instance) {
+    while(true) {
+        const size_t size = stream_read(instance->stream, instance->block, instance->block_size);
+        if(size < SUBGHZ_RAW_PACKED_HEADER_SIZE) return false;
+        instance->block_index++;
+
+        SubGhzRawPackedBlockHeader header;
+        memcpy(&header, instance->block, SUBGHZ_RAW_PACKED_HEADER_SIZE);
+
+        if(header.data_size <= size - SUBGHZ_RAW_PACKED_HEADER_SIZE &&
+           header.crc == subghz_raw_packed_block_crc(instance->block, header.data_size)) {
+            instance->pulse_left = header.pulse_count;
+            instance->data_size = SUBGHZ_RAW_PACKED_HEADER_SIZE + header.data_size;
+            instance->data_offset = SUBGHZ_RAW_PACKED_HEADER_SIZE;
+            instance->level = header.level;
+            instance->previous[0] = 0;
+            instance->previous[1] = 0;
+            return true;
+        }
+
+        FURI_LOG_W(TAG, "Skipping corrupted block %zu", instance->block_index - 1);
+        instance->error_count++;
+    }
+}
+
+bool subghz_raw_packed_reader_read(SubGhzRawPackedReader* instance, int32_t* duration) {
+    furi_assert(instance);
+    furi_assert(duration);
+
+    while(!instance->pulse_left || instance->data_offset >= instance->data_size) {
+        if(!subghz_raw_packed_reader_load(instance)) return false;
+    }
+
+    int32_t delta;
+    instance->data_offset += varint_int32_unpack(
+        &delta,
+        instance->block + instance->data_offset,
+        instance->data_size - instance->data_offset);
+
+    const bool level = instance->level;
+    const uint32_t value = instance->previous[level] + delta;
+    instance->previous[level] = value;
+    *duration = level ? (int32_t)value : -(int32_t)value;
+
+    instance->level = !level;
+    instance->pulse_left--;
+    return true;
+}
+
+bool subghz_raw_packed_reader_seek_block(SubGhzRawPackedReader* instance, size_t block) {
+    furi_assert(instance);
+    instance->pulse_left = 0;
+    instance->block_index = block;
+    return stream_seek(
+        instance->stream, instance->start + block * instance->block_size, StreamOffsetFromStart);
+}
+
+size_t subghz_raw_packed_reader_tell(SubGhzRawPackedReader* instance) {
+    furi_assert(instance);
+    return instance->start + instance->block_index * instance->block_size;
+}
+
+size_t subghz_raw_packed_reader_get_error_count(SubGhzRawPackedReader* instance) {
+    furi_assert(instance);
+    return instance->error_count;
+}
+
+static bool subghz_raw_packed_line_has_key(FuriString* line, const char* key) {
+    const size_t key_size = strlen(key);
+    return furi_string_start_with_str(line, key) && furi_string_size(line) > key_size &&
+           furi_string_get_char(line, key_size) == ':';
+}
+
+bool subghz_raw_packed_pack(Stream* input, Stream* output) {
+    furi_assert(input);
+    furi_assert(output);
+
+    FuriString* line = furi_string_alloc();
+    SubGhzRawPackedWriter* writer = NULL;
+    bool result = stream_rewind(input);
+
+    while(result && stream_read_line(input, line)) {
+        if(!subghz_raw_packed_line_has_key(line, SUBGHZ_RAW_TEXT_KEY)) {
+            // Nothing is played after the data
+            if(writer) break;
+            result = stream_write_string(output, line) == furi_string_size(line);
+            continue;
+        }
+
+        if(!writer) {
+            result = subghz_raw_packed_write_marker(output, SUBGHZ_RAW_PACKED_BLOCK_SIZE);
+            writer = subghz_raw_packed_writer_alloc(output, SUBGHZ_RAW_PACKED_BLOCK_SIZE);
+        }
+
+        const char* cursor = furi_string_get_cstr(line) + strlen(SUBGHZ_RAW_TEXT_KEY) + 1;
+        while(result && *cursor) {
+            char* end;
+            const long value = strtol(cursor, &end, 10);
+            if(end == cursor) {
+                cursor++;
+            } else {
+                cursor = end;
+                result = subghz_raw_packed_writer_add(writer, value);
+            }
+        }
+    }
+
+    if(writer) {
+        result = result && subghz_raw_packed_writer_flush(writer);
+        subghz_raw_packed_writer_free(writer);
+    } else {
+        FURI_LOG_E(TAG, "No %s found", SUBGHZ_RAW_TEXT_KEY);
+        result = false;
+    }
+
+    furi_string_free(line);
+    return result;
+}
+
+bool subghz_raw_packed_unpack(Stream* input, Stream* output) {
+    furi_assert(input);
+    furi_assert(output);
+
+    FuriString* line = furi_string_alloc();
+    SubGhzRawPackedReader* reader = NULL;
+    bool result = stream_rewind(input);
+
+    while(result) {
+        size_t block_size;
+        if(subghz_raw_packed_read_marker(input, &block_size)) {
+            reader = subghz_raw_packed_reader_alloc(input, block_size);
+            break;
+        }
+        if(!stream_read_line(input, line)) break;
+        result = stream_write_string(output, line) == furi_string_size(line);
+    }
+
+    if(reader) {
+        int32_t* data = malloc(sizeof(int32_t) * SUBGHZ_RAW_TEXT_LINE_SIZE);
+        FlipperStreamWriteData write_data = {
+            .key = SUBGHZ_RAW_TEXT_KEY,
+            .type = FlipperStreamValueInt32,
+            .data = data,
+        };
+
+        bool has_data = true;
+        while(result && has_data) {
+            write_data.data_size = 0;
+            while(write_data.data_size < SUBGHZ_RAW_TEXT_LINE_SIZE) {
+                has_data = subghz_raw_packed_reader_read(reader, &data[write_data.data_size]);
+                if(!has_data) break;
+                write_data.data_size++;
+            }
+            if(write_data.data_size) {
+                result = flipper_format_stream_write_value_line(output, &write_data);
+            }
+        }
+
+        if(subghz_raw_packed_reader_get_error_count(reader)) {
+            FURI_LOG_E(
+                TAG,
+                "%zu corrupted blocks skipped",
+                subghz_raw_packed_reader_get_error_count(reader));
+        }
+
+        free(data);
+        subghz_raw_packed_reader_free(reader);
+    } else {
+        FURI_LOG_E(TAG, "No %s found", SUBGHZ_RAW_PACKED_KEY);
+        result = false;
+    }
+
+    furi_string_free(line);
+    return result;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <toolbox/stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Packed RAW data.
+ *
+ * Packed RAW file has the same header as a text RAW file, but "RAW_Data" lines are replaced with
+ * a "RAW_Packed: <block size>" marker line followed by binary blocks of fixed size. Each block
+ * starts with a header holding a CRC32, pulse count, data size and level of the first pulse.
+ * Levels alternate, so only durations are stored: as zigzag varints of the difference to the
+ * previous duration of the same level. Blocks do not depend on each other and can be seeked to.
+ */
+
+#define SUBGHZ_RAW_PACKED_KEY "RAW_Packed"
+#define SUBGHZ_RAW_PACKED_BLOCK_SIZE 512U
+
+typedef struct SubGhzRawPackedWriter SubGhzRawPackedWriter;
+
+typedef struct SubGhzRawPackedReader SubGhzRawPackedReader;
+
+/**
+ * Write the marker line that separates the text header from packed data.
+ * @param stream Pointer to a Stream instance
+ * @param block_size Block size
+ * @return true On success
+ */
+bool subghz_raw_packed_write_marker(Stream* stream, size_t block_size);
+
+/**
+ * Check if the stream is at the marker line, skipping line breaks before it.
+ * On success the stream is moved to the first block, otherwise it is left at the same position.
+ * @param stream Pointer to a Stream instance
+ * @param block_size Block size read from the marker
+ * @return true If the marker is found
+ */
+bool subghz_raw_packed_read_marker(Stream* stream, size_t* block_size);
+
+/**
+ * Allocate SubGhzRawPackedWriter. Blocks are written at the current position of the stream.
+ * @param stream Pointer to a Stream instance
+ * @param block_size Block size
+ * @return SubGhzRawPackedWriter* pointer to a SubGhzRawPackedWriter instance
+ */
+SubGhzRawPackedWriter* subghz_raw_packed_writer_alloc(Stream* stream, size_t block_size);
+
+/**
+ * Free SubGhzRawPackedWriter. Unflushed pulses are lost.
+ * @param instance Pointer to a SubGhzRawPackedWriter instance
+ */
+void subghz_raw_packed_writer_free(SubGhzRawPackedWriter* instance);
+
+/**
+ * Add a pulse, full block is written to the stream.
+ * Pulse with the same level as the previous one starts a new block.
+ * Zero durations carry no level and are ignored.
+ * @param instance Pointer to a SubGhzRawPackedWriter instance
+ * @param duration Duration, positive for the high level, negative for the low level
+ * @return true On success
+ */
+bool subghz_raw_packed_writer_add(SubGhzRawPackedWriter* instance, int32_t duration);
+
+/**
+ * Write the pending pulses as a block.
+ * @param instance Pointer to a SubGhzRawPackedWriter instance
+ * @return true On success
+ */
+bool subghz_raw_packed_writer_flush(SubGhzRawPackedWriter* instance);
+
+/**
+ * Allocate SubGhzRawPackedReader. First block is at the current position of the stream.
+ * @param stream Pointer to a Stream instance
+ * @param block_size Block size
+ * @return SubGhzRawPackedReader* pointer to a SubGhzRawPackedReader instance
+ */
+SubGhzRawPackedReader* subghz_raw_packed_reader_alloc(Stream* stream, size_t block_size);
+
+/**
+ * Free SubGhzRawPackedReader.
+ * @param instance Pointer to a SubGhzRawPackedReader instance
+ */
+void subghz_raw_packed_reader_free(SubGhzRawPackedReader* instance);
+
+/**
+ * Read the next pulse. Corrupted blocks are skipped.
+ * @param instance Pointer to a SubGhzRawPackedReader instance
+ * @param duration Duration, positive for the high level, negative for the low level
+ * @return false At the end of data
+ */
+bool subghz_raw_packed_reader_read(SubGhzRawPackedReader* instance, int32_t* duration);
+
+/**
+ * Continue reading from the beginning of a block.
+ * @param instance Pointer to a SubGhzRawPackedReader instance
+ * @param block Block index
+ * @return true On success
+ */
+bool subghz_raw_packed_reader_seek_block(SubGhzRawPackedReader* instance, size_t block);
+
+/**
+ * Get the stream position after the last loaded block.
+ * @param instance Pointer to a SubGhzRawPackedReader instance
+ * @return Stream position
+ */
+size_t subghz_raw_packed_reader_tell(SubGhzRawPackedReader* instance);
+
+/**
+ * Get the number of corrupted blocks that were skipped.
+ * @param instance Pointer to a SubGhzRawPackedReader instance
+ * @return Number of skipped blocks
+ */
+size_t subghz_raw_packed_reader_get_error_count(SubGhzRawPackedReader* instance);
+
+/**
+ * Convert a text RAW file to a packed one.
+ * @param input Pointer to a Stream instance with a text RAW file
+ * @param output Pointer to a Stream instance, packed data is written at its current position
+ * @return true On success
+ */
+bool subghz_raw_packed_pack(Stream* input, Stream* output);
+
+/**
+ * Convert a packed RAW file to a text one.
+ * @param input Pointer to a Stream instance with a packed RAW file
+ * @param output Pointer to a Stream instance, text data is written at its current position
+ * @return true On success
+ */
+bool subghz_raw_packed_unpack(Stream* input, Stream* output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,8 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_BATCH_SIZE (64U)
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
@@ -14,8 +16,12 @@ struct SubGhzWorker {
     LevelDuration filter_level_duration;
     uint16_t filter_duration;
 
+    LevelDuration batch_rx[SUBGHZ_WORKER_BATCH_SIZE];
+    LevelDuration batch_pair[SUBGHZ_WORKER_BATCH_SIZE];
+
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairBatchCallback pair_batch_callback;
     void* context;
 };
 
@@ -29,6 +35,11 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     SubGhzWorker* instance = context;
 
     LevelDuration level_duration = level_duration_make(level, duration);
+    // Never put a partial element into the stream, it would shift every pulse after it
+    if(furi_stream_buffer_spaces_available(instance->stream) < sizeof(LevelDuration)) {
+        instance->overrun = true;
+        return;
+    }
     if(instance->overrun) {
         instance->overrun = false;
         level_duration = level_duration_reset();
@@ -38,6 +49,26 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
+/** Deliver filtered pairs to the consumer
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param count number of pairs in batch_pair
+ */
+static void subghz_worker_flush_pairs(SubGhzWorker* instance, size_t count) {
+    if(!count) return;
+
+    if(instance->pair_batch_callback) {
+        instance->pair_batch_callback(instance->context, instance->batch_pair, count);
+    } else if(instance->pair_callback) {
+        for(size_t i = 0; i < count; i++) {
+            instance->pair_callback(
+                instance->context,
+                level_duration_get_level(instance->batch_pair[i]),
+                level_duration_get_duration(instance->batch_pair[i]));
+        }
+    }
+}
+
 /** Worker callback thread
  * 
  * @param context 
@@ -46,12 +77,17 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, instance->batch_rx, sizeof(instance->batch_rx), 10);
+        size_t rx_count = ret / sizeof(LevelDuration);
+        size_t pair_count = 0;
+
+        for(size_t i = 0; i < rx_count; i++) {
+            LevelDuration level_duration = instance->batch_rx[i];
             if(level_duration_is_reset(level_duration)) {
+                subghz_worker_flush_pairs(instance, pair_count);
+                pair_count = 0;
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
@@ -63,17 +99,16 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                    instance->batch_pair[pair_count++] = level_duration_make(
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+        subghz_worker_flush_pairs(instance, pair_count);
     }
 
     return 0;
@@ -115,6 +150,13 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pair_batch_callback(
+    SubGhzWorker* instance,
+    SubGhzWorkerPairBatchCallback callback) {
+    furi_assert(instance);
+    instance->pair_batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_assert(instance);
     instance->context = context;
@@ -73,10 +73,20 @@ typedef SubGhzProtocolStatus (*SubGhzDeserialize)(void* context, FlipperFormat*
 
 // Decoder specific
 typedef void (*SubGhzDecoderFeed)(void* decoder, bool level, uint32_t duration);
+typedef void (*SubGhzDecoderFeedBatch)(void* decoder, const LevelDuration* pulses, size_t count);
 typedef void (*SubGhzDecoderReset)(void* decoder);
 typedef uint8_t (*SubGhzGetHashData)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 
+// Pulse that is able to move an idle decoder out of its reset step
+typedef struct {
+    bool level;
+    uint32_t duration_min;
+    uint32_t duration_max;
+} SubGhzProtocolStartWindow;
+
+typedef bool (*SubGhzDecoderGetStartWindow)(void* decoder, SubGhzProtocolStartWindow* window);
+
 // Encoder specific
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
@@ -92,6 +102,9 @@ typedef struct {
     SubGhzGetString get_string;
     SubGhzSerialize serialize;
     SubGhzDeserialize deserialize;
+
+    SubGhzDecoderGetStartWindow get_start_window;
+    SubGhzDecoderFeedBatch feed_batch;
 } SubGhzProtocolDecoder;
 
 typedef struct {
@@ -1,6 +1,8 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal_flash.h>
+#include <toolbox/crc32_calc.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 
@@ -22,12 +24,35 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+typedef struct CompressIconCacheEntry {
+    struct CompressIconCacheEntry* prev;
+    struct CompressIconCacheEntry* next;
+    // Key, icons outside of the firmware flash can be replaced at the same address
+    const uint8_t* icon_data;
+    uint16_t compressed_size;
+    uint32_t crc;
+    uint16_t size;
+    uint8_t data[];
+} CompressIconCacheEntry;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t decoded_buff[COMPRESS_ICON_DECODED_BUFF_SIZE];
+
+    // Most recently used entry first
+    CompressIconCacheEntry* cache_head;
+    CompressIconCacheEntry* cache_tail;
+    size_t cache_size;
+    size_t cache_budget;
+    uint32_t cache_hits;
+    uint32_t cache_misses;
 };
 
 CompressIcon* compress_icon_alloc() {
+    return compress_icon_alloc_ex(COMPRESS_ICON_CACHE_DEFAULT_SIZE);
+}
+
+CompressIcon* compress_icon_alloc_ex(size_t cache_size) {
     CompressIcon* instance = malloc(sizeof(CompressIcon));
     instance->decoder = heatshrink_decoder_alloc(
         COMPRESS_ICON_ENCODED_BUFF_SIZE,
@@ -35,16 +60,146 @@ CompressIcon* compress_icon_alloc() {
         COMPRESS_LOOKAHEAD_BUFF_SIZE_LOG);
     heatshrink_decoder_reset(instance->decoder);
     memset(instance->decoded_buff, 0, sizeof(instance->decoded_buff));
+    instance->cache_budget = cache_size;
 
     return instance;
 }
 
+static void compress_icon_cache_unlink(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    if(entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        instance->cache_head = entry->next;
+    }
+    if(entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        instance->cache_tail = entry->prev;
+    }
+}
+
+static void compress_icon_cache_push(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = instance->cache_head;
+    if(entry->next) {
+        entry->next->prev = entry;
+    } else {
+        instance->cache_tail = entry;
+    }
+    instance->cache_head = entry;
+}
+
+static void compress_icon_cache_evict(CompressIcon* instance, CompressIconCacheEntry* entry) {
+    compress_icon_cache_unlink(instance, entry);
+    instance->cache_size -= sizeof(CompressIconCacheEntry) + entry->size;
+    free(entry);
+}
+
 void compress_icon_free(CompressIcon* instance) {
     furi_assert(instance);
+    compress_icon_reset_cache(instance);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
 }
 
+void compress_icon_reset_cache(CompressIcon* instance) {
+    furi_assert(instance);
+    while(instance->cache_head) {
+        compress_icon_cache_evict(instance, instance->cache_head);
+    }
+}
+
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    stats->hits = instance->cache_hits;
+    stats->misses = instance->cache_misses;
+    stats->size = instance->cache_size;
+    stats->count = 0;
+    for(CompressIconCacheEntry* entry = instance->cache_head; entry; entry = entry->next) {
+        stats->count++;
+    }
+}
+
+// Content check for icons in RAM (FAP images, animation frames), firmware icons never change
+static uint32_t compress_icon_data_crc(const uint8_t* icon_data, const CompressHeader* header) {
+    const size_t address = (size_t)icon_data;
+    if(address >= furi_hal_flash_get_base() &&
+       address < furi_hal_flash_get_free_page_start_address()) {
+        return 0;
+    }
+    return crc32_calc_buffer(0, icon_data, sizeof(CompressHeader) + header->compressed_buff_size);
+}
+
+static CompressIconCacheEntry* compress_icon_cache_find(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    const CompressHeader* header,
+    uint32_t crc) {
+    for(CompressIconCacheEntry* entry = instance->cache_head; entry; entry = entry->next) {
+        if(entry->icon_data != icon_data) continue;
+        if(entry->compressed_size == header->compressed_buff_size && entry->crc == crc) {
+            return entry;
+        }
+
+        // Same address, different icon
+        compress_icon_cache_evict(instance, entry);
+        break;
+    }
+
+    return NULL;
+}
+
+static void compress_icon_cache_add(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    const CompressHeader* header,
+    uint32_t crc,
+    size_t size) {
+    const size_t entry_size = sizeof(CompressIconCacheEntry) + size;
+    if(entry_size > instance->cache_budget) return;
+
+    while(instance->cache_size + entry_size > instance->cache_budget) {
+        compress_icon_cache_evict(instance, instance->cache_tail);
+    }
+
+    CompressIconCacheEntry* entry = malloc(entry_size);
+    entry->icon_data = icon_data;
+    entry->compressed_size = header->compressed_buff_size;
+    entry->crc = crc;
+    entry->size = size;
+    memcpy(entry->data, instance->decoded_buff, size);
+
+    compress_icon_cache_push(instance, entry);
+    instance->cache_size += entry_size;
+}
+
+static size_t compress_icon_decode_buffer(CompressIcon* instance, const CompressHeader* header) {
+    const uint8_t* icon_data = (const uint8_t*)header;
+    size_t data_processed = 0;
+    size_t decoded_size = 0;
+    heatshrink_decoder_sink(
+        instance->decoder,
+        (uint8_t*)&icon_data[sizeof(CompressHeader)],
+        header->compressed_buff_size,
+        &data_processed);
+    while(1) {
+        HSD_poll_res res = heatshrink_decoder_poll(
+            instance->decoder,
+            &instance->decoded_buff[decoded_size],
+            sizeof(instance->decoded_buff) - decoded_size,
+            &data_processed);
+        furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
+        decoded_size += data_processed;
+        if(res != HSDR_POLL_MORE || decoded_size == sizeof(instance->decoded_buff)) {
+            break;
+        }
+    }
+    heatshrink_decoder_reset(instance->decoder);
+    return decoded_size;
+}
+
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff) {
     furi_assert(instance);
     furi_assert(icon_data);
@@ -52,24 +207,38 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
     CompressHeader* header = (CompressHeader*)icon_data;
     if(header->is_compressed) {
-        size_t data_processed = 0;
-        heatshrink_decoder_sink(
-            instance->decoder,
-            (uint8_t*)&icon_data[sizeof(CompressHeader)],
-            header->compressed_buff_size,
-            &data_processed);
-        while(1) {
-            HSD_poll_res res = heatshrink_decoder_poll(
-                instance->decoder,
-                instance->decoded_buff,
-                sizeof(instance->decoded_buff),
-                &data_processed);
-            furi_assert((res == HSDR_POLL_EMPTY) || (res == HSDR_POLL_MORE));
-            if(res != HSDR_POLL_MORE) {
-                break;
+        const uint32_t crc = compress_icon_data_crc(icon_data, header);
+        CompressIconCacheEntry* entry = compress_icon_cache_find(instance, icon_data, header, crc);
+        if(entry) {
+            instance->cache_hits++;
+            if(entry != instance->cache_head) {
+                compress_icon_cache_unlink(instance, entry);
+                compress_icon_cache_push(instance, entry);
             }
+            *decoded_buff = entry->data;
+            return;
         }
-        heatshrink_decoder_reset(instance->decoder);
+        instance->cache_misses++;
+
+        size_t decoded_size = compress_icon_decode_buffer(instance, header);
+        compress_icon_cache_add(instance, icon_data, header, crc, decoded_size);
+        *decoded_buff = instance->decoded_buff;
+    } else {
+        *decoded_buff = (uint8_t*)&icon_data[1];
+    }
+}
+
+void compress_icon_decode_uncached(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    uint8_t** decoded_buff) {
+    furi_assert(instance);
+    furi_assert(icon_data);
+    furi_assert(decoded_buff);
+
+    CompressHeader* header = (CompressHeader*)icon_data;
+    if(header->is_compressed) {
+        compress_icon_decode_buffer(instance, header);
         *decoded_buff = instance->decoded_buff;
     } else {
         *decoded_buff = (uint8_t*)&icon_data[1];
@@ -12,15 +12,42 @@
 extern "C" {
 #endif
 
+/** Default memory budget of the decoded icon cache */
+#define COMPRESS_ICON_CACHE_DEFAULT_SIZE (2048u)
+
 /** Compress Icon control structure */
 typedef struct CompressIcon CompressIcon;
 
-/** Initialize icon compressor
+/** Decoded icon cache statistics */
+typedef struct {
+    uint32_t hits; /**< Decodes served from the cache */
+    uint32_t misses; /**< Decodes that ran the decoder */
+    size_t size; /**< Memory used by cached icons, bytes */
+    size_t count; /**< Number of cached icons */
+} CompressIconCacheStats;
+
+/** Initialize icon compressor with the default cache budget
  *
  * @return     Compress Icon instance
  */
 CompressIcon* compress_icon_alloc();
 
+/** Initialize icon compressor
+ *
+ * Decoded icons are kept in a least recently used cache, keyed by the icon data pointer and
+ * compressed size. Icons outside of the firmware flash (FAP images, frames loaded from storage)
+ * are also checked by the CRC32 of their compressed data, as another icon may reuse the address.
+ *
+ * The default budget holds a couple of full screen icons. Full screen frames streamed from
+ * storage (dolphin animations) are not meant for the cache: a single animation would evict
+ * every static icon, decode them with compress_icon_decode_uncached instead.
+ *
+ * @param      cache_size  cache memory budget in bytes, 0 disables the cache
+ *
+ * @return     Compress Icon instance
+ */
+CompressIcon* compress_icon_alloc_ex(size_t cache_size);
+
 /** Free icon compressor
  *
  * @param      instance  The Compress Icon instance
@@ -38,6 +65,33 @@ void compress_icon_free(CompressIcon* instance);
  */
 void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint8_t** decoded_buff);
 
+/** Decompress icon without looking it up in or adding it to the cache
+ *
+ * @warning    decoded_buff pointer set by this function is valid till next
+ *             `compress_icon_decode` or `compress_icon_free` call
+ *
+ * @param      instance      The Compress Icon instance
+ * @param      icon_data     pointer to icon data
+ * @param[in]  decoded_buff  pointer to decoded buffer pointer
+ */
+void compress_icon_decode_uncached(
+    CompressIcon* instance,
+    const uint8_t* icon_data,
+    uint8_t** decoded_buff);
+
+/** Drop all cached icons
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_reset_cache(CompressIcon* instance);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      instance  The Compress Icon instance
+ * @param      stats     pointer to a CompressIconCacheStats to fill
+ */
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
 /** Compress control structure */
 typedef struct Compress Compress;
 
@@ -11,6 +11,17 @@ typedef uint8_t* (*ProtocolGetData)(void* protocol);
 
 typedef void (*ProtocolDecoderStart)(void* protocol);
 typedef bool (*ProtocolDecoderFeed)(void* protocol, bool level, uint32_t duration);
+typedef bool (*ProtocolDecoderFeedBits)(void* protocol, bool value, uint32_t count);
+
+typedef void* (*ProtocolDemodAlloc)(void);
+typedef void (*ProtocolDemodFree)(void* demod);
+typedef void (*ProtocolDemodReset)(void* demod);
+typedef void (*ProtocolDemodFeed)(
+    void* demod,
+    bool level,
+    uint32_t duration,
+    bool* value,
+    uint32_t* count);
 
 typedef bool (*ProtocolEncoderStart)(void* protocol);
 typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
@@ -18,6 +29,17 @@ typedef LevelDuration (*ProtocolEncoderYield)(void* protocol);
 typedef void (*ProtocolRenderData)(void* protocol, FuriString* result);
 typedef bool (*ProtocolWriteData)(void* protocol, void* data);
 
+/**
+ * Demodulator shared by protocols with the same modulation.
+ * Feed turns a pulse into count bits of the same value.
+ */
+typedef struct {
+    ProtocolDemodAlloc alloc;
+    ProtocolDemodFree free;
+    ProtocolDemodReset reset;
+    ProtocolDemodFeed feed;
+} ProtocolDemod;
+
 typedef struct {
     ProtocolDecoderStart start;
     ProtocolDecoderFeed feed;
@@ -43,4 +65,11 @@ typedef struct {
     ProtocolRenderData render_data;
     ProtocolRenderData render_brief_data;
     ProtocolWriteData write_data;
+
+    /**
+     * Decoder with a demod gets demodulated bits through feed_bits instead of pulses.
+     * Protocol dict runs every distinct demod once per pulse and fans the bits out.
+     */
+    const ProtocolDemod* demod;
+    ProtocolDecoderFeedBits feed_bits;
 } ProtocolBase;
\ No newline at end of file
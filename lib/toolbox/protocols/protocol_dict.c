@@ -1,10 +1,25 @@
 #include <furi.h>
 #include "protocol_dict.h"
 
+typedef struct {
+    const ProtocolDemod* base;
+    void* data;
+
+    // Bits of the current pulse, valid if fed is set
+    bool fed;
+    bool value;
+    uint32_t count;
+} ProtocolDictDemod;
+
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
     void** data;
+
+    ProtocolDictDemod* demods;
+    size_t demod_count;
+    // Demod index for every protocol with a shared demod
+    size_t* demod_index;
 };
 
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count) {
@@ -12,9 +27,30 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count)
     dict->base = protocols;
     dict->count = count;
     dict->data = malloc(sizeof(void*) * dict->count);
+    dict->demods = malloc(sizeof(ProtocolDictDemod) * dict->count);
+    dict->demod_count = 0;
+    dict->demod_index = malloc(sizeof(size_t) * dict->count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
+
+        const ProtocolDemod* demod = dict->base[i]->demod;
+        if(!demod) continue;
+        furi_assert(dict->base[i]->feed_bits);
+
+        size_t index = 0;
+        while(index < dict->demod_count && dict->demods[index].base != demod) {
+            index++;
+        }
+
+        if(index == dict->demod_count) {
+            dict->demods[index].base = demod;
+            dict->demods[index].data = demod->alloc();
+            dict->demods[index].fed = false;
+            dict->demod_count++;
+        }
+
+        dict->demod_index[i] = index;
     }
 
     return dict;
@@ -25,10 +61,48 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        dict->demods[i].base->free(dict->demods[i].data);
+    }
+
+    free(dict->demod_index);
+    free(dict->demods);
     free(dict->data);
     free(dict);
 }
 
+static bool protocol_dict_decoder_feed(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    bool level,
+    uint32_t duration) {
+    const ProtocolBase* base = dict->base[protocol_index];
+
+    if(base->demod) {
+        ProtocolDictDemod* demod = &dict->demods[dict->demod_index[protocol_index]];
+
+        // Demod runs once per pulse, no matter how many protocols use it
+        if(!demod->fed) {
+            demod->base->feed(demod->data, level, duration, &demod->value, &demod->count);
+            demod->fed = true;
+        }
+
+        if(demod->count) {
+            return base->feed_bits(dict->data[protocol_index], demod->value, demod->count);
+        }
+    } else if(base->decoder.feed) {
+        return base->decoder.feed(dict->data[protocol_index], level, duration);
+    }
+
+    return false;
+}
+
+static void protocol_dict_demods_next_pulse(ProtocolDict* dict) {
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        dict->demods[i].fed = false;
+    }
+}
+
 void protocol_dict_set_data(
     ProtocolDict* dict,
     size_t protocol_index,
@@ -83,6 +157,10 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
 }
 
 void protocol_dict_decoders_start(ProtocolDict* dict) {
+    for(size_t i = 0; i < dict->demod_count; i++) {
+        dict->demods[i].base->reset(dict->demods[i].data);
+    }
+
     for(size_t i = 0; i < dict->count; i++) {
         ProtocolDecoderStart fn = dict->base[i]->decoder.start;
 
@@ -102,18 +180,15 @@ ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t
     ProtocolId ready_protocol_id = PROTOCOL_NO;
 
     for(size_t i = 0; i < dict->count; i++) {
-        ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-        if(fn) {
-            if(fn(dict->data[i], level, duration)) {
-                if(!done) {
-                    ready_protocol_id = i;
-                    done = true;
-                }
+        if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+            if(!done) {
+                ready_protocol_id = i;
+                done = true;
             }
         }
     }
 
+    protocol_dict_demods_next_pulse(dict);
     return ready_protocol_id;
 }
 
@@ -128,19 +203,16 @@ ProtocolId protocol_dict_decoders_feed_by_feature(
     for(size_t i = 0; i < dict->count; i++) {
         uint32_t features = dict->base[i]->features;
         if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
+            if(protocol_dict_decoder_feed(dict, i, level, duration)) {
+                if(!done) {
+                    ready_protocol_id = i;
+                    done = true;
                 }
             }
         }
     }
 
+    protocol_dict_demods_next_pulse(dict);
     return ready_protocol_id;
 }
 
@@ -152,14 +224,12 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     furi_assert(protocol_index < dict->count);
 
     ProtocolId ready_protocol_id = PROTOCOL_NO;
-    ProtocolDecoderFeed fn = dict->base[protocol_index]->decoder.feed;
 
-    if(fn) {
-        if(fn(dict->data[protocol_index], level, duration)) {
-            ready_protocol_id = protocol_index;
-        }
+    if(protocol_dict_decoder_feed(dict, protocol_index, level, duration)) {
+        ready_protocol_id = protocol_index;
     }
 
+    protocol_dict_demods_next_pulse(dict);
     return ready_protocol_id;
 }
 
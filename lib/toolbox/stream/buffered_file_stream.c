@@ -8,9 +8,16 @@ typedef struct {
     Stream stream_base;
     Stream* file_stream;
     StreamCache* cache;
+    BufferedFileStreamConfig config;
     bool sync_pending;
 } BufferedFileStream;
 
+static const BufferedFileStreamConfig buffered_file_stream_default_config = {
+    .block_size = STREAM_CACHE_DEFAULT_BLOCK_SIZE,
+    .block_count = STREAM_CACHE_DEFAULT_BLOCK_COUNT,
+    .read_ahead = false,
+};
+
 static void buffered_file_stream_free(BufferedFileStream* stream);
 static bool buffered_file_stream_eof(BufferedFileStream* stream);
 static void buffered_file_stream_clean(BufferedFileStream* stream);
@@ -28,7 +35,6 @@ static bool buffered_file_stream_delete_and_insert(
     const void* ctx);
 
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
-static bool buffered_file_stream_unread(BufferedFileStream* stream);
 
 const StreamVTable buffered_file_stream_vtable = {
     .free = (StreamFreeFn)buffered_file_stream_free,
@@ -47,6 +53,7 @@ Stream* buffered_file_stream_alloc(Storage* storage) {
 
     stream->file_stream = file_stream_alloc(storage);
     stream->cache = stream_cache_alloc();
+    stream->config = buffered_file_stream_default_config;
     stream->sync_pending = false;
 
     stream->stream_base.vtable = &buffered_file_stream_vtable;
@@ -58,10 +65,37 @@ bool buffered_file_stream_open(
     const char* path,
     FS_AccessMode access_mode,
     FS_OpenMode open_mode) {
+    return buffered_file_stream_open_ex(_stream, path, access_mode, open_mode, NULL);
+}
+
+bool buffered_file_stream_open_ex(
+    Stream* _stream,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode,
+    const BufferedFileStreamConfig* config) {
     furi_assert(_stream);
     BufferedFileStream* stream = (BufferedFileStream*)_stream;
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
-    return file_stream_open(stream->file_stream, path, access_mode, open_mode);
+
+    BufferedFileStreamConfig new_config = config ? *config : buffered_file_stream_default_config;
+    if(!new_config.block_size) new_config.block_size = STREAM_CACHE_DEFAULT_BLOCK_SIZE;
+    if(!new_config.block_count) new_config.block_count = STREAM_CACHE_DEFAULT_BLOCK_COUNT;
+
+    if(new_config.block_size != stream->config.block_size ||
+       new_config.block_count != stream->config.block_count ||
+       new_config.read_ahead != stream->config.read_ahead) {
+        buffered_file_stream_sync(_stream);
+        stream_cache_free(stream->cache);
+        stream->cache = stream_cache_alloc_ex(
+            new_config.block_size, new_config.block_count, new_config.read_ahead);
+        stream->config = new_config;
+    }
+
+    bool success = file_stream_open(stream->file_stream, path, access_mode, open_mode);
+    stream->sync_pending = false;
+    stream_cache_reset(stream->cache, success ? stream_tell(stream->file_stream) : 0);
+    return success;
 }
 
 bool buffered_file_stream_close(Stream* _stream) {
@@ -70,12 +104,11 @@ bool buffered_file_stream_close(Stream* _stream) {
     furi_check(stream->stream_base.vtable == &buffered_file_stream_vtable);
     bool success = false;
     do {
-        if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
-            break;
+        if(stream->sync_pending && !buffered_file_stream_flush(stream)) break;
         if(!file_stream_close(stream->file_stream)) break;
         success = true;
     } while(false);
+    stream_cache_reset(stream->cache, 0);
     return success;
 }
 
@@ -102,24 +135,15 @@ static void buffered_file_stream_free(BufferedFileStream* stream) {
 }
 
 static bool buffered_file_stream_eof(BufferedFileStream* stream) {
-    bool ret;
-    const bool file_stream_eof = stream_eof(stream->file_stream);
-    const bool cache_at_end = stream_cache_at_end(stream->cache);
-    if(!stream->sync_pending) {
-        ret = file_stream_eof && cache_at_end;
-    } else {
-        const size_t remaining_size =
-            stream_size(stream->file_stream) - stream_tell(stream->file_stream);
-        ret = stream_cache_size(stream->cache) >=
-              (remaining_size ? cache_at_end : file_stream_eof);
-    }
-    return ret;
+    // Data left in the current block means no storage access is needed
+    return stream_cache_at_end(stream->cache) &&
+           (stream_cache_tell(stream->cache) >= buffered_file_stream_size(stream));
 }
 
 static void buffered_file_stream_clean(BufferedFileStream* stream) {
     // Not syncing because data will be deleted anyway
     stream->sync_pending = false;
-    stream_cache_drop(stream->cache);
+    stream_cache_reset(stream->cache, 0);
     stream_clean(stream->file_stream);
 }
 
@@ -128,23 +152,28 @@ static bool buffered_file_stream_seek(
     int32_t offset,
     StreamOffset offset_type) {
     bool success = true;
-    int32_t new_offset = offset;
 
     if(offset_type == StreamOffsetFromCurrent) {
-        new_offset -= stream_cache_seek(stream->cache, offset);
-        if(new_offset < 0) {
-            new_offset -= (int32_t)stream_cache_size(stream->cache);
-        }
+        offset += (int32_t)stream_cache_tell(stream->cache);
+        offset_type = StreamOffsetFromStart;
+    }
+
+    // Any cached block will do, not only the current one
+    if(offset_type == StreamOffsetFromStart && offset >= 0 &&
+       stream_cache_seek(stream->cache, offset)) {
+        return true;
     }
 
-    if((new_offset != 0) || (offset_type != StreamOffsetFromCurrent)) {
-        if(stream->sync_pending) {
-            success = buffered_file_stream_sync((Stream*)stream);
+    if(stream->sync_pending) {
+        success = buffered_file_stream_flush(stream);
+    }
+
+    if(success) {
+        success = stream_seek(stream->file_stream, offset, offset_type);
+        if(success && offset_type == StreamOffsetFromStart) {
+            stream_cache_set_position(stream->cache, offset);
         } else {
-            stream_cache_drop(stream->cache);
-        }
-        if(success) {
-            success = stream_seek(stream->file_stream, new_offset, offset_type);
+            stream_cache_set_position(stream->cache, stream_tell(stream->file_stream));
         }
     }
 
@@ -152,21 +181,17 @@ static bool buffered_file_stream_seek(
 }
 
 static size_t buffered_file_stream_tell(BufferedFileStream* stream) {
-    size_t pos = stream_tell(stream->file_stream) + stream_cache_pos(stream->cache);
-    if(!stream->sync_pending) {
-        pos -= stream_cache_size(stream->cache);
-    }
-    return pos;
+    return stream_cache_tell(stream->cache);
 }
 
 static size_t buffered_file_stream_size(BufferedFileStream* stream) {
     size_t size = stream_size(stream->file_stream);
     if(stream->sync_pending) {
-        const size_t remaining_size = size - stream_tell(stream->file_stream);
-        const size_t cache_size = stream_cache_size(stream->cache);
-        if(cache_size > remaining_size) {
-            size += (cache_size - remaining_size);
-        }
+        // Unflushed data may extend the file
+        const size_t cache_end = stream_cache_tell(stream->cache) -
+                                 stream_cache_pos(stream->cache) +
+                                 stream_cache_size(stream->cache);
+        size = MAX(size, cache_end);
     }
     return size;
 }
@@ -176,7 +201,7 @@ static size_t
     size_t need_to_write = size;
     do {
         if(!stream->sync_pending) {
-            if(!buffered_file_stream_unread(stream)) break;
+            if(!stream_cache_unread(stream->cache, stream->file_stream)) break;
         }
         while(need_to_write) {
             stream->sync_pending = true;
@@ -214,40 +239,19 @@ static bool buffered_file_stream_delete_and_insert(
     bool success = false;
     do {
         if(!(stream->sync_pending ? buffered_file_stream_flush(stream) :
-                                    buffered_file_stream_unread(stream)))
+                                    stream_cache_unread(stream->cache, stream->file_stream)))
             break;
         if(!stream_delete_and_insert(stream->file_stream, delete_size, write_callback, ctx)) break;
         success = true;
     } while(false);
+    // Everything after the cursor has moved
+    stream_cache_reset(stream->cache, stream_tell(stream->file_stream));
     return success;
 }
 
 // Write the cache into the underlying stream and adjust seek position
 static bool buffered_file_stream_flush(BufferedFileStream* stream) {
-    bool success = false;
-    do {
-        const int32_t offset = stream_cache_size(stream->cache) - stream_cache_pos(stream->cache);
-        if(!stream_cache_flush(stream->cache, stream->file_stream)) break;
-        if(offset > 0) {
-            if(!stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent)) break;
-        }
-        success = true;
-    } while(false);
+    const bool success = stream_cache_flush(stream->cache, stream->file_stream);
     stream->sync_pending = false;
     return success;
 }
-
-// Drop read cache and adjust the underlying stream seek position
-static bool buffered_file_stream_unread(BufferedFileStream* stream) {
-    bool success = true;
-    const size_t cache_size = stream_cache_size(stream->cache);
-    if(cache_size > 0) {
-        const size_t cache_pos = stream_cache_pos(stream->cache);
-        if(cache_pos < cache_size) {
-            const int32_t offset = cache_size - cache_pos;
-            success = stream_seek(stream->file_stream, -offset, StreamOffsetFromCurrent);
-        }
-        stream_cache_drop(stream->cache);
-    }
-    return success;
-}
@@ -7,6 +7,12 @@
 extern "C" {
 #endif
 
+typedef struct {
+    size_t block_size; /**< Cache block size in bytes, 0 for default */
+    size_t block_count; /**< Number of cached blocks, 0 for default */
+    bool read_ahead; /**< Read the next block together with the current one on sequential reads */
+} BufferedFileStreamConfig;
+
 /**
  * Allocate a file stream with buffered read operations
  * @return Stream*
@@ -27,6 +33,26 @@ bool buffered_file_stream_open(
     FS_AccessMode access_mode,
     FS_OpenMode open_mode);
 
+/**
+ * Opens an existing file or creates a new one, with a custom cache configuration.
+ * The cache is reallocated if the configuration differs from the one used before.
+ * More blocks keep recently read regions around, so backward seeks and rewinds do not
+ * touch the storage. Read-ahead reads two blocks with a single storage request once the
+ * file is read sequentially, and needs at least 4 blocks to work on every miss.
+ * @param stream pointer to file stream object.
+ * @param path path to file
+ * @param access_mode access mode from FS_AccessMode
+ * @param open_mode open mode from FS_OpenMode
+ * @param config cache configuration, NULL for default (single 1 KB block)
+ * @return True on success, False on failure. You need to close the file even if the open operation failed.
+ */
+bool buffered_file_stream_open_ex(
+    Stream* stream,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode,
+    const BufferedFileStreamConfig* config);
+
 /**
  * Closes the file.
  * @param stream pointer to file stream object.
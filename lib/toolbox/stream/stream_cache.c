@@ -1,92 +1,303 @@
 #include "stream_cache.h"
 
-#define STREAM_CACHE_MAX_SIZE 1024U
+typedef struct {
+    uint8_t* data;
+    size_t offset;
+    size_t size;
+    uint32_t last_use;
+} StreamCacheBlock;
 
 struct StreamCache {
-    uint8_t data[STREAM_CACHE_MAX_SIZE];
-    size_t data_size;
-    size_t position;
+    uint8_t* buffer;
+    StreamCacheBlock* blocks;
+    size_t block_size;
+    size_t block_count;
+    bool read_ahead;
+
+    // Block under the cursor, NULL if there is none
+    StreamCacheBlock* current;
+    // Current block holds data that is not written to the stream yet
+    bool dirty;
+    size_t cursor;
+    size_t stream_position;
+    // End of the previous miss, for sequential read detection
+    size_t fill_end;
+    uint32_t use_counter;
 };
 
 StreamCache* stream_cache_alloc() {
+    return stream_cache_alloc_ex(
+        STREAM_CACHE_DEFAULT_BLOCK_SIZE, STREAM_CACHE_DEFAULT_BLOCK_COUNT, false);
+}
+
+StreamCache* stream_cache_alloc_ex(size_t block_size, size_t block_count, bool read_ahead) {
+    furi_assert(block_size);
+    furi_assert(block_count);
     StreamCache* cache = malloc(sizeof(StreamCache));
-    cache->data_size = 0;
-    cache->position = 0;
+    cache->buffer = malloc(block_size * block_count);
+    cache->blocks = malloc(sizeof(StreamCacheBlock) * block_count);
+    cache->block_size = block_size;
+    cache->block_count = block_count;
+    cache->read_ahead = read_ahead;
+
+    for(size_t i = 0; i < block_count; i++) {
+        cache->blocks[i].data = cache->buffer + i * block_size;
+    }
+
+    stream_cache_reset(cache, 0);
     return cache;
 }
+
 void stream_cache_free(StreamCache* cache) {
     furi_assert(cache);
-    cache->data_size = 0;
-    cache->position = 0;
+    free(cache->blocks);
+    free(cache->buffer);
     free(cache);
 }
 
-void stream_cache_drop(StreamCache* cache) {
-    cache->data_size = 0;
-    cache->position = 0;
+void stream_cache_reset(StreamCache* cache, size_t position) {
+    for(size_t i = 0; i < cache->block_count; i++) {
+        cache->blocks[i].offset = 0;
+        cache->blocks[i].size = 0;
+        cache->blocks[i].last_use = 0;
+    }
+    cache->current = NULL;
+    cache->dirty = false;
+    cache->cursor = position;
+    cache->stream_position = position;
+    cache->fill_end = SIZE_MAX;
+    cache->use_counter = 0;
+}
+
+void stream_cache_set_position(StreamCache* cache, size_t position) {
+    furi_assert(!cache->dirty);
+    cache->current = NULL;
+    cache->cursor = position;
+    cache->stream_position = position;
+}
+
+static void stream_cache_use(StreamCache* cache, StreamCacheBlock* block) {
+    cache->current = block;
+    block->last_use = ++cache->use_counter;
+}
+
+// Find a block that holds data at the position
+static StreamCacheBlock* stream_cache_find(StreamCache* cache, size_t position) {
+    for(size_t i = 0; i < cache->block_count; i++) {
+        StreamCacheBlock* block = &cache->blocks[i];
+        if(position >= block->offset && position < block->offset + block->size) {
+            return block;
+        }
+    }
+    return NULL;
+}
+
+// Find least recently used run of adjacent blocks, current block is kept if possible
+static StreamCacheBlock* stream_cache_get_victim(StreamCache* cache, size_t count) {
+    StreamCacheBlock* victim = NULL;
+    uint32_t victim_use = UINT32_MAX;
+
+    for(size_t i = 0; i + count <= cache->block_count; i++) {
+        uint32_t use = 0;
+        for(size_t j = i; j < i + count; j++) {
+            StreamCacheBlock* block = &cache->blocks[j];
+            use = MAX(use, (block == cache->current) ? UINT32_MAX : block->last_use);
+        }
+        if(!victim || use < victim_use) {
+            victim = &cache->blocks[i];
+            victim_use = use;
+        }
+    }
+
+    if(count > 1 && victim_use == UINT32_MAX) {
+        // Cannot prefetch without evicting the current block
+        return NULL;
+    }
+
+    return victim;
 }
 
 bool stream_cache_at_end(StreamCache* cache) {
-    furi_assert(cache->data_size >= cache->position);
-    return cache->data_size == cache->position;
+    return !cache->current || (cache->cursor == cache->current->offset + cache->current->size);
 }
 
 size_t stream_cache_size(StreamCache* cache) {
-    return cache->data_size;
+    return cache->current ? cache->current->size : 0;
 }
 
 size_t stream_cache_pos(StreamCache* cache) {
-    return cache->position;
+    return cache->current ? cache->cursor - cache->current->offset : 0;
+}
+
+size_t stream_cache_tell(StreamCache* cache) {
+    return cache->cursor;
 }
 
 size_t stream_cache_fill(StreamCache* cache, Stream* stream) {
-    const size_t size_read = stream_read(stream, cache->data, STREAM_CACHE_MAX_SIZE);
-    cache->data_size = size_read;
-    cache->position = 0;
-    return size_read;
+    furi_assert(!cache->dirty);
+
+    StreamCacheBlock* block = stream_cache_find(cache, cache->cursor);
+    if(block) {
+        stream_cache_use(cache, block);
+        return block->offset + block->size - cache->cursor;
+    }
+
+    const size_t start = cache->cursor - cache->cursor % cache->block_size;
+
+    size_t count = 1;
+    if(cache->read_ahead && start == cache->fill_end) {
+        count = 2;
+    }
+
+    block = stream_cache_get_victim(cache, count);
+    if(!block) {
+        count = 1;
+        block = stream_cache_get_victim(cache, count);
+    }
+
+    if(cache->stream_position != start) {
+        if(!stream_seek(stream, start, StreamOffsetFromStart)) {
+            // Stream was shortened behind our back
+            stream_cache_reset(cache, stream_tell(stream));
+            return 0;
+        }
+        cache->stream_position = start;
+    }
+
+    // Adjacent blocks share one buffer, so they are filled with a single read
+    const size_t size_read = stream_read(stream, block->data, cache->block_size * count);
+    cache->stream_position += size_read;
+    cache->fill_end = cache->stream_position;
+
+    for(size_t i = 0; i < count; i++) {
+        const size_t block_start = i * cache->block_size;
+        block[i].offset = start + block_start;
+        block[i].size =
+            (size_read > block_start) ? MIN(size_read - block_start, cache->block_size) : 0;
+        block[i].last_use = ++cache->use_counter;
+    }
+
+    stream_cache_use(cache, block);
+    if(block->size <= cache->cursor - start) {
+        cache->current = NULL;
+        return 0;
+    }
+
+    return block->size - (cache->cursor - start);
 }
 
 bool stream_cache_flush(StreamCache* cache, Stream* stream) {
-    const size_t size_written = stream_write(stream, cache->data, cache->data_size);
-    const bool success = (size_written == cache->data_size);
-    cache->data_size = 0;
-    cache->position = 0;
+    if(!cache->dirty) return true;
+
+    StreamCacheBlock* block = cache->current;
+    furi_assert(cache->stream_position == block->offset);
+
+    const size_t size_written = stream_write(stream, block->data, block->size);
+    bool success = (size_written == block->size);
+    cache->stream_position += size_written;
+    cache->dirty = false;
+    cache->current = NULL;
+
+    // Other blocks may hold stale copies of the written data
+    const size_t written_end = block->offset + size_written;
+    for(size_t i = 0; i < cache->block_count; i++) {
+        StreamCacheBlock* other = &cache->blocks[i];
+        if(other != block && other->offset < written_end &&
+           block->offset < other->offset + other->size) {
+            other->size = 0;
+        }
+    }
+
+    if(success) {
+        // Written block still mirrors the stream contents
+        if(cache->cursor < cache->stream_position) {
+            success = stream_seek(stream, cache->cursor, StreamOffsetFromStart);
+            cache->stream_position = cache->cursor;
+        }
+    } else {
+        block->size = 0;
+    }
+
+    if(!success) {
+        stream_cache_reset(cache, stream_tell(stream));
+    }
+
+    return success;
+}
+
+bool stream_cache_unread(StreamCache* cache, Stream* stream) {
+    furi_assert(!cache->dirty);
+    bool success = true;
+    if(cache->stream_position != cache->cursor) {
+        success = stream_seek(stream, cache->cursor, StreamOffsetFromStart);
+        cache->stream_position = cache->cursor;
+    }
+    cache->current = NULL;
+    if(!success) {
+        stream_cache_reset(cache, stream_tell(stream));
+    }
     return success;
 }
 
 size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_read = MIN(size, cache->data_size - cache->position);
+    StreamCacheBlock* block = cache->current;
+    if(!block) return 0;
+
+    furi_assert(block->offset + block->size >= cache->cursor);
+    const size_t position = cache->cursor - block->offset;
+    const size_t size_read = MIN(size, block->size - position);
     if(size_read > 0) {
-        memcpy(data, cache->data + cache->position, size_read);
-        cache->position += size_read;
+        memcpy(data, block->data + position, size_read);
+        cache->cursor += size_read;
     }
     return size_read;
 }
 
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size) {
-    furi_assert(cache->data_size >= cache->position);
-    const size_t size_written = MIN(size, STREAM_CACHE_MAX_SIZE - cache->position);
+    if(!cache->dirty) {
+        furi_assert(cache->stream_position == cache->cursor);
+        StreamCacheBlock* block = stream_cache_get_victim(cache, 1);
+        if(block == cache->current) {
+            // Single block cache, current block is the only choice
+            cache->current = NULL;
+        }
+        block->offset = cache->cursor;
+        block->size = 0;
+        stream_cache_use(cache, block);
+        cache->dirty = true;
+    }
+
+    StreamCacheBlock* block = cache->current;
+    const size_t position = cache->cursor - block->offset;
+    const size_t size_written = MIN(size, cache->block_size - position);
     if(size_written > 0) {
-        memcpy(cache->data + cache->position, data, size_written);
-        cache->position += size_written;
-        if(cache->position > cache->data_size) {
-            cache->data_size = cache->position;
+        memcpy(block->data + position, data, size_written);
+        cache->cursor += size_written;
+        if(position + size_written > block->size) {
+            block->size = position + size_written;
         }
     }
     return size_written;
 }
 
-int32_t stream_cache_seek(StreamCache* cache, int32_t offset) {
-    furi_assert(cache->data_size >= cache->position);
-    int32_t actual_offset = 0;
+bool stream_cache_seek(StreamCache* cache, size_t position) {
+    StreamCacheBlock* current = cache->current;
 
-    if(offset > 0) {
-        actual_offset = MIN(cache->data_size - cache->position, (size_t)offset);
-    } else if(offset < 0) {
-        actual_offset = MAX(-((int32_t)cache->position), offset);
+    if(position == cache->cursor) {
+        return true;
+    } else if(
+        current && position >= current->offset &&
+        position <= current->offset + current->size) {
+        cache->cursor = position;
+        return true;
+    } else if(!cache->dirty) {
+        StreamCacheBlock* block = stream_cache_find(cache, position);
+        if(block) {
+            stream_cache_use(cache, block);
+            cache->cursor = position;
+            return true;
+        }
     }
 
-    cache->position += actual_offset;
-    return actual_offset;
+    return false;
 }
@@ -6,14 +6,28 @@
 extern "C" {
 #endif
 
+#define STREAM_CACHE_DEFAULT_BLOCK_SIZE 1024U
+#define STREAM_CACHE_DEFAULT_BLOCK_COUNT 1U
+
 typedef struct StreamCache StreamCache;
 
 /**
- * Allocate stream cache.
+ * Allocate stream cache with a single block of default size.
  * @return StreamCache* pointer to a StreamCache instance
  */
 StreamCache* stream_cache_alloc();
 
+/**
+ * Allocate stream cache.
+ * Blocks are aligned to the block size and evicted in least recently used order.
+ * With read-ahead enabled, a miss that directly follows the previous one reads two blocks at once.
+ * @param block_size Size of a cache block in bytes
+ * @param block_count Number of cached blocks
+ * @param read_ahead Prefetch the next block on sequential reads
+ * @return StreamCache* pointer to a StreamCache instance
+ */
+StreamCache* stream_cache_alloc_ex(size_t block_size, size_t block_count, bool read_ahead);
+
 /**
  * Free stream cache.
  * @param cache Pointer to a StreamCache instance
@@ -21,48 +35,73 @@ StreamCache* stream_cache_alloc();
 void stream_cache_free(StreamCache* cache);
 
 /**
- * Drop the cache contents and set it to initial state.
+ * Drop all cached data and set both the cursor and the stream position.
+ * @param cache Pointer to a StreamCache instance
+ * @param position Current position of the underlying stream
+ */
+void stream_cache_reset(StreamCache* cache, size_t position);
+
+/**
+ * Move the cursor after the underlying stream was seeked. Cached blocks are kept.
+ * Must not be called with unflushed data.
  * @param cache Pointer to a StreamCache instance
+ * @param position Current position of the underlying stream
  */
-void stream_cache_drop(StreamCache* cache);
+void stream_cache_set_position(StreamCache* cache, size_t position);
 
 /**
- * Determine if the internal cursor is at end the end of cached data.
+ * Determine if the internal cursor is at end the end of the current block.
  * @param cache Pointer to a StreamCache instance
  * @return True if cursor is at end, otherwise false.
  */
 bool stream_cache_at_end(StreamCache* cache);
 
 /**
- * Get the current size of cached data.
+ * Get the size of the current block.
  * @param cache Pointer to a StreamCache instance
  * @return Size of cached data.
  */
 size_t stream_cache_size(StreamCache* cache);
 
 /**
- * Get the internal cursor position.
+ * Get the internal cursor position inside the current block.
  * @param cache Pointer to a StreamCache instance
- * @return Cursor position inside the cache.
+ * @return Cursor position inside the current block.
  */
 size_t stream_cache_pos(StreamCache* cache);
 
 /**
- * Load the cache with new data from a stream.
+ * Get the internal cursor position in the stream.
+ * @param cache Pointer to a StreamCache instance
+ * @return Cursor position.
+ */
+size_t stream_cache_tell(StreamCache* cache);
+
+/**
+ * Make data at the cursor available, reading it from a stream if it is not cached.
  * @param cache Pointer to a StreamCache instance
  * @param stream Pointer to a Stream instance
- * @return Size of newly cached data.
+ * @return Size of data available at the cursor, 0 at the end of the stream.
  */
 size_t stream_cache_fill(StreamCache* cache, Stream* stream);
 
 /**
- * Write as much cached data as possible to a stream.
+ * Write unflushed data to a stream and move the stream to the cursor.
+ * Cached blocks overlapping the written data are dropped.
  * @param cache Pointer to a StreamCache instance
  * @param stream Pointer to a Stream instance
  * @return True on success, False on failure.
  */
 bool stream_cache_flush(StreamCache* cache, Stream* stream);
 
+/**
+ * Move the stream to the cursor, so that it can be modified directly or through the cache.
+ * @param cache Pointer to a StreamCache instance
+ * @param stream Pointer to a Stream instance
+ * @return True on success, False on failure.
+ */
+bool stream_cache_unread(StreamCache* cache, Stream* stream);
+
 /**
  * Read cached data and advance the internal cursor.
  * @param cache Pointer to a StreamCache instance.
@@ -74,6 +113,7 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size);
 
 /**
  * Write to cached data and advance the internal cursor.
+ * The stream must be at the cursor when the first unflushed byte is written.
  * @param cache Pointer to a StreamCache instance.
  * @param data Pointer to a data buffer.
  * @param size Maximum size in bytes to write to the cache.
@@ -82,12 +122,13 @@ size_t stream_cache_read(StreamCache* cache, uint8_t* data, size_t size);
 size_t stream_cache_write(StreamCache* cache, const uint8_t* data, size_t size);
 
 /**
- * Move the internal cursor relatively to its current position.
+ * Move the internal cursor to a cached position.
+ * With unflushed data only the current block is considered.
  * @param cache Pointer to a StreamCache instance.
- * @param offset Cursor offset.
- * @return Actual cursor offset. Equal to offset parameter on hit.
+ * @param position New cursor position.
+ * @return True on hit, False if the position is not cached.
  */
-int32_t stream_cache_seek(StreamCache* cache, int32_t offset);
+bool stream_cache_seek(StreamCache* cache, size_t position);
 
 #ifdef __cplusplus
 }
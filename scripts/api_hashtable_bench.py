@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+import os
+import time
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.relocation import RelocationSection
+from elftools.elf.sections import SymbolTableSection
+from fbt.sdk.cache import SdkCache
+from fbt.sdk.hashes import gnu_sym_hash
+from flipper.app import App
+
+# Keep in sync with lib/flipper_application/api_hashtable/api_hashtable.h
+SYM_HASH_KEY_MULTIPLIER = 0x9E3779B1
+
+
+def sym_hash_key(hash: int) -> int:
+    return (hash * SYM_HASH_KEY_MULTIPLIER) & 0xFFFFFFFF
+
+
+def sym_bucket_bits(count: int) -> int:
+    bits = 1
+    while bits < 15 and (2 << bits) < count:
+        bits += 1
+    return bits
+
+
+def make_bucket_index(keys: list[int], bits: int) -> list[int]:
+    index = []
+    entry = 0
+    for bucket in range((1 << bits) + 1):
+        while entry < len(keys) and (keys[entry] >> (32 - bits)) < bucket:
+            entry += 1
+        index.append(entry)
+    return index
+
+
+def lower_bound(keys: list[int], first: int, last: int, key: int) -> tuple[int, int]:
+    # Mirrors std::lower_bound, returns the position and the number of probes
+    probes = 0
+    count = last - first
+    while count > 0:
+        step = count // 2
+        probes += 1
+        if keys[first + step] < key:
+            first += step + 1
+            count -= step + 1
+        else:
+            count = step
+    return first, probes
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument(
+            "-s",
+            "--sdk",
+            dest="sdk",
+            help="API symbols file",
+            default="firmware/targets/f7/api_symbols.csv",
+        )
+        self.parser.add_argument(
+            "faps",
+            nargs="*",
+            help="FAP files or directories to take relocations from, "
+            "whole API table is resolved if none given",
+        )
+        self.parser.set_defaults(func=self.process)
+
+    def _collect_faps(self) -> list[str]:
+        faps = []
+        for path in self.args.faps:
+            if os.path.isdir(path):
+                for root, _, files in os.walk(path):
+                    faps.extend(
+                        os.path.join(root, name)
+                        for name in files
+                        if name.endswith(".fap")
+                    )
+            else:
+                faps.append(path)
+        return sorted(faps)
+
+    def _undefined_symbols(self, fap_path: str) -> list[str]:
+        # One lookup per relocation, like the loader does without a symbol cache
+        names = []
+        with open(fap_path, "rb") as f:
+            elf_file = ELFFile(f)
+            symtab = elf_file.get_section_by_name(".symtab")
+            if not isinstance(symtab, SymbolTableSection):
+                self.logger.warning(f"{fap_path}: no symbol table")
+                return names
+
+            for section in elf_file.iter_sections():
+                if not isinstance(section, RelocationSection):
+                    continue
+                for relocation in section.iter_relocations():
+                    symbol = symtab.get_symbol(relocation.entry["r_info_sym"])
+                    if symbol["st_shndx"] == "SHN_UNDEF" and symbol.name:
+                        names.append(symbol.name)
+        return names
+
+    def _run(self, title: str, keys: list[int], lookups: list[int], index=None, bits=0):
+        total_probes = 0
+        max_probes = 0
+        misses = 0
+        start = time.perf_counter()
+        for key in lookups:
+            first, last = 0, len(keys)
+            if index:
+                bucket = key >> (32 - bits)
+                first, last = index[bucket], index[bucket + 1]
+            pos, probes = lower_bound(keys, first, last, key)
+            if pos == last or keys[pos] != key:
+                misses += 1
+            total_probes += probes
+            max_probes = max(max_probes, probes)
+        elapsed = time.perf_counter() - start
+
+        self.logger.info(
+            f"{title:<8} avg {total_probes / max(len(lookups), 1):5.2f} probes, "
+            f"max {max_probes:2}, misses {misses}, {elapsed * 1000:.1f} ms"
+        )
+
+    def process(self):
+        sdk = SdkCache(self.args.sdk)
+        names = [entry.name for entry in sdk.get_functions()]
+        names.extend(entry.name for entry in sdk.get_variables())
+        keys = sorted(sym_hash_key(gnu_sym_hash(name)) for name in names)
+        if len(set(keys)) != len(keys):
+            self.logger.error("API table has hash collisions")
+            return 1
+
+        bits = sym_bucket_bits(len(keys))
+        index = make_bucket_index(keys, bits)
+        sizes = [index[b + 1] - index[b] for b in range(len(index) - 1)]
+        self.logger.info(
+            f"API {sdk.version}: {len(keys)} symbols, {len(sizes)} buckets "
+            f"({len(index) * 2} bytes), max {max(sizes)} per bucket, "
+            f"{sizes.count(0)} empty"
+        )
+
+        lookup_names = []
+        faps = self._collect_faps()
+        for fap in faps:
+            lookup_names.extend(self._undefined_symbols(fap))
+        if not faps:
+            lookup_names = names
+        self.logger.info(f"Resolving {len(lookup_names)} symbols from {len(faps)} FAPs")
+
+        lookups = [sym_hash_key(gnu_sym_hash(name)) for name in lookup_names]
+        self._run("table", keys, lookups)
+        self._run("buckets", keys, lookups, index, bits)
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()